@@ -0,0 +1,4433 @@
+#define _CFFI_
+
+/* We try to define Py_LIMITED_API before including Python.h.
+
+   Mess: we can only define it if Py_DEBUG, Py_TRACE_REFS and
+   Py_REF_DEBUG are not defined.  This is a best-effort approximation:
+   we can learn about Py_DEBUG from pyconfig.h, but it is unclear if
+   the same works for the other two macros.  Py_DEBUG implies them,
+   but not the other way around.
+
+   The implementation is messy (issue #350): on Windows, with _MSC_VER,
+   we have to define Py_LIMITED_API even before including pyconfig.h.
+   In that case, we guess what pyconfig.h will do to the macros above,
+   and check our guess after the #include.
+
+   Note that on Windows, with CPython 3.x, you need >= 3.5 and virtualenv
+   version >= 16.0.0.  With older versions of either, you don't get a
+   copy of PYTHON3.DLL in the virtualenv.  We can't check the version of
+   CPython *before* we even include pyconfig.h.  ffi.set_source() puts
+   a ``#define _CFFI_NO_LIMITED_API'' at the start of this file if it is
+   running on Windows < 3.5, as an attempt at fixing it, but that's
+   arguably wrong because it may not be the target version of Python.
+   Still better than nothing I guess.  As another workaround, you can
+   remove the definition of Py_LIMITED_API here.
+
+   See also 'py_limited_api' in cffi/setuptools_ext.py.
+*/
+#if !defined(_CFFI_USE_EMBEDDING) && !defined(Py_LIMITED_API)
+#  ifdef _MSC_VER
+#    if !defined(_DEBUG) && !defined(Py_DEBUG) && !defined(Py_TRACE_REFS) && !defined(Py_REF_DEBUG) && !defined(_CFFI_NO_LIMITED_API)
+#      if !defined(Py_GIL_DISABLED)
+#        define Py_LIMITED_API
+#      else
+#        define Py_LIMITED_API 0x030f0000
+#      endif
+#    endif
+
+#    include <pyconfig.h>
+     /* sanity-check: Py_LIMITED_API will cause crashes if any of these
+        are also defined.  Normally, the Python file PC/pyconfig.h does not
+        cause any of these to be defined, with the exception that _DEBUG
+        causes Py_DEBUG.  Double-check that. */
+#    ifdef Py_LIMITED_API
+#      if defined(Py_DEBUG)
+#        error "pyconfig.h unexpectedly defines Py_DEBUG, but Py_LIMITED_API is set"
+#      endif
+#      if defined(Py_TRACE_REFS)
+#        error "pyconfig.h unexpectedly defines Py_TRACE_REFS, but Py_LIMITED_API is set"
+#      endif
+#      if defined(Py_REF_DEBUG)
+#        error "pyconfig.h unexpectedly defines Py_REF_DEBUG, but Py_LIMITED_API is set"
+#      endif
+#    endif
+#  else
+#    include <pyconfig.h>
+#    if !defined(Py_DEBUG) && !defined(Py_TRACE_REFS) && !defined(Py_REF_DEBUG) && !defined(_CFFI_NO_LIMITED_API)
+#      if !defined(Py_GIL_DISABLED)
+#        define Py_LIMITED_API
+#      else
+#        define Py_LIMITED_API 0x030f0000
+#      endif
+#    endif
+#  endif
+#endif
+
+#include <Python.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* This part is from file 'cffi/parse_c_type.h'.  It is copied at the
+   beginning of C sources generated by CFFI's ffi.set_source(). */
+
+typedef void *_cffi_opcode_t;
+
+#define _CFFI_OP(opcode, arg)   (_cffi_opcode_t)(opcode | (((uintptr_t)(arg)) << 8))
+#define _CFFI_GETOP(cffi_opcode)    ((unsigned char)(uintptr_t)cffi_opcode)
+#define _CFFI_GETARG(cffi_opcode)   (((intptr_t)cffi_opcode) >> 8)
+
+#define _CFFI_OP_PRIMITIVE       1
+#define _CFFI_OP_POINTER         3
+#define _CFFI_OP_ARRAY           5
+#define _CFFI_OP_OPEN_ARRAY      7
+#define _CFFI_OP_STRUCT_UNION    9
+#define _CFFI_OP_ENUM           11
+#define _CFFI_OP_FUNCTION       13
+#define _CFFI_OP_FUNCTION_END   15
+#define _CFFI_OP_NOOP           17
+#define _CFFI_OP_BITFIELD       19
+#define _CFFI_OP_TYPENAME       21
+#define _CFFI_OP_CPYTHON_BLTN_V 23   // varargs
+#define _CFFI_OP_CPYTHON_BLTN_N 25   // noargs
+#define _CFFI_OP_CPYTHON_BLTN_O 27   // O  (i.e. a single arg)
+#define _CFFI_OP_CONSTANT       29
+#define _CFFI_OP_CONSTANT_INT   31
+#define _CFFI_OP_GLOBAL_VAR     33
+#define _CFFI_OP_DLOPEN_FUNC    35
+#define _CFFI_OP_DLOPEN_CONST   37
+#define _CFFI_OP_GLOBAL_VAR_F   39
+#define _CFFI_OP_EXTERN_PYTHON  41
+
+#define _CFFI_PRIM_VOID          0
+#define _CFFI_PRIM_BOOL          1
+#define _CFFI_PRIM_CHAR          2
+#define _CFFI_PRIM_SCHAR         3
+#define _CFFI_PRIM_UCHAR         4
+#define _CFFI_PRIM_SHORT         5
+#define _CFFI_PRIM_USHORT        6
+#define _CFFI_PRIM_INT           7
+#define _CFFI_PRIM_UINT          8
+#define _CFFI_PRIM_LONG          9
+#define _CFFI_PRIM_ULONG        10
+#define _CFFI_PRIM_LONGLONG     11
+#define _CFFI_PRIM_ULONGLONG    12
+#define _CFFI_PRIM_FLOAT        13
+#define _CFFI_PRIM_DOUBLE       14
+#define _CFFI_PRIM_LONGDOUBLE   15
+
+#define _CFFI_PRIM_WCHAR        16
+#define _CFFI_PRIM_INT8         17
+#define _CFFI_PRIM_UINT8        18
+#define _CFFI_PRIM_INT16        19
+#define _CFFI_PRIM_UINT16       20
+#define _CFFI_PRIM_INT32        21
+#define _CFFI_PRIM_UINT32       22
+#define _CFFI_PRIM_INT64        23
+#define _CFFI_PRIM_UINT64       24
+#define _CFFI_PRIM_INTPTR       25
+#define _CFFI_PRIM_UINTPTR      26
+#define _CFFI_PRIM_PTRDIFF      27
+#define _CFFI_PRIM_SIZE         28
+#define _CFFI_PRIM_SSIZE        29
+#define _CFFI_PRIM_INT_LEAST8   30
+#define _CFFI_PRIM_UINT_LEAST8  31
+#define _CFFI_PRIM_INT_LEAST16  32
+#define _CFFI_PRIM_UINT_LEAST16 33
+#define _CFFI_PRIM_INT_LEAST32  34
+#define _CFFI_PRIM_UINT_LEAST32 35
+#define _CFFI_PRIM_INT_LEAST64  36
+#define _CFFI_PRIM_UINT_LEAST64 37
+#define _CFFI_PRIM_INT_FAST8    38
+#define _CFFI_PRIM_UINT_FAST8   39
+#define _CFFI_PRIM_INT_FAST16   40
+#define _CFFI_PRIM_UINT_FAST16  41
+#define _CFFI_PRIM_INT_FAST32   42
+#define _CFFI_PRIM_UINT_FAST32  43
+#define _CFFI_PRIM_INT_FAST64   44
+#define _CFFI_PRIM_UINT_FAST64  45
+#define _CFFI_PRIM_INTMAX       46
+#define _CFFI_PRIM_UINTMAX      47
+#define _CFFI_PRIM_FLOATCOMPLEX 48
+#define _CFFI_PRIM_DOUBLECOMPLEX 49
+#define _CFFI_PRIM_CHAR16       50
+#define _CFFI_PRIM_CHAR32       51
+
+#define _CFFI__NUM_PRIM         52
+#define _CFFI__UNKNOWN_PRIM           (-1)
+#define _CFFI__UNKNOWN_FLOAT_PRIM     (-2)
+#define _CFFI__UNKNOWN_LONG_DOUBLE    (-3)
+
+#define _CFFI__IO_FILE_STRUCT         (-1)
+
+
+struct _cffi_global_s {
+    const char *name;
+    void *address;
+    _cffi_opcode_t type_op;
+    void *size_or_direct_fn;  // OP_GLOBAL_VAR: size, or 0 if unknown
+                              // OP_CPYTHON_BLTN_*: addr of direct function
+};
+
+struct _cffi_getconst_s {
+    unsigned long long value;
+    const struct _cffi_type_context_s *ctx;
+    int gindex;
+};
+
+struct _cffi_struct_union_s {
+    const char *name;
+    int type_index;          // -> _cffi_types, on a OP_STRUCT_UNION
+    int flags;               // _CFFI_F_* flags below
+    size_t size;
+    int alignment;
+    int first_field_index;   // -> _cffi_fields array
+    int num_fields;
+};
+#define _CFFI_F_UNION         0x01   // is a union, not a struct
+#define _CFFI_F_CHECK_FIELDS  0x02   // complain if fields are not in the
+                                     // "standard layout" or if some are missing
+#define _CFFI_F_PACKED        0x04   // for CHECK_FIELDS, assume a packed struct
+#define _CFFI_F_EXTERNAL      0x08   // in some other ffi.include()
+#define _CFFI_F_OPAQUE        0x10   // opaque
+
+struct _cffi_field_s {
+    const char *name;
+    size_t field_offset;
+    size_t field_size;
+    _cffi_opcode_t field_type_op;
+};
+
+struct _cffi_enum_s {
+    const char *name;
+    int type_index;          // -> _cffi_types, on a OP_ENUM
+    int type_prim;           // _CFFI_PRIM_xxx
+    const char *enumerators; // comma-delimited string
+};
+
+struct _cffi_typename_s {
+    const char *name;
+    int type_index;   /* if opaque, points to a possibly artificial
+                         OP_STRUCT which is itself opaque */
+};
+
+struct _cffi_type_context_s {
+    _cffi_opcode_t *types;
+    const struct _cffi_global_s *globals;
+    const struct _cffi_field_s *fields;
+    const struct _cffi_struct_union_s *struct_unions;
+    const struct _cffi_enum_s *enums;
+    const struct _cffi_typename_s *typenames;
+    int num_globals;
+    int num_struct_unions;
+    int num_enums;
+    int num_typenames;
+    const char *const *includes;
+    int num_types;
+    int flags;      /* future extension */
+};
+
+struct _cffi_parse_info_s {
+    const struct _cffi_type_context_s *ctx;
+    _cffi_opcode_t *output;
+    unsigned int output_size;
+    size_t error_location;
+    const char *error_message;
+};
+
+struct _cffi_externpy_s {
+    const char *name;
+    size_t size_of_result;
+    void *reserved1, *reserved2;
+};
+
+#ifdef _CFFI_INTERNAL
+static int parse_c_type(struct _cffi_parse_info_s *info, const char *input);
+static int search_in_globals(const struct _cffi_type_context_s *ctx,
+                             const char *search, size_t search_len);
+static int search_in_struct_unions(const struct _cffi_type_context_s *ctx,
+                                   const char *search, size_t search_len);
+#endif
+
+/* this block of #ifs should be kept exactly identical between
+   c/_cffi_backend.c, cffi/vengine_cpy.py, cffi/vengine_gen.py
+   and cffi/_cffi_include.h */
+#if defined(_MSC_VER)
+# include <malloc.h>   /* for alloca() */
+# if _MSC_VER < 1600   /* MSVC < 2010 */
+   typedef __int8 int8_t;
+   typedef __int16 int16_t;
+   typedef __int32 int32_t;
+   typedef __int64 int64_t;
+   typedef unsigned __int8 uint8_t;
+   typedef unsigned __int16 uint16_t;
+   typedef unsigned __int32 uint32_t;
+   typedef unsigned __int64 uint64_t;
+   typedef __int8 int_least8_t;
+   typedef __int16 int_least16_t;
+   typedef __int32 int_least32_t;
+   typedef __int64 int_least64_t;
+   typedef unsigned __int8 uint_least8_t;
+   typedef unsigned __int16 uint_least16_t;
+   typedef unsigned __int32 uint_least32_t;
+   typedef unsigned __int64 uint_least64_t;
+   typedef __int8 int_fast8_t;
+   typedef __int16 int_fast16_t;
+   typedef __int32 int_fast32_t;
+   typedef __int64 int_fast64_t;
+   typedef unsigned __int8 uint_fast8_t;
+   typedef unsigned __int16 uint_fast16_t;
+   typedef unsigned __int32 uint_fast32_t;
+   typedef unsigned __int64 uint_fast64_t;
+   typedef __int64 intmax_t;
+   typedef unsigned __int64 uintmax_t;
+# else
+#  include <stdint.h>
+# endif
+# if _MSC_VER < 1800   /* MSVC < 2013 */
+#  ifndef __cplusplus
+    typedef unsigned char _Bool;
+#  endif
+# endif
+# define _cffi_float_complex_t   _Fcomplex    /* include <complex.h> for it */
+# define _cffi_double_complex_t  _Dcomplex    /* include <complex.h> for it */
+#else
+# include <stdint.h>
+# if (defined (__SVR4) && defined (__sun)) || defined(_AIX) || defined(__hpux)
+#  include <alloca.h>
+# endif
+# define _cffi_float_complex_t   float _Complex
+# define _cffi_double_complex_t  double _Complex
+#endif
+
+#ifdef __GNUC__
+# define _CFFI_UNUSED_FN  __attribute__((unused))
+#else
+# define _CFFI_UNUSED_FN  /* nothing */
+#endif
+
+#ifdef __cplusplus
+# ifndef _Bool
+   typedef bool _Bool;   /* semi-hackish: C++ has no _Bool; bool is builtin */
+# endif
+#endif
+
+/**********  CPython-specific section  **********/
+#ifndef PYPY_VERSION
+
+
+#define _cffi_from_c_double PyFloat_FromDouble
+#define _cffi_from_c_float PyFloat_FromDouble
+#define _cffi_from_c_long PyLong_FromLong
+#define _cffi_from_c_ulong PyLong_FromUnsignedLong
+#define _cffi_from_c_longlong PyLong_FromLongLong
+#define _cffi_from_c_ulonglong PyLong_FromUnsignedLongLong
+#define _cffi_from_c__Bool PyBool_FromLong
+
+#define _cffi_to_c_double PyFloat_AsDouble
+#define _cffi_to_c_float PyFloat_AsDouble
+
+#define _cffi_from_c_int(x, type)                                        \
+    (((type)-1) > 0 ? /* unsigned */                                     \
+        (sizeof(type) < sizeof(long) ?                                   \
+            PyLong_FromLong((long)x) :                                   \
+         sizeof(type) == sizeof(long) ?                                  \
+            PyLong_FromUnsignedLong((unsigned long)x) :                  \
+            PyLong_FromUnsignedLongLong((unsigned long long)x)) :        \
+        (sizeof(type) <= sizeof(long) ?                                  \
+            PyLong_FromLong((long)x) :                                   \
+            PyLong_FromLongLong((long long)x)))
+
+#define _cffi_to_c_int(o, type)                                          \
+    ((type)(                                                             \
+     sizeof(type) == 1 ? (((type)-1) > 0 ? (type)_cffi_to_c_u8(o)        \
+                                         : (type)_cffi_to_c_i8(o)) :     \
+     sizeof(type) == 2 ? (((type)-1) > 0 ? (type)_cffi_to_c_u16(o)       \
+                                         : (type)_cffi_to_c_i16(o)) :    \
+     sizeof(type) == 4 ? (((type)-1) > 0 ? (type)_cffi_to_c_u32(o)       \
+                                         : (type)_cffi_to_c_i32(o)) :    \
+     sizeof(type) == 8 ? (((type)-1) > 0 ? (type)_cffi_to_c_u64(o)       \
+                                         : (type)_cffi_to_c_i64(o)) :    \
+     (Py_FatalError("unsupported size for type " #type), (type)0)))
+
+#define _cffi_to_c_i8                                                    \
+                 ((int(*)(PyObject *))_cffi_exports[1])
+#define _cffi_to_c_u8                                                    \
+                 ((int(*)(PyObject *))_cffi_exports[2])
+#define _cffi_to_c_i16                                                   \
+                 ((int(*)(PyObject *))_cffi_exports[3])
+#define _cffi_to_c_u16                                                   \
+                 ((int(*)(PyObject *))_cffi_exports[4])
+#define _cffi_to_c_i32                                                   \
+                 ((int(*)(PyObject *))_cffi_exports[5])
+#define _cffi_to_c_u32                                                   \
+                 ((unsigned int(*)(PyObject *))_cffi_exports[6])
+#define _cffi_to_c_i64                                                   \
+                 ((long long(*)(PyObject *))_cffi_exports[7])
+#define _cffi_to_c_u64                                                   \
+                 ((unsigned long long(*)(PyObject *))_cffi_exports[8])
+#define _cffi_to_c_char                                                  \
+                 ((int(*)(PyObject *))_cffi_exports[9])
+#define _cffi_from_c_pointer                                             \
+    ((PyObject *(*)(char *, struct _cffi_ctypedescr *))_cffi_exports[10])
+#define _cffi_to_c_pointer                                               \
+    ((char *(*)(PyObject *, struct _cffi_ctypedescr *))_cffi_exports[11])
+#define _cffi_get_struct_layout                                          \
+    not used any more
+#define _cffi_restore_errno                                              \
+    ((void(*)(void))_cffi_exports[13])
+#define _cffi_save_errno                                                 \
+    ((void(*)(void))_cffi_exports[14])
+#define _cffi_from_c_char                                                \
+    ((PyObject *(*)(char))_cffi_exports[15])
+#define _cffi_from_c_deref                                               \
+    ((PyObject *(*)(char *, struct _cffi_ctypedescr *))_cffi_exports[16])
+#define _cffi_to_c                                                       \
+    ((int(*)(char *, struct _cffi_ctypedescr *, PyObject *))_cffi_exports[17])
+#define _cffi_from_c_struct                                              \
+    ((PyObject *(*)(char *, struct _cffi_ctypedescr *))_cffi_exports[18])
+#define _cffi_to_c_wchar_t                                               \
+    ((_cffi_wchar_t(*)(PyObject *))_cffi_exports[19])
+#define _cffi_from_c_wchar_t                                             \
+    ((PyObject *(*)(_cffi_wchar_t))_cffi_exports[20])
+#define _cffi_to_c_long_double                                           \
+    ((long double(*)(PyObject *))_cffi_exports[21])
+#define _cffi_to_c__Bool                                                 \
+    ((_Bool(*)(PyObject *))_cffi_exports[22])
+#define _cffi_prepare_pointer_call_argument                              \
+    ((Py_ssize_t(*)(struct _cffi_ctypedescr *,                           \
+                    PyObject *, char **))_cffi_exports[23])
+#define _cffi_convert_array_from_object                                  \
+    ((int(*)(char *, struct _cffi_ctypedescr *, PyObject *))_cffi_exports[24])
+#define _CFFI_CPIDX  25
+#define _cffi_call_python                                                \
+    ((void(*)(struct _cffi_externpy_s *, char *))_cffi_exports[_CFFI_CPIDX])
+#define _cffi_to_c_wchar3216_t                                           \
+    ((int(*)(PyObject *))_cffi_exports[26])
+#define _cffi_from_c_wchar3216_t                                         \
+    ((PyObject *(*)(int))_cffi_exports[27])
+#define _CFFI_NUM_EXPORTS 28
+
+struct _cffi_ctypedescr;
+
+static void *_cffi_exports[_CFFI_NUM_EXPORTS];
+
+#define _cffi_type(index)   (                           \
+    assert((((uintptr_t)_cffi_types[index]) & 1) == 0), \
+    (struct _cffi_ctypedescr *)_cffi_types[index])
+
+static PyObject *_cffi_init(const char *module_name, Py_ssize_t version,
+                            const struct _cffi_type_context_s *ctx)
+{
+    PyObject *module, *o_arg, *new_module;
+    void *raw[] = {
+        (void *)module_name,
+        (void *)version,
+        (void *)_cffi_exports,
+        (void *)ctx,
+    };
+
+    module = PyImport_ImportModule("_cffi_backend");
+    if (module == NULL)
+        goto failure;
+
+    o_arg = PyLong_FromVoidPtr((void *)raw);
+    if (o_arg == NULL)
+        goto failure;
+
+    new_module = PyObject_CallMethod(
+        module, (char *)"_init_cffi_1_0_external_module", (char *)"O", o_arg);
+
+    Py_DECREF(o_arg);
+    Py_DECREF(module);
+    return new_module;
+
+  failure:
+    Py_XDECREF(module);
+    return NULL;
+}
+
+
+#ifdef HAVE_WCHAR_H
+typedef wchar_t _cffi_wchar_t;
+#else
+typedef uint16_t _cffi_wchar_t;   /* same random pick as _cffi_backend.c */
+#endif
+
+_CFFI_UNUSED_FN static uint16_t _cffi_to_c_char16_t(PyObject *o)
+{
+    if (sizeof(_cffi_wchar_t) == 2)
+        return (uint16_t)_cffi_to_c_wchar_t(o);
+    else
+        return (uint16_t)_cffi_to_c_wchar3216_t(o);
+}
+
+_CFFI_UNUSED_FN static PyObject *_cffi_from_c_char16_t(uint16_t x)
+{
+    if (sizeof(_cffi_wchar_t) == 2)
+        return _cffi_from_c_wchar_t((_cffi_wchar_t)x);
+    else
+        return _cffi_from_c_wchar3216_t((int)x);
+}
+
+_CFFI_UNUSED_FN static int _cffi_to_c_char32_t(PyObject *o)
+{
+    if (sizeof(_cffi_wchar_t) == 4)
+        return (int)_cffi_to_c_wchar_t(o);
+    else
+        return (int)_cffi_to_c_wchar3216_t(o);
+}
+
+_CFFI_UNUSED_FN static PyObject *_cffi_from_c_char32_t(unsigned int x)
+{
+    if (sizeof(_cffi_wchar_t) == 4)
+        return _cffi_from_c_wchar_t((_cffi_wchar_t)x);
+    else
+        return _cffi_from_c_wchar3216_t((int)x);
+}
+
+union _cffi_union_alignment_u {
+    unsigned char m_char;
+    unsigned short m_short;
+    unsigned int m_int;
+    unsigned long m_long;
+    unsigned long long m_longlong;
+    float m_float;
+    double m_double;
+    long double m_longdouble;
+};
+
+struct _cffi_freeme_s {
+    struct _cffi_freeme_s *next;
+    union _cffi_union_alignment_u alignment;
+};
+
+_CFFI_UNUSED_FN static int
+_cffi_convert_array_argument(struct _cffi_ctypedescr *ctptr, PyObject *arg,
+                             char **output_data, Py_ssize_t datasize,
+                             struct _cffi_freeme_s **freeme)
+{
+    char *p;
+    if (datasize < 0)
+        return -1;
+
+    p = *output_data;
+    if (p == NULL) {
+        struct _cffi_freeme_s *fp = (struct _cffi_freeme_s *)PyObject_Malloc(
+            offsetof(struct _cffi_freeme_s, alignment) + (size_t)datasize);
+        if (fp == NULL)
+            return -1;
+        fp->next = *freeme;
+        *freeme = fp;
+        p = *output_data = (char *)&fp->alignment;
+    }
+    memset((void *)p, 0, (size_t)datasize);
+    return _cffi_convert_array_from_object(p, ctptr, arg);
+}
+
+_CFFI_UNUSED_FN static void
+_cffi_free_array_arguments(struct _cffi_freeme_s *freeme)
+{
+    do {
+        void *p = (void *)freeme;
+        freeme = freeme->next;
+        PyObject_Free(p);
+    } while (freeme != NULL);
+}
+
+/**********  end CPython-specific section  **********/
+#else
+_CFFI_UNUSED_FN
+static void (*_cffi_call_python_org)(struct _cffi_externpy_s *, char *);
+# define _cffi_call_python  _cffi_call_python_org
+#endif
+
+
+#define _cffi_array_len(array)   (sizeof(array) / sizeof((array)[0]))
+
+#define _cffi_prim_int(size, sign)                                      \
+    ((size) == 1 ? ((sign) ? _CFFI_PRIM_INT8  : _CFFI_PRIM_UINT8)  :    \
+     (size) == 2 ? ((sign) ? _CFFI_PRIM_INT16 : _CFFI_PRIM_UINT16) :    \
+     (size) == 4 ? ((sign) ? _CFFI_PRIM_INT32 : _CFFI_PRIM_UINT32) :    \
+     (size) == 8 ? ((sign) ? _CFFI_PRIM_INT64 : _CFFI_PRIM_UINT64) :    \
+     _CFFI__UNKNOWN_PRIM)
+
+#define _cffi_prim_float(size)                                          \
+    ((size) == sizeof(float) ? _CFFI_PRIM_FLOAT :                       \
+     (size) == sizeof(double) ? _CFFI_PRIM_DOUBLE :                     \
+     (size) == sizeof(long double) ? _CFFI__UNKNOWN_LONG_DOUBLE :       \
+     _CFFI__UNKNOWN_FLOAT_PRIM)
+
+#define _cffi_check_int(got, got_nonpos, expected)      \
+    ((got_nonpos) == (expected <= 0) &&                 \
+     (got) == (unsigned long long)expected)
+
+#ifdef MS_WIN32
+# define _cffi_stdcall  __stdcall
+#else
+# define _cffi_stdcall  /* nothing */
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/************************************************************/
+
+
+#include "Ppmd7.h"
+#include "Ppmd8.h"
+#include "Buffer.h"
+#include "ThreadDecoder.h"
+#include "BatchDecoder.h"
+#include "Filter.h"
+#include "PpmdMask.h"
+#include "CpuArch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include "win_pthreads.h"
+#define getc_unlocked fgetc
+#define putc_unlocked fputc
+#else
+#include <pthread.h>
+#endif
+
+void ppmd7_state_init(CPpmd7 *p, unsigned int maxOrder, unsigned int memSize, IAlloc *allocator)
+{
+    Ppmd7_Construct(p);
+    Ppmd7_Alloc(p, memSize, allocator);
+    Ppmd7_Init(p, maxOrder);
+}
+
+void ppmd7_state_close(CPpmd7 *ppmd, IAlloc *allocator)
+{
+    Ppmd7_Free(ppmd, allocator);
+}
+
+void ppmd7_compress_init(CPpmd7z_RangeEnc *rc, BufferWriter *writer)
+{
+    writer->Write = (void (*)(void *, Byte)) Writer;
+    rc->Stream = (IByteOut *) writer;
+    Ppmd7z_RangeEnc_Init(rc);
+}
+
+int ppmd7_decompress_init(CPpmd7z_RangeDec *rc, BufferReader *reader, ppmd_info *info, IAllocPtr allocator)
+{
+    /* Use threaded reader and initialize thread control BEFORE range init,
+       since RangeDec_Init will read from the stream immediately. */
+    reader->Read = (Byte (*)(void *)) Ppmd_thread_Reader;
+    reader->t = info;
+    info->in = reader->inBuffer;
+    Ppmd_thread_decode_init(info, allocator);
+    rc->Stream = (IByteIn *) reader;
+    Bool res = Ppmd7z_RangeDec_Init(rc);
+    return res;
+}
+
+int ppmd7_compress(CPpmd7 *p, CPpmd7z_RangeEnc *rc, OutBuffer *out_buf, InBuffer *in_buf) {
+    Byte* c = (Byte *) in_buf->src + in_buf->pos;
+    const Byte* in_end = (Byte *)in_buf->src + in_buf->size;
+    while (c < in_end) {
+        if (Ppmd7_InRun(p)) {
+            c += Ppmd7_EncodeRun(p, rc, c, in_end - c);
+            if (c == in_end) {
+                break;
+            }
+        }
+        Ppmd7_EncodeSymbol(p, rc, *c++);
+        if (out_buf->pos >= out_buf->size) {
+            break;
+        }
+    }
+    in_buf->pos = c - (Byte *)in_buf->src;
+    return in_buf->size - in_buf->pos;
+}
+
+void ppmd7_compress_flush(CPpmd7 *p, CPpmd7z_RangeEnc *rc, Bool endmark){
+    if (endmark) {
+        Ppmd7_EncodeSymbol(p, rc, -1);
+    }
+    Ppmd7z_RangeEnc_FlushData(rc);
+}
+
+int ppmd7_decompress(CPpmd7 *ppmd, CPpmd7z_RangeDec *rc, OutBuffer *out_buf, InBuffer *in_buf, int length, ppmd_info *info) {
+    info->in = in_buf;
+    info->out = out_buf;
+    return Ppmd7T_decode(ppmd, rc, out_buf, length, info);
+}
+
+void ppmd8_compress_init(CPpmd8 *ppmd, BufferWriter *writer)
+{
+    writer->Write = (void (*)(void *, Byte)) Writer;
+    ppmd->Stream.Out = (IByteOut *) writer;
+}
+
+int ppmd8_compress(CPpmd8 *ppmd, OutBuffer *out_buf, InBuffer *in_buf) {
+    Byte* pos = (Byte *) in_buf->src + in_buf->pos;
+    const Byte* in_end = (Byte *)in_buf->src + in_buf->size;
+    while (pos < in_end) {
+        if (Ppmd8_InRun(ppmd)) {
+            pos += Ppmd8_EncodeRun(ppmd, pos, in_end - pos);
+            if (pos == in_end) {
+                break;
+            }
+        }
+        Byte c = *pos++;
+        Ppmd8_EncodeSymbol(ppmd, c);
+        if (out_buf->pos >= out_buf->size) {
+            break;
+        }
+    }
+    in_buf->pos = pos - (Byte *)in_buf->src;
+    return in_buf->size - in_buf->pos;
+}
+
+void ppmd8_decompress_init(CPpmd8 *ppmd, BufferReader *reader, ppmd_info *info, IAllocPtr allocator)
+{
+    reader->Read = (Byte (*)(void *)) Ppmd_thread_Reader;
+    ppmd->Stream.In = (IByteIn *) reader;
+    reader->t = info;
+    info->in = reader->inBuffer;
+    Ppmd_thread_decode_init(info, allocator);
+}
+
+int ppmd8_decompress(CPpmd8 *ppmd, OutBuffer *out_buf, InBuffer *in_buf, int length, ppmd_info *info) {
+    info->in = in_buf;
+    return Ppmd8T_decode(ppmd, out_buf, length, info);
+}
+
+/* returns 0 once all of in_buf went through the filter and the coder */
+int ppmd8_compress_filtered(CPpmd8 *ppmd, PpmdFilter *f, OutBuffer *out_buf, InBuffer *in_buf) {
+    while (out_buf->pos < out_buf->size) {
+        InBuffer chunk;
+        if (PpmdFilter_Ready(f) == 0) {
+            if (in_buf->pos == in_buf->size) {
+                return 0;
+            }
+            in_buf->pos += PpmdFilter_Encode(f, (const Byte *)in_buf->src + in_buf->pos, in_buf->size - in_buf->pos);
+        }
+        chunk.src = PpmdFilter_Data(f);
+        chunk.size = PpmdFilter_Ready(f);
+        chunk.pos = 0;
+        ppmd8_compress(ppmd, out_buf, &chunk);
+        PpmdFilter_Skip(f, chunk.pos);
+    }
+    return 1;
+}
+
+#define FILTERED_END 1
+#define FILTERED_WAITING 2
+
+/* The coder decodes to stage, which the filter provides; returns the bytes
+   moved to out_buf, -1 when all output is out or -2 on corrupted input.
+   state keeps whether the end mark was met or the coder waits for input. */
+int ppmd8_decompress_filtered(CPpmd8 *ppmd, PpmdFilter *f, OutBuffer *stage, int *state,
+                              OutBuffer *out_buf, InBuffer *in_buf, int length, ppmd_info *info) {
+    int done = 0;
+    int result;
+    info->in = in_buf;
+    info->out = stage;
+    if (*state == FILTERED_WAITING && in_buf->pos < in_buf->size) {
+        *state = 0;
+    }
+    while (done < length && out_buf->pos < out_buf->size) {
+        size_t n = PpmdFilter_Ready(f);
+        size_t room;
+        if (n != 0) {
+            n = n < out_buf->size - out_buf->pos ? n : out_buf->size - out_buf->pos;
+            n = n < (size_t)(length - done) ? n : (size_t)(length - done);
+            memcpy((Byte *)out_buf->dst + out_buf->pos, PpmdFilter_Data(f), n);
+            PpmdFilter_Skip(f, n);
+            out_buf->pos += n;
+            done += (int)n;
+            continue;
+        }
+        if (*state != 0) {
+            break;
+        }
+        stage->dst = PpmdFilter_Space(f, &room);
+        stage->pos = 0;
+        stage->size = PpmdFilter_InBlocks(f) || room < (size_t)(length - done) ? room : (size_t)(length - done);
+        result = Ppmd8T_decode(ppmd, stage, (int)stage->size, info);
+        if (result == -2) {
+            return -2;
+        }
+        PpmdFilter_Decode(f, stage->pos, result == -1);
+        *state = result == -1 ? FILTERED_END : result == 0 ? FILTERED_WAITING : 0;
+    }
+    return done == 0 && *state == FILTERED_END && PpmdFilter_Ready(f) == 0 ? -1 : done;
+}
+
+
+/************************************************************/
+
+static void *_cffi_types[] = {
+/*  0 */ _CFFI_OP(_CFFI_OP_FUNCTION, 103), // char const *()(void)
+/*  1 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/*  2 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd7 *, CPpmd7z_RangeDec *)
+/*  3 */ _CFFI_OP(_CFFI_OP_POINTER, 207), // CPpmd7 *
+/*  4 */ _CFFI_OP(_CFFI_OP_POINTER, 210), // CPpmd7z_RangeDec *
+/*  5 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/*  6 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd7 *, CPpmd7z_RangeDec *, OutBuffer *, InBuffer *, size_t, ppmd_info *)
+/*  7 */ _CFFI_OP(_CFFI_OP_NOOP, 3),
+/*  8 */ _CFFI_OP(_CFFI_OP_NOOP, 4),
+/*  9 */ _CFFI_OP(_CFFI_OP_POINTER, 233), // OutBuffer *
+/* 10 */ _CFFI_OP(_CFFI_OP_POINTER, 232), // InBuffer *
+/* 11 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28), // size_t
+/* 12 */ _CFFI_OP(_CFFI_OP_POINTER, 238), // ppmd_info *
+/* 13 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 14 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd7 *, CPpmd7z_RangeDec *, OutBuffer *, int, ppmd_info *)
+/* 15 */ _CFFI_OP(_CFFI_OP_NOOP, 3),
+/* 16 */ _CFFI_OP(_CFFI_OP_NOOP, 4),
+/* 17 */ _CFFI_OP(_CFFI_OP_NOOP, 9),
+/* 18 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 7), // int
+/* 19 */ _CFFI_OP(_CFFI_OP_NOOP, 12),
+/* 20 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 21 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd7 *, CPpmd7z_RangeEnc *, OutBuffer *, InBuffer *)
+/* 22 */ _CFFI_OP(_CFFI_OP_NOOP, 3),
+/* 23 */ _CFFI_OP(_CFFI_OP_POINTER, 211), // CPpmd7z_RangeEnc *
+/* 24 */ _CFFI_OP(_CFFI_OP_NOOP, 9),
+/* 25 */ _CFFI_OP(_CFFI_OP_NOOP, 10),
+/* 26 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 27 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd7z_RangeDec *, BufferReader *, ppmd_info *, IAlloc *)
+/* 28 */ _CFFI_OP(_CFFI_OP_NOOP, 4),
+/* 29 */ _CFFI_OP(_CFFI_OP_POINTER, 205), // BufferReader *
+/* 30 */ _CFFI_OP(_CFFI_OP_NOOP, 12),
+/* 31 */ _CFFI_OP(_CFFI_OP_POINTER, 227), // IAlloc *
+/* 32 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 33 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd8 *)
+/* 34 */ _CFFI_OP(_CFFI_OP_POINTER, 212), // CPpmd8 *
+/* 35 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 36 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd8 *, OutBuffer *, InBuffer *)
+/* 37 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 38 */ _CFFI_OP(_CFFI_OP_NOOP, 9),
+/* 39 */ _CFFI_OP(_CFFI_OP_NOOP, 10),
+/* 40 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 41 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd8 *, OutBuffer *, InBuffer *, int, ppmd_info *)
+/* 42 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 43 */ _CFFI_OP(_CFFI_OP_NOOP, 9),
+/* 44 */ _CFFI_OP(_CFFI_OP_NOOP, 10),
+/* 45 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 7),
+/* 46 */ _CFFI_OP(_CFFI_OP_NOOP, 12),
+/* 47 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 48 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd8 *, OutBuffer *, int, ppmd_info *)
+/* 49 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 50 */ _CFFI_OP(_CFFI_OP_NOOP, 9),
+/* 51 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 7),
+/* 52 */ _CFFI_OP(_CFFI_OP_NOOP, 12),
+/* 53 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 54 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd8 *, PpmdFilter *, OutBuffer *, InBuffer *)
+/* 55 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 56 */ _CFFI_OP(_CFFI_OP_POINTER, 235), // PpmdFilter *
+/* 57 */ _CFFI_OP(_CFFI_OP_NOOP, 9),
+/* 58 */ _CFFI_OP(_CFFI_OP_NOOP, 10),
+/* 59 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 60 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd8 *, PpmdFilter *, OutBuffer *, int *, OutBuffer *, InBuffer *, int, ppmd_info *)
+/* 61 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 62 */ _CFFI_OP(_CFFI_OP_NOOP, 56),
+/* 63 */ _CFFI_OP(_CFFI_OP_NOOP, 9),
+/* 64 */ _CFFI_OP(_CFFI_OP_POINTER, 18), // int *
+/* 65 */ _CFFI_OP(_CFFI_OP_NOOP, 9),
+/* 66 */ _CFFI_OP(_CFFI_OP_NOOP, 10),
+/* 67 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 7),
+/* 68 */ _CFFI_OP(_CFFI_OP_NOOP, 12),
+/* 69 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 70 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(CPpmd8 *, unsigned int, IAlloc *)
+/* 71 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 72 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 8), // unsigned int
+/* 73 */ _CFFI_OP(_CFFI_OP_NOOP, 31),
+/* 74 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 75 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(Ppmd8BatchStream *, CPpmd8 *, void const *, size_t)
+/* 76 */ _CFFI_OP(_CFFI_OP_POINTER, 234), // Ppmd8BatchStream *
+/* 77 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 78 */ _CFFI_OP(_CFFI_OP_POINTER, 267), // void const *
+/* 79 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28),
+/* 80 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 81 */ _CFFI_OP(_CFFI_OP_FUNCTION, 18), // int()(PpmdFilter *, int, unsigned int, IAlloc *)
+/* 82 */ _CFFI_OP(_CFFI_OP_NOOP, 56),
+/* 83 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 7),
+/* 84 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 8),
+/* 85 */ _CFFI_OP(_CFFI_OP_NOOP, 31),
+/* 86 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 87 */ _CFFI_OP(_CFFI_OP_FUNCTION, 177), // unsigned char()(IByteIn const *)
+/* 88 */ _CFFI_OP(_CFFI_OP_POINTER, 229), // IByteIn const *
+/* 89 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 90 */ _CFFI_OP(_CFFI_OP_FUNCTION, 177), // unsigned char()(void *)
+/* 91 */ _CFFI_OP(_CFFI_OP_POINTER, 267), // void *
+/* 92 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 93 */ _CFFI_OP(_CFFI_OP_FUNCTION, 177), // unsigned char()(void const *)
+/* 94 */ _CFFI_OP(_CFFI_OP_NOOP, 78),
+/* 95 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 96 */ _CFFI_OP(_CFFI_OP_FUNCTION, 72), // unsigned int()(CPpmd7 const *)
+/* 97 */ _CFFI_OP(_CFFI_OP_POINTER, 207), // CPpmd7 const *
+/* 98 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 99 */ _CFFI_OP(_CFFI_OP_FUNCTION, 72), // unsigned int()(CPpmd8 const *)
+/* 100 */ _CFFI_OP(_CFFI_OP_POINTER, 212), // CPpmd8 const *
+/* 101 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 102 */ _CFFI_OP(_CFFI_OP_FUNCTION, 72), // unsigned int()(char const *)
+/* 103 */ _CFFI_OP(_CFFI_OP_POINTER, 236), // char const *
+/* 104 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 105 */ _CFFI_OP(_CFFI_OP_FUNCTION, 72), // unsigned int()(void)
+/* 106 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 107 */ _CFFI_OP(_CFFI_OP_FUNCTION, 91), // void *()(size_t)
+/* 108 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28),
+/* 109 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 110 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd7 *)
+/* 111 */ _CFFI_OP(_CFFI_OP_NOOP, 3),
+/* 112 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 113 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd7 *, CPpmd7z_RangeEnc *, int)
+/* 114 */ _CFFI_OP(_CFFI_OP_NOOP, 3),
+/* 115 */ _CFFI_OP(_CFFI_OP_NOOP, 23),
+/* 116 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 7),
+/* 117 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 118 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd7 *, IAlloc *)
+/* 119 */ _CFFI_OP(_CFFI_OP_NOOP, 3),
+/* 120 */ _CFFI_OP(_CFFI_OP_NOOP, 31),
+/* 121 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 122 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd7 *, ppmd_info *, IAlloc *)
+/* 123 */ _CFFI_OP(_CFFI_OP_NOOP, 3),
+/* 124 */ _CFFI_OP(_CFFI_OP_NOOP, 12),
+/* 125 */ _CFFI_OP(_CFFI_OP_NOOP, 31),
+/* 126 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 127 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd7 *, unsigned int)
+/* 128 */ _CFFI_OP(_CFFI_OP_NOOP, 3),
+/* 129 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 8),
+/* 130 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 131 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd7 *, unsigned int, unsigned int, IAlloc *)
+/* 132 */ _CFFI_OP(_CFFI_OP_NOOP, 3),
+/* 133 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 8),
+/* 134 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 8),
+/* 135 */ _CFFI_OP(_CFFI_OP_NOOP, 31),
+/* 136 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 137 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd7z_RangeEnc *)
+/* 138 */ _CFFI_OP(_CFFI_OP_NOOP, 23),
+/* 139 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 140 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd7z_RangeEnc *, BufferWriter *)
+/* 141 */ _CFFI_OP(_CFFI_OP_NOOP, 23),
+/* 142 */ _CFFI_OP(_CFFI_OP_POINTER, 206), // BufferWriter *
+/* 143 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 144 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd8 *)
+/* 145 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 146 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 147 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd8 *, BufferReader *, ppmd_info *, IAlloc *)
+/* 148 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 149 */ _CFFI_OP(_CFFI_OP_NOOP, 29),
+/* 150 */ _CFFI_OP(_CFFI_OP_NOOP, 12),
+/* 151 */ _CFFI_OP(_CFFI_OP_NOOP, 31),
+/* 152 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 153 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd8 *, BufferWriter *)
+/* 154 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 155 */ _CFFI_OP(_CFFI_OP_NOOP, 142),
+/* 156 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 157 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd8 *, IAlloc *)
+/* 158 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 159 */ _CFFI_OP(_CFFI_OP_NOOP, 31),
+/* 160 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 161 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd8 *, int)
+/* 162 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 163 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 7),
+/* 164 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 165 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd8 *, ppmd_info *, IAlloc *)
+/* 166 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 167 */ _CFFI_OP(_CFFI_OP_NOOP, 12),
+/* 168 */ _CFFI_OP(_CFFI_OP_NOOP, 31),
+/* 169 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 170 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(CPpmd8 *, unsigned int, unsigned int)
+/* 171 */ _CFFI_OP(_CFFI_OP_NOOP, 34),
+/* 172 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 8),
+/* 173 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 8),
+/* 174 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 175 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(IByteOut const *, unsigned char)
+/* 176 */ _CFFI_OP(_CFFI_OP_POINTER, 231), // IByteOut const *
+/* 177 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 4), // unsigned char
+/* 178 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 179 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(Ppmd8BatchStream *, unsigned int)
+/* 180 */ _CFFI_OP(_CFFI_OP_NOOP, 76),
+/* 181 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 8),
+/* 182 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 183 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(PpmdFilter *)
+/* 184 */ _CFFI_OP(_CFFI_OP_NOOP, 56),
+/* 185 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 186 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(PpmdFilter *, IAlloc *)
+/* 187 */ _CFFI_OP(_CFFI_OP_NOOP, 56),
+/* 188 */ _CFFI_OP(_CFFI_OP_NOOP, 31),
+/* 189 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 190 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(unsigned int)
+/* 191 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 8),
+/* 192 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 193 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(void *)
+/* 194 */ _CFFI_OP(_CFFI_OP_NOOP, 91),
+/* 195 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 196 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(void *, unsigned char)
+/* 197 */ _CFFI_OP(_CFFI_OP_NOOP, 91),
+/* 198 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 4),
+/* 199 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 200 */ _CFFI_OP(_CFFI_OP_FUNCTION, 267), // void()(void const *, unsigned char)
+/* 201 */ _CFFI_OP(_CFFI_OP_NOOP, 78),
+/* 202 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 4),
+/* 203 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 204 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 1), // BatchReader
+/* 205 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 2), // BufferReader
+/* 206 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 3), // BufferWriter
+/* 207 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 4), // CPpmd7
+/* 208 */ _CFFI_OP(_CFFI_OP_POINTER, 209), // CPpmd7_Context *
+/* 209 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 13), // CPpmd7_Context
+/* 210 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 5), // CPpmd7z_RangeDec
+/* 211 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 6), // CPpmd7z_RangeEnc
+/* 212 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 7), // CPpmd8
+/* 213 */ _CFFI_OP(_CFFI_OP_POINTER, 214), // CPpmd8_Context *
+/* 214 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 14), // CPpmd8_Context
+/* 215 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 8), // CPpmd_See
+/* 216 */ _CFFI_OP(_CFFI_OP_ARRAY, 215), // CPpmd_See[16]
+/* 217 */ (_cffi_opcode_t)(16),
+/* 218 */ _CFFI_OP(_CFFI_OP_ARRAY, 222), // CPpmd_See[24][32]
+/* 219 */ (_cffi_opcode_t)(24),
+/* 220 */ _CFFI_OP(_CFFI_OP_ARRAY, 216), // CPpmd_See[25][16]
+/* 221 */ (_cffi_opcode_t)(25),
+/* 222 */ _CFFI_OP(_CFFI_OP_ARRAY, 215), // CPpmd_See[32]
+/* 223 */ (_cffi_opcode_t)(32),
+/* 224 */ _CFFI_OP(_CFFI_OP_POINTER, 225), // CPpmd_State *
+/* 225 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 9), // CPpmd_State
+/* 226 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 10), // CPpmd_Stats
+/* 227 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 15), // IAlloc
+/* 228 */ _CFFI_OP(_CFFI_OP_POINTER, 229), // IByteIn *
+/* 229 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 16), // IByteIn
+/* 230 */ _CFFI_OP(_CFFI_OP_POINTER, 231), // IByteOut *
+/* 231 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 17), // IByteOut
+/* 232 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 18), // InBuffer
+/* 233 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 19), // OutBuffer
+/* 234 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 11), // Ppmd8BatchStream
+/* 235 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 12), // PpmdFilter
+/* 236 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 2), // char
+/* 237 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 11), // long long
+/* 238 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 20), // ppmd_info
+/* 239 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 5), // short
+/* 240 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 0), // union $1
+/* 241 */ _CFFI_OP(_CFFI_OP_POINTER, 177), // unsigned char *
+/* 242 */ _CFFI_OP(_CFFI_OP_POINTER, 87), // unsigned char(*)(IByteIn const *)
+/* 243 */ _CFFI_OP(_CFFI_OP_POINTER, 90), // unsigned char(*)(void *)
+/* 244 */ _CFFI_OP(_CFFI_OP_ARRAY, 177), // unsigned char[128]
+/* 245 */ (_cffi_opcode_t)(128),
+/* 246 */ _CFFI_OP(_CFFI_OP_ARRAY, 177), // unsigned char[256]
+/* 247 */ (_cffi_opcode_t)(256),
+/* 248 */ _CFFI_OP(_CFFI_OP_ARRAY, 177), // unsigned char[260]
+/* 249 */ (_cffi_opcode_t)(260),
+/* 250 */ _CFFI_OP(_CFFI_OP_ARRAY, 177), // unsigned char[38]
+/* 251 */ (_cffi_opcode_t)(38),
+/* 252 */ _CFFI_OP(_CFFI_OP_ARRAY, 72), // unsigned int[38]
+/* 253 */ (_cffi_opcode_t)(38),
+/* 254 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 12), // unsigned long long
+/* 255 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 10), // unsigned long
+/* 256 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 6), // unsigned short
+/* 257 */ _CFFI_OP(_CFFI_OP_ARRAY, 261), // unsigned short[128][64]
+/* 258 */ (_cffi_opcode_t)(128),
+/* 259 */ _CFFI_OP(_CFFI_OP_ARRAY, 261), // unsigned short[25][64]
+/* 260 */ (_cffi_opcode_t)(25),
+/* 261 */ _CFFI_OP(_CFFI_OP_ARRAY, 256), // unsigned short[64]
+/* 262 */ (_cffi_opcode_t)(64),
+/* 263 */ _CFFI_OP(_CFFI_OP_POINTER, 107), // void *(*)(size_t)
+/* 264 */ _CFFI_OP(_CFFI_OP_POINTER, 175), // void(*)(IByteOut const *, unsigned char)
+/* 265 */ _CFFI_OP(_CFFI_OP_POINTER, 193), // void(*)(void *)
+/* 266 */ _CFFI_OP(_CFFI_OP_POINTER, 196), // void(*)(void *, unsigned char)
+/* 267 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 0), // void
+};
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_BatchReader(BatchReader *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { unsigned char(* *tmp)(void *) = &p->Read; (void)tmp; }
+  { InBuffer * *tmp = &p->inBuffer; (void)tmp; }
+}
+struct _cffi_align_typedef_BatchReader { char x; BatchReader y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_BufferReader(BufferReader *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { unsigned char(* *tmp)(void *) = &p->Read; (void)tmp; }
+  { InBuffer * *tmp = &p->inBuffer; (void)tmp; }
+  { ppmd_info * *tmp = &p->t; (void)tmp; }
+}
+struct _cffi_align_typedef_BufferReader { char x; BufferReader y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_BufferWriter(BufferWriter *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { void(* *tmp)(void *, unsigned char) = &p->Write; (void)tmp; }
+  { OutBuffer * *tmp = &p->outBuffer; (void)tmp; }
+  { ppmd_info * *tmp = &p->t; (void)tmp; }
+}
+struct _cffi_align_typedef_BufferWriter { char x; BufferWriter y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_CPpmd7(CPpmd7 *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { CPpmd7_Context * *tmp = &p->MinContext; (void)tmp; }
+  { CPpmd7_Context * *tmp = &p->MaxContext; (void)tmp; }
+  { CPpmd_State * *tmp = &p->FoundState; (void)tmp; }
+  (void)((p->OrderFall) | 0);  /* check that 'CPpmd7.OrderFall' is an integer */
+  (void)((p->InitEsc) | 0);  /* check that 'CPpmd7.InitEsc' is an integer */
+  (void)((p->PrevSuccess) | 0);  /* check that 'CPpmd7.PrevSuccess' is an integer */
+  (void)((p->MaxOrder) | 0);  /* check that 'CPpmd7.MaxOrder' is an integer */
+  (void)((p->HiBitsFlag) | 0);  /* check that 'CPpmd7.HiBitsFlag' is an integer */
+  (void)((p->RunLength) | 0);  /* check that 'CPpmd7.RunLength' is an integer */
+  (void)((p->InitRL) | 0);  /* check that 'CPpmd7.InitRL' is an integer */
+  (void)((p->Size) | 0);  /* check that 'CPpmd7.Size' is an integer */
+  (void)((p->GlueCount) | 0);  /* check that 'CPpmd7.GlueCount' is an integer */
+  { unsigned char * *tmp = &p->Base; (void)tmp; }
+  { unsigned char * *tmp = &p->LoUnit; (void)tmp; }
+  { unsigned char * *tmp = &p->HiUnit; (void)tmp; }
+  { unsigned char * *tmp = &p->Text; (void)tmp; }
+  { unsigned char * *tmp = &p->UnitsStart; (void)tmp; }
+  (void)((p->AlignOffset) | 0);  /* check that 'CPpmd7.AlignOffset' is an integer */
+  { unsigned char(*tmp)[38] = &p->Indx2Units; (void)tmp; }
+  { unsigned char(*tmp)[128] = &p->Units2Indx; (void)tmp; }
+  { unsigned int(*tmp)[38] = &p->FreeList; (void)tmp; }
+  { unsigned char(*tmp)[256] = &p->NS2Indx; (void)tmp; }
+  { unsigned char(*tmp)[256] = &p->NS2BSIndx; (void)tmp; }
+  { unsigned char(*tmp)[256] = &p->HB2Flag; (void)tmp; }
+  { CPpmd_See *tmp = &p->DummySee; (void)tmp; }
+  { CPpmd_See(*tmp)[25][16] = &p->See; (void)tmp; }
+  { unsigned short(*tmp)[128][64] = &p->BinSumm; (void)tmp; }
+  { CPpmd_Stats *tmp = &p->Stats; (void)tmp; }
+}
+struct _cffi_align_typedef_CPpmd7 { char x; CPpmd7 y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_CPpmd7z_RangeDec(CPpmd7z_RangeDec *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  (void)((p->Range) | 0);  /* check that 'CPpmd7z_RangeDec.Range' is an integer */
+  (void)((p->Code) | 0);  /* check that 'CPpmd7z_RangeDec.Code' is an integer */
+  { IByteIn * *tmp = &p->Stream; (void)tmp; }
+}
+struct _cffi_align_typedef_CPpmd7z_RangeDec { char x; CPpmd7z_RangeDec y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_CPpmd7z_RangeEnc(CPpmd7z_RangeEnc *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  (void)((p->Low) | 0);  /* check that 'CPpmd7z_RangeEnc.Low' is an integer */
+  (void)((p->Range) | 0);  /* check that 'CPpmd7z_RangeEnc.Range' is an integer */
+  (void)((p->Cache) | 0);  /* check that 'CPpmd7z_RangeEnc.Cache' is an integer */
+  (void)((p->CacheSize) | 0);  /* check that 'CPpmd7z_RangeEnc.CacheSize' is an integer */
+  { IByteOut * *tmp = &p->Stream; (void)tmp; }
+}
+struct _cffi_align_typedef_CPpmd7z_RangeEnc { char x; CPpmd7z_RangeEnc y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_CPpmd8(CPpmd8 *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { CPpmd8_Context * *tmp = &p->MinContext; (void)tmp; }
+  { CPpmd8_Context * *tmp = &p->MaxContext; (void)tmp; }
+  { CPpmd_State * *tmp = &p->FoundState; (void)tmp; }
+  (void)((p->OrderFall) | 0);  /* check that 'CPpmd8.OrderFall' is an integer */
+  (void)((p->InitEsc) | 0);  /* check that 'CPpmd8.InitEsc' is an integer */
+  (void)((p->PrevSuccess) | 0);  /* check that 'CPpmd8.PrevSuccess' is an integer */
+  (void)((p->MaxOrder) | 0);  /* check that 'CPpmd8.MaxOrder' is an integer */
+  (void)((p->RunLength) | 0);  /* check that 'CPpmd8.RunLength' is an integer */
+  (void)((p->InitRL) | 0);  /* check that 'CPpmd8.InitRL' is an integer */
+  (void)((p->Size) | 0);  /* check that 'CPpmd8.Size' is an integer */
+  (void)((p->GlueCount) | 0);  /* check that 'CPpmd8.GlueCount' is an integer */
+  { unsigned char * *tmp = &p->Base; (void)tmp; }
+  { unsigned char * *tmp = &p->LoUnit; (void)tmp; }
+  { unsigned char * *tmp = &p->HiUnit; (void)tmp; }
+  { unsigned char * *tmp = &p->Text; (void)tmp; }
+  { unsigned char * *tmp = &p->UnitsStart; (void)tmp; }
+  (void)((p->AlignOffset) | 0);  /* check that 'CPpmd8.AlignOffset' is an integer */
+  (void)((p->RestoreMethod) | 0);  /* check that 'CPpmd8.RestoreMethod' is an integer */
+  (void)((p->Range) | 0);  /* check that 'CPpmd8.Range' is an integer */
+  (void)((p->Code) | 0);  /* check that 'CPpmd8.Code' is an integer */
+  (void)((p->Low) | 0);  /* check that 'CPpmd8.Low' is an integer */
+  /* cannot generate 'union $1' in field 'Stream': unknown type name */
+  { unsigned char(*tmp)[38] = &p->Indx2Units; (void)tmp; }
+  { unsigned char(*tmp)[128] = &p->Units2Indx; (void)tmp; }
+  { unsigned int(*tmp)[38] = &p->FreeList; (void)tmp; }
+  { unsigned int(*tmp)[38] = &p->Stamps; (void)tmp; }
+  { unsigned char(*tmp)[256] = &p->NS2BSIndx; (void)tmp; }
+  { unsigned char(*tmp)[260] = &p->NS2Indx; (void)tmp; }
+  { CPpmd_See *tmp = &p->DummySee; (void)tmp; }
+  { CPpmd_See(*tmp)[24][32] = &p->See; (void)tmp; }
+  { unsigned short(*tmp)[25][64] = &p->BinSumm; (void)tmp; }
+  { CPpmd_Stats *tmp = &p->Stats; (void)tmp; }
+}
+struct _cffi_align_typedef_CPpmd8 { char x; CPpmd8 y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_CPpmd_See(CPpmd_See *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  (void)((p->Summ) | 0);  /* check that 'CPpmd_See.Summ' is an integer */
+  (void)((p->Shift) | 0);  /* check that 'CPpmd_See.Shift' is an integer */
+  (void)((p->Count) | 0);  /* check that 'CPpmd_See.Count' is an integer */
+}
+struct _cffi_align_typedef_CPpmd_See { char x; CPpmd_See y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_CPpmd_State(CPpmd_State *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  (void)((p->Symbol) | 0);  /* check that 'CPpmd_State.Symbol' is an integer */
+  (void)((p->Freq) | 0);  /* check that 'CPpmd_State.Freq' is an integer */
+  (void)((p->SuccessorLow) | 0);  /* check that 'CPpmd_State.SuccessorLow' is an integer */
+  (void)((p->SuccessorHigh) | 0);  /* check that 'CPpmd_State.SuccessorHigh' is an integer */
+}
+struct _cffi_align_typedef_CPpmd_State { char x; CPpmd_State y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_CPpmd_Stats(CPpmd_Stats *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  (void)((p->Restarts) | 0);  /* check that 'CPpmd_Stats.Restarts' is an integer */
+  (void)((p->CutOffs) | 0);  /* check that 'CPpmd_Stats.CutOffs' is an integer */
+  (void)((p->Glues) | 0);  /* check that 'CPpmd_Stats.Glues' is an integer */
+  (void)((p->Rescales) | 0);  /* check that 'CPpmd_Stats.Rescales' is an integer */
+  (void)((p->PeakUsed) | 0);  /* check that 'CPpmd_Stats.PeakUsed' is an integer */
+}
+struct _cffi_align_typedef_CPpmd_Stats { char x; CPpmd_Stats y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_Ppmd8BatchStream(Ppmd8BatchStream *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { CPpmd8 * *tmp = &p->cPpmd8; (void)tmp; }
+  { BatchReader *tmp = &p->reader; (void)tmp; }
+  { InBuffer *tmp = &p->in; (void)tmp; }
+  { OutBuffer *tmp = &p->out; (void)tmp; }
+  (void)((p->result) | 0);  /* check that 'Ppmd8BatchStream.result' is an integer */
+}
+struct _cffi_align_typedef_Ppmd8BatchStream { char x; Ppmd8BatchStream y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld_typedef_PpmdFilter(PpmdFilter *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  (void)((p->kind) | 0);  /* check that 'PpmdFilter.kind' is an integer */
+  (void)((p->param) | 0);  /* check that 'PpmdFilter.param' is an integer */
+  { unsigned char * *tmp = &p->buf; (void)tmp; }
+}
+struct _cffi_align_typedef_PpmdFilter { char x; PpmdFilter y; };
+
+static struct _cffi_externpy_s _cffi_externpy__raw_alloc =
+  { "pyppmd.cffi._cffi_ppmd.raw_alloc", (int)sizeof(void *), 0, 0 };
+
+static void * raw_alloc(size_t a0)
+{
+  char a[8];
+  char *p = a;
+  *(size_t *)(p + 0) = a0;
+  _cffi_call_python(&_cffi_externpy__raw_alloc, p);
+  return *(void * *)p;
+}
+
+static struct _cffi_externpy_s _cffi_externpy__raw_free =
+  { "pyppmd.cffi._cffi_ppmd.raw_free", 0, 0, 0 };
+
+static void raw_free(void * a0)
+{
+  char a[8];
+  char *p = a;
+  *(void * *)(p + 0) = a0;
+  _cffi_call_python(&_cffi_externpy__raw_free, p);
+}
+
+static void _cffi_d_Ppmd7T_Free(CPpmd7 * x0, ppmd_info * x1, IAlloc * x2)
+{
+  Ppmd7T_Free(x0, x1, x2);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd7T_Free(PyObject *self, PyObject *args)
+{
+  CPpmd7 * x0;
+  ppmd_info * x1;
+  IAlloc * x2;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd7T_Free", 3, 3, &arg0, &arg1, &arg2))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(3), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(3), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(12), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (ppmd_info *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(12), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(31), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (IAlloc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(31), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd7T_Free(x0, x1, x2); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd7T_Free _cffi_d_Ppmd7T_Free
+#endif
+
+static int _cffi_d_Ppmd7T_decode(CPpmd7 * x0, CPpmd7z_RangeDec * x1, OutBuffer * x2, int x3, ppmd_info * x4)
+{
+  return Ppmd7T_decode(x0, x1, x2, x3, x4);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd7T_decode(PyObject *self, PyObject *args)
+{
+  CPpmd7 * x0;
+  CPpmd7z_RangeDec * x1;
+  OutBuffer * x2;
+  int x3;
+  ppmd_info * x4;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+  PyObject *arg4;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd7T_decode", 5, 5, &arg0, &arg1, &arg2, &arg3, &arg4))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(3), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(3), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(4), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (CPpmd7z_RangeDec *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(4), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(9), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (OutBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(9), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x3 = _cffi_to_c_int(arg3, int);
+  if (x3 == (int)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(12), arg4, (char **)&x4);
+  if (datasize != 0) {
+    x4 = ((size_t)datasize) <= 640 ? (ppmd_info *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(12), arg4, (char **)&x4,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd7T_decode(x0, x1, x2, x3, x4); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd7T_decode _cffi_d_Ppmd7T_decode
+#endif
+
+static void _cffi_d_Ppmd7_Construct(CPpmd7 * x0)
+{
+  Ppmd7_Construct(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd7_Construct(PyObject *self, PyObject *arg0)
+{
+  CPpmd7 * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(3), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(3), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd7_Construct(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd7_Construct _cffi_d_Ppmd7_Construct
+#endif
+
+static int _cffi_d_Ppmd7_DecodeSymbol(CPpmd7 * x0, CPpmd7z_RangeDec * x1)
+{
+  return Ppmd7_DecodeSymbol(x0, x1);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd7_DecodeSymbol(PyObject *self, PyObject *args)
+{
+  CPpmd7 * x0;
+  CPpmd7z_RangeDec * x1;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd7_DecodeSymbol", 2, 2, &arg0, &arg1))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(3), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(3), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(4), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (CPpmd7z_RangeDec *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(4), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd7_DecodeSymbol(x0, x1); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd7_DecodeSymbol _cffi_d_Ppmd7_DecodeSymbol
+#endif
+
+static void _cffi_d_Ppmd7_EncodeSymbol(CPpmd7 * x0, CPpmd7z_RangeEnc * x1, int x2)
+{
+  Ppmd7_EncodeSymbol(x0, x1, x2);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd7_EncodeSymbol(PyObject *self, PyObject *args)
+{
+  CPpmd7 * x0;
+  CPpmd7z_RangeEnc * x1;
+  int x2;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd7_EncodeSymbol", 3, 3, &arg0, &arg1, &arg2))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(3), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(3), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(23), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (CPpmd7z_RangeEnc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(23), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x2 = _cffi_to_c_int(arg2, int);
+  if (x2 == (int)-1 && PyErr_Occurred())
+    return NULL;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd7_EncodeSymbol(x0, x1, x2); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd7_EncodeSymbol _cffi_d_Ppmd7_EncodeSymbol
+#endif
+
+static unsigned int _cffi_d_Ppmd7_GetUsedMemory(CPpmd7 const * x0)
+{
+  return Ppmd7_GetUsedMemory(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd7_GetUsedMemory(PyObject *self, PyObject *arg0)
+{
+  CPpmd7 const * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  unsigned int result;
+  PyObject *pyresult;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(97), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 const *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(97), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd7_GetUsedMemory(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, unsigned int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd7_GetUsedMemory _cffi_d_Ppmd7_GetUsedMemory
+#endif
+
+static void _cffi_d_Ppmd7_Init(CPpmd7 * x0, unsigned int x1)
+{
+  Ppmd7_Init(x0, x1);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd7_Init(PyObject *self, PyObject *args)
+{
+  CPpmd7 * x0;
+  unsigned int x1;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd7_Init", 2, 2, &arg0, &arg1))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(3), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(3), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, unsigned int);
+  if (x1 == (unsigned int)-1 && PyErr_Occurred())
+    return NULL;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd7_Init(x0, x1); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd7_Init _cffi_d_Ppmd7_Init
+#endif
+
+static void _cffi_d_Ppmd7z_RangeEnc_FlushData(CPpmd7z_RangeEnc * x0)
+{
+  Ppmd7z_RangeEnc_FlushData(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd7z_RangeEnc_FlushData(PyObject *self, PyObject *arg0)
+{
+  CPpmd7z_RangeEnc * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(23), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7z_RangeEnc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(23), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd7z_RangeEnc_FlushData(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd7z_RangeEnc_FlushData _cffi_d_Ppmd7z_RangeEnc_FlushData
+#endif
+
+static void _cffi_d_Ppmd7z_RangeEnc_Init(CPpmd7z_RangeEnc * x0)
+{
+  Ppmd7z_RangeEnc_Init(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd7z_RangeEnc_Init(PyObject *self, PyObject *arg0)
+{
+  CPpmd7z_RangeEnc * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(23), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7z_RangeEnc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(23), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd7z_RangeEnc_Init(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd7z_RangeEnc_Init _cffi_d_Ppmd7z_RangeEnc_Init
+#endif
+
+static void _cffi_d_Ppmd8Batch_Decode(Ppmd8BatchStream * x0, unsigned int x1)
+{
+  Ppmd8Batch_Decode(x0, x1);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8Batch_Decode(PyObject *self, PyObject *args)
+{
+  Ppmd8BatchStream * x0;
+  unsigned int x1;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd8Batch_Decode", 2, 2, &arg0, &arg1))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(76), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (Ppmd8BatchStream *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(76), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, unsigned int);
+  if (x1 == (unsigned int)-1 && PyErr_Occurred())
+    return NULL;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd8Batch_Decode(x0, x1); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd8Batch_Decode _cffi_d_Ppmd8Batch_Decode
+#endif
+
+static int _cffi_d_Ppmd8Batch_Init(Ppmd8BatchStream * x0, CPpmd8 * x1, void const * x2, size_t x3)
+{
+  return Ppmd8Batch_Init(x0, x1, x2, x3);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8Batch_Init(PyObject *self, PyObject *args)
+{
+  Ppmd8BatchStream * x0;
+  CPpmd8 * x1;
+  void const * x2;
+  size_t x3;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd8Batch_Init", 4, 4, &arg0, &arg1, &arg2, &arg3))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(76), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (Ppmd8BatchStream *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(76), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(78), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (void const *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(78), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x3 = _cffi_to_c_int(arg3, size_t);
+  if (x3 == (size_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd8Batch_Init(x0, x1, x2, x3); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd8Batch_Init _cffi_d_Ppmd8Batch_Init
+#endif
+
+static void _cffi_d_Ppmd8T_Free(CPpmd8 * x0, ppmd_info * x1, IAlloc * x2)
+{
+  Ppmd8T_Free(x0, x1, x2);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8T_Free(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  ppmd_info * x1;
+  IAlloc * x2;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd8T_Free", 3, 3, &arg0, &arg1, &arg2))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(12), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (ppmd_info *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(12), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(31), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (IAlloc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(31), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd8T_Free(x0, x1, x2); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd8T_Free _cffi_d_Ppmd8T_Free
+#endif
+
+static int _cffi_d_Ppmd8T_decode(CPpmd8 * x0, OutBuffer * x1, int x2, ppmd_info * x3)
+{
+  return Ppmd8T_decode(x0, x1, x2, x3);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8T_decode(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  OutBuffer * x1;
+  int x2;
+  ppmd_info * x3;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd8T_decode", 4, 4, &arg0, &arg1, &arg2, &arg3))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(9), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (OutBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(9), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x2 = _cffi_to_c_int(arg2, int);
+  if (x2 == (int)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(12), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (ppmd_info *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(12), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd8T_decode(x0, x1, x2, x3); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd8T_decode _cffi_d_Ppmd8T_decode
+#endif
+
+static int _cffi_d_Ppmd8_Alloc(CPpmd8 * x0, unsigned int x1, IAlloc * x2)
+{
+  return Ppmd8_Alloc(x0, x1, x2);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8_Alloc(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  unsigned int x1;
+  IAlloc * x2;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd8_Alloc", 3, 3, &arg0, &arg1, &arg2))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, unsigned int);
+  if (x1 == (unsigned int)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(31), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (IAlloc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(31), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd8_Alloc(x0, x1, x2); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd8_Alloc _cffi_d_Ppmd8_Alloc
+#endif
+
+static void _cffi_d_Ppmd8_Construct(CPpmd8 * x0)
+{
+  Ppmd8_Construct(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8_Construct(PyObject *self, PyObject *arg0)
+{
+  CPpmd8 * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd8_Construct(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd8_Construct _cffi_d_Ppmd8_Construct
+#endif
+
+static int _cffi_d_Ppmd8_DecodeSymbol(CPpmd8 * x0)
+{
+  return Ppmd8_DecodeSymbol(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8_DecodeSymbol(PyObject *self, PyObject *arg0)
+{
+  CPpmd8 * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd8_DecodeSymbol(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd8_DecodeSymbol _cffi_d_Ppmd8_DecodeSymbol
+#endif
+
+static void _cffi_d_Ppmd8_EncodeSymbol(CPpmd8 * x0, int x1)
+{
+  Ppmd8_EncodeSymbol(x0, x1);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8_EncodeSymbol(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  int x1;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd8_EncodeSymbol", 2, 2, &arg0, &arg1))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, int);
+  if (x1 == (int)-1 && PyErr_Occurred())
+    return NULL;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd8_EncodeSymbol(x0, x1); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd8_EncodeSymbol _cffi_d_Ppmd8_EncodeSymbol
+#endif
+
+static void _cffi_d_Ppmd8_Free(CPpmd8 * x0, IAlloc * x1)
+{
+  Ppmd8_Free(x0, x1);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8_Free(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  IAlloc * x1;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd8_Free", 2, 2, &arg0, &arg1))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(31), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (IAlloc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(31), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd8_Free(x0, x1); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd8_Free _cffi_d_Ppmd8_Free
+#endif
+
+static unsigned int _cffi_d_Ppmd8_GetUsedMemory(CPpmd8 const * x0)
+{
+  return Ppmd8_GetUsedMemory(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8_GetUsedMemory(PyObject *self, PyObject *arg0)
+{
+  CPpmd8 const * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  unsigned int result;
+  PyObject *pyresult;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(100), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 const *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(100), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd8_GetUsedMemory(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, unsigned int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd8_GetUsedMemory _cffi_d_Ppmd8_GetUsedMemory
+#endif
+
+static void _cffi_d_Ppmd8_Init(CPpmd8 * x0, unsigned int x1, unsigned int x2)
+{
+  Ppmd8_Init(x0, x1, x2);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8_Init(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  unsigned int x1;
+  unsigned int x2;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+
+  if (!PyArg_UnpackTuple(args, "Ppmd8_Init", 3, 3, &arg0, &arg1, &arg2))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, unsigned int);
+  if (x1 == (unsigned int)-1 && PyErr_Occurred())
+    return NULL;
+
+  x2 = _cffi_to_c_int(arg2, unsigned int);
+  if (x2 == (unsigned int)-1 && PyErr_Occurred())
+    return NULL;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd8_Init(x0, x1, x2); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd8_Init _cffi_d_Ppmd8_Init
+#endif
+
+static int _cffi_d_Ppmd8_RangeDec_Init(CPpmd8 * x0)
+{
+  return Ppmd8_RangeDec_Init(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8_RangeDec_Init(PyObject *self, PyObject *arg0)
+{
+  CPpmd8 * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd8_RangeDec_Init(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd8_RangeDec_Init _cffi_d_Ppmd8_RangeDec_Init
+#endif
+
+static void _cffi_d_Ppmd8_RangeEnc_FlushData(CPpmd8 * x0)
+{
+  Ppmd8_RangeEnc_FlushData(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8_RangeEnc_FlushData(PyObject *self, PyObject *arg0)
+{
+  CPpmd8 * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd8_RangeEnc_FlushData(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd8_RangeEnc_FlushData _cffi_d_Ppmd8_RangeEnc_FlushData
+#endif
+
+static void _cffi_d_Ppmd8_RangeEnc_Init(CPpmd8 * x0)
+{
+  Ppmd8_RangeEnc_Init(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd8_RangeEnc_Init(PyObject *self, PyObject *arg0)
+{
+  CPpmd8 * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd8_RangeEnc_Init(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd8_RangeEnc_Init _cffi_d_Ppmd8_RangeEnc_Init
+#endif
+
+static void _cffi_d_PpmdFilter_EncodeEnd(PpmdFilter * x0)
+{
+  PpmdFilter_EncodeEnd(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_PpmdFilter_EncodeEnd(PyObject *self, PyObject *arg0)
+{
+  PpmdFilter * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(56), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (PpmdFilter *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(56), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { PpmdFilter_EncodeEnd(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_PpmdFilter_EncodeEnd _cffi_d_PpmdFilter_EncodeEnd
+#endif
+
+static void _cffi_d_PpmdFilter_Free(PpmdFilter * x0, IAlloc * x1)
+{
+  PpmdFilter_Free(x0, x1);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_PpmdFilter_Free(PyObject *self, PyObject *args)
+{
+  PpmdFilter * x0;
+  IAlloc * x1;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+
+  if (!PyArg_UnpackTuple(args, "PpmdFilter_Free", 2, 2, &arg0, &arg1))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(56), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (PpmdFilter *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(56), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(31), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (IAlloc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(31), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { PpmdFilter_Free(x0, x1); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_PpmdFilter_Free _cffi_d_PpmdFilter_Free
+#endif
+
+static int _cffi_d_PpmdFilter_Init(PpmdFilter * x0, int x1, unsigned int x2, IAlloc * x3)
+{
+  return PpmdFilter_Init(x0, x1, x2, x3);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_PpmdFilter_Init(PyObject *self, PyObject *args)
+{
+  PpmdFilter * x0;
+  int x1;
+  unsigned int x2;
+  IAlloc * x3;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+
+  if (!PyArg_UnpackTuple(args, "PpmdFilter_Init", 4, 4, &arg0, &arg1, &arg2, &arg3))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(56), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (PpmdFilter *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(56), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, int);
+  if (x1 == (int)-1 && PyErr_Occurred())
+    return NULL;
+
+  x2 = _cffi_to_c_int(arg2, unsigned int);
+  if (x2 == (unsigned int)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(31), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (IAlloc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(31), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = PpmdFilter_Init(x0, x1, x2, x3); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_PpmdFilter_Init _cffi_d_PpmdFilter_Init
+#endif
+
+static unsigned int _cffi_d_Ppmd_GetCpuFeatures(void)
+{
+  return Ppmd_GetCpuFeatures();
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd_GetCpuFeatures(PyObject *self, PyObject *noarg)
+{
+  unsigned int result;
+  PyObject *pyresult;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd_GetCpuFeatures(); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  (void)noarg; /* unused */
+  pyresult = _cffi_from_c_int(result, unsigned int);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd_GetCpuFeatures _cffi_d_Ppmd_GetCpuFeatures
+#endif
+
+static unsigned int _cffi_d_Ppmd_KernelFeatures(char const * x0)
+{
+  return Ppmd_KernelFeatures(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd_KernelFeatures(PyObject *self, PyObject *arg0)
+{
+  char const * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  unsigned int result;
+  PyObject *pyresult;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(103), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (char const *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(103), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd_KernelFeatures(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, unsigned int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd_KernelFeatures _cffi_d_Ppmd_KernelFeatures
+#endif
+
+static char const * _cffi_d_Ppmd_KernelName(void)
+{
+  return Ppmd_KernelName();
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd_KernelName(PyObject *self, PyObject *noarg)
+{
+  char const * result;
+  PyObject *pyresult;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd_KernelName(); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  (void)noarg; /* unused */
+  pyresult = _cffi_from_c_pointer((char *)result, _cffi_type(103));
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd_KernelName _cffi_d_Ppmd_KernelName
+#endif
+
+static void _cffi_d_Ppmd_SelectKernels(unsigned int x0)
+{
+  Ppmd_SelectKernels(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd_SelectKernels(PyObject *self, PyObject *arg0)
+{
+  unsigned int x0;
+
+  x0 = _cffi_to_c_int(arg0, unsigned int);
+  if (x0 == (unsigned int)-1 && PyErr_Occurred())
+    return NULL;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Ppmd_SelectKernels(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Ppmd_SelectKernels _cffi_d_Ppmd_SelectKernels
+#endif
+
+static unsigned char _cffi_d_Ppmd_thread_Reader(void const * x0)
+{
+  return Ppmd_thread_Reader(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Ppmd_thread_Reader(PyObject *self, PyObject *arg0)
+{
+  void const * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  unsigned char result;
+  PyObject *pyresult;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(78), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (void const *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(78), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Ppmd_thread_Reader(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, unsigned char);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Ppmd_thread_Reader _cffi_d_Ppmd_thread_Reader
+#endif
+
+static unsigned char _cffi_d_Reader(void const * x0)
+{
+  return Reader(x0);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Reader(PyObject *self, PyObject *arg0)
+{
+  void const * x0;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  unsigned char result;
+  PyObject *pyresult;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(78), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (void const *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(78), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = Reader(x0); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, unsigned char);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_Reader _cffi_d_Reader
+#endif
+
+static void _cffi_d_Writer(void const * x0, unsigned char x1)
+{
+  Writer(x0, x1);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_Writer(PyObject *self, PyObject *args)
+{
+  void const * x0;
+  unsigned char x1;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+
+  if (!PyArg_UnpackTuple(args, "Writer", 2, 2, &arg0, &arg1))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(78), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (void const *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(78), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, unsigned char);
+  if (x1 == (unsigned char)-1 && PyErr_Occurred())
+    return NULL;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { Writer(x0, x1); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_Writer _cffi_d_Writer
+#endif
+
+static int _cffi_d_ppmd7_compress(CPpmd7 * x0, CPpmd7z_RangeEnc * x1, OutBuffer * x2, InBuffer * x3)
+{
+  return ppmd7_compress(x0, x1, x2, x3);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd7_compress(PyObject *self, PyObject *args)
+{
+  CPpmd7 * x0;
+  CPpmd7z_RangeEnc * x1;
+  OutBuffer * x2;
+  InBuffer * x3;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+
+  if (!PyArg_UnpackTuple(args, "ppmd7_compress", 4, 4, &arg0, &arg1, &arg2, &arg3))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(3), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(3), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(23), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (CPpmd7z_RangeEnc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(23), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(9), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (OutBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(9), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(10), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (InBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(10), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = ppmd7_compress(x0, x1, x2, x3); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_ppmd7_compress _cffi_d_ppmd7_compress
+#endif
+
+static void _cffi_d_ppmd7_compress_flush(CPpmd7 * x0, CPpmd7z_RangeEnc * x1, int x2)
+{
+  ppmd7_compress_flush(x0, x1, x2);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd7_compress_flush(PyObject *self, PyObject *args)
+{
+  CPpmd7 * x0;
+  CPpmd7z_RangeEnc * x1;
+  int x2;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+
+  if (!PyArg_UnpackTuple(args, "ppmd7_compress_flush", 3, 3, &arg0, &arg1, &arg2))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(3), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(3), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(23), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (CPpmd7z_RangeEnc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(23), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x2 = _cffi_to_c_int(arg2, int);
+  if (x2 == (int)-1 && PyErr_Occurred())
+    return NULL;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { ppmd7_compress_flush(x0, x1, x2); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_ppmd7_compress_flush _cffi_d_ppmd7_compress_flush
+#endif
+
+static void _cffi_d_ppmd7_compress_init(CPpmd7z_RangeEnc * x0, BufferWriter * x1)
+{
+  ppmd7_compress_init(x0, x1);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd7_compress_init(PyObject *self, PyObject *args)
+{
+  CPpmd7z_RangeEnc * x0;
+  BufferWriter * x1;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+
+  if (!PyArg_UnpackTuple(args, "ppmd7_compress_init", 2, 2, &arg0, &arg1))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(23), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7z_RangeEnc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(23), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(142), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (BufferWriter *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(142), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { ppmd7_compress_init(x0, x1); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_ppmd7_compress_init _cffi_d_ppmd7_compress_init
+#endif
+
+static int _cffi_d_ppmd7_decompress(CPpmd7 * x0, CPpmd7z_RangeDec * x1, OutBuffer * x2, InBuffer * x3, size_t x4, ppmd_info * x5)
+{
+  return ppmd7_decompress(x0, x1, x2, x3, x4, x5);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd7_decompress(PyObject *self, PyObject *args)
+{
+  CPpmd7 * x0;
+  CPpmd7z_RangeDec * x1;
+  OutBuffer * x2;
+  InBuffer * x3;
+  size_t x4;
+  ppmd_info * x5;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+  PyObject *arg4;
+  PyObject *arg5;
+
+  if (!PyArg_UnpackTuple(args, "ppmd7_decompress", 6, 6, &arg0, &arg1, &arg2, &arg3, &arg4, &arg5))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(3), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(3), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(4), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (CPpmd7z_RangeDec *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(4), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(9), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (OutBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(9), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(10), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (InBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(10), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x4 = _cffi_to_c_int(arg4, size_t);
+  if (x4 == (size_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(12), arg5, (char **)&x5);
+  if (datasize != 0) {
+    x5 = ((size_t)datasize) <= 640 ? (ppmd_info *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(12), arg5, (char **)&x5,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = ppmd7_decompress(x0, x1, x2, x3, x4, x5); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_ppmd7_decompress _cffi_d_ppmd7_decompress
+#endif
+
+static int _cffi_d_ppmd7_decompress_init(CPpmd7z_RangeDec * x0, BufferReader * x1, ppmd_info * x2, IAlloc * x3)
+{
+  return ppmd7_decompress_init(x0, x1, x2, x3);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd7_decompress_init(PyObject *self, PyObject *args)
+{
+  CPpmd7z_RangeDec * x0;
+  BufferReader * x1;
+  ppmd_info * x2;
+  IAlloc * x3;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+
+  if (!PyArg_UnpackTuple(args, "ppmd7_decompress_init", 4, 4, &arg0, &arg1, &arg2, &arg3))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(4), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7z_RangeDec *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(4), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(29), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (BufferReader *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(29), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(12), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (ppmd_info *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(12), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(31), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (IAlloc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(31), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = ppmd7_decompress_init(x0, x1, x2, x3); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_ppmd7_decompress_init _cffi_d_ppmd7_decompress_init
+#endif
+
+static void _cffi_d_ppmd7_state_close(CPpmd7 * x0, IAlloc * x1)
+{
+  ppmd7_state_close(x0, x1);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd7_state_close(PyObject *self, PyObject *args)
+{
+  CPpmd7 * x0;
+  IAlloc * x1;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+
+  if (!PyArg_UnpackTuple(args, "ppmd7_state_close", 2, 2, &arg0, &arg1))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(3), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(3), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(31), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (IAlloc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(31), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { ppmd7_state_close(x0, x1); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_ppmd7_state_close _cffi_d_ppmd7_state_close
+#endif
+
+static void _cffi_d_ppmd7_state_init(CPpmd7 * x0, unsigned int x1, unsigned int x2, IAlloc * x3)
+{
+  ppmd7_state_init(x0, x1, x2, x3);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd7_state_init(PyObject *self, PyObject *args)
+{
+  CPpmd7 * x0;
+  unsigned int x1;
+  unsigned int x2;
+  IAlloc * x3;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+
+  if (!PyArg_UnpackTuple(args, "ppmd7_state_init", 4, 4, &arg0, &arg1, &arg2, &arg3))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(3), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd7 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(3), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, unsigned int);
+  if (x1 == (unsigned int)-1 && PyErr_Occurred())
+    return NULL;
+
+  x2 = _cffi_to_c_int(arg2, unsigned int);
+  if (x2 == (unsigned int)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(31), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (IAlloc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(31), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { ppmd7_state_init(x0, x1, x2, x3); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_ppmd7_state_init _cffi_d_ppmd7_state_init
+#endif
+
+static int _cffi_d_ppmd8_compress(CPpmd8 * x0, OutBuffer * x1, InBuffer * x2)
+{
+  return ppmd8_compress(x0, x1, x2);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd8_compress(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  OutBuffer * x1;
+  InBuffer * x2;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+
+  if (!PyArg_UnpackTuple(args, "ppmd8_compress", 3, 3, &arg0, &arg1, &arg2))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(9), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (OutBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(9), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(10), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (InBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(10), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = ppmd8_compress(x0, x1, x2); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_ppmd8_compress _cffi_d_ppmd8_compress
+#endif
+
+static int _cffi_d_ppmd8_compress_filtered(CPpmd8 * x0, PpmdFilter * x1, OutBuffer * x2, InBuffer * x3)
+{
+  return ppmd8_compress_filtered(x0, x1, x2, x3);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd8_compress_filtered(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  PpmdFilter * x1;
+  OutBuffer * x2;
+  InBuffer * x3;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+
+  if (!PyArg_UnpackTuple(args, "ppmd8_compress_filtered", 4, 4, &arg0, &arg1, &arg2, &arg3))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(56), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (PpmdFilter *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(56), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(9), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (OutBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(9), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(10), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (InBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(10), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = ppmd8_compress_filtered(x0, x1, x2, x3); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_ppmd8_compress_filtered _cffi_d_ppmd8_compress_filtered
+#endif
+
+static void _cffi_d_ppmd8_compress_init(CPpmd8 * x0, BufferWriter * x1)
+{
+  ppmd8_compress_init(x0, x1);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd8_compress_init(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  BufferWriter * x1;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+
+  if (!PyArg_UnpackTuple(args, "ppmd8_compress_init", 2, 2, &arg0, &arg1))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(142), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (BufferWriter *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(142), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { ppmd8_compress_init(x0, x1); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_ppmd8_compress_init _cffi_d_ppmd8_compress_init
+#endif
+
+static int _cffi_d_ppmd8_decompress(CPpmd8 * x0, OutBuffer * x1, InBuffer * x2, int x3, ppmd_info * x4)
+{
+  return ppmd8_decompress(x0, x1, x2, x3, x4);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd8_decompress(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  OutBuffer * x1;
+  InBuffer * x2;
+  int x3;
+  ppmd_info * x4;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+  PyObject *arg4;
+
+  if (!PyArg_UnpackTuple(args, "ppmd8_decompress", 5, 5, &arg0, &arg1, &arg2, &arg3, &arg4))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(9), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (OutBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(9), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(10), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (InBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(10), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x3 = _cffi_to_c_int(arg3, int);
+  if (x3 == (int)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(12), arg4, (char **)&x4);
+  if (datasize != 0) {
+    x4 = ((size_t)datasize) <= 640 ? (ppmd_info *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(12), arg4, (char **)&x4,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = ppmd8_decompress(x0, x1, x2, x3, x4); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_ppmd8_decompress _cffi_d_ppmd8_decompress
+#endif
+
+static int _cffi_d_ppmd8_decompress_filtered(CPpmd8 * x0, PpmdFilter * x1, OutBuffer * x2, int * x3, OutBuffer * x4, InBuffer * x5, int x6, ppmd_info * x7)
+{
+  return ppmd8_decompress_filtered(x0, x1, x2, x3, x4, x5, x6, x7);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd8_decompress_filtered(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  PpmdFilter * x1;
+  OutBuffer * x2;
+  int * x3;
+  OutBuffer * x4;
+  InBuffer * x5;
+  int x6;
+  ppmd_info * x7;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  int result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+  PyObject *arg4;
+  PyObject *arg5;
+  PyObject *arg6;
+  PyObject *arg7;
+
+  if (!PyArg_UnpackTuple(args, "ppmd8_decompress_filtered", 8, 8, &arg0, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(56), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (PpmdFilter *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(56), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(9), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (OutBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(9), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(64), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (int *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(64), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(9), arg4, (char **)&x4);
+  if (datasize != 0) {
+    x4 = ((size_t)datasize) <= 640 ? (OutBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(9), arg4, (char **)&x4,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(10), arg5, (char **)&x5);
+  if (datasize != 0) {
+    x5 = ((size_t)datasize) <= 640 ? (InBuffer *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(10), arg5, (char **)&x5,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x6 = _cffi_to_c_int(arg6, int);
+  if (x6 == (int)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(12), arg7, (char **)&x7);
+  if (datasize != 0) {
+    x7 = ((size_t)datasize) <= 640 ? (ppmd_info *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(12), arg7, (char **)&x7,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = ppmd8_decompress_filtered(x0, x1, x2, x3, x4, x5, x6, x7); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, int);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_ppmd8_decompress_filtered _cffi_d_ppmd8_decompress_filtered
+#endif
+
+static void _cffi_d_ppmd8_decompress_init(CPpmd8 * x0, BufferReader * x1, ppmd_info * x2, IAlloc * x3)
+{
+  ppmd8_decompress_init(x0, x1, x2, x3);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_ppmd8_decompress_init(PyObject *self, PyObject *args)
+{
+  CPpmd8 * x0;
+  BufferReader * x1;
+  ppmd_info * x2;
+  IAlloc * x3;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+
+  if (!PyArg_UnpackTuple(args, "ppmd8_decompress_init", 4, 4, &arg0, &arg1, &arg2, &arg3))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(34), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (CPpmd8 *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(34), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(29), arg1, (char **)&x1);
+  if (datasize != 0) {
+    x1 = ((size_t)datasize) <= 640 ? (BufferReader *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(29), arg1, (char **)&x1,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(12), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (ppmd_info *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(12), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(31), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (IAlloc *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(31), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { ppmd8_decompress_init(x0, x1, x2, x3); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+#else
+#  define _cffi_f_ppmd8_decompress_init _cffi_d_ppmd8_decompress_init
+#endif
+
+static int _cffi_const_PPMD_BATCH_MAX_WIDTH(unsigned long long *o)
+{
+  int n = (PPMD_BATCH_MAX_WIDTH) <= 0;
+  *o = (unsigned long long)((PPMD_BATCH_MAX_WIDTH) | 0);  /* check that PPMD_BATCH_MAX_WIDTH is an integer */
+  return n;
+}
+
+static int _cffi_const_PPMD_CPU_AVX2(unsigned long long *o)
+{
+  int n = (PPMD_CPU_AVX2) <= 0;
+  *o = (unsigned long long)((PPMD_CPU_AVX2) | 0);  /* check that PPMD_CPU_AVX2 is an integer */
+  return n;
+}
+
+static int _cffi_const_PPMD_CPU_AVX512BW(unsigned long long *o)
+{
+  int n = (PPMD_CPU_AVX512BW) <= 0;
+  *o = (unsigned long long)((PPMD_CPU_AVX512BW) | 0);  /* check that PPMD_CPU_AVX512BW is an integer */
+  return n;
+}
+
+static int _cffi_const_PPMD_CPU_NEON(unsigned long long *o)
+{
+  int n = (PPMD_CPU_NEON) <= 0;
+  *o = (unsigned long long)((PPMD_CPU_NEON) | 0);  /* check that PPMD_CPU_NEON is an integer */
+  return n;
+}
+
+static int _cffi_const_PPMD_CPU_SSSE3(unsigned long long *o)
+{
+  int n = (PPMD_CPU_SSSE3) <= 0;
+  *o = (unsigned long long)((PPMD_CPU_SSSE3) | 0);  /* check that PPMD_CPU_SSSE3 is an integer */
+  return n;
+}
+
+static int _cffi_const_PPMD_FILTER_DELTA(unsigned long long *o)
+{
+  int n = (PPMD_FILTER_DELTA) <= 0;
+  *o = (unsigned long long)((PPMD_FILTER_DELTA) | 0);  /* check that PPMD_FILTER_DELTA is an integer */
+  return n;
+}
+
+static int _cffi_const_PPMD_FILTER_NONE(unsigned long long *o)
+{
+  int n = (PPMD_FILTER_NONE) <= 0;
+  *o = (unsigned long long)((PPMD_FILTER_NONE) | 0);  /* check that PPMD_FILTER_NONE is an integer */
+  return n;
+}
+
+static int _cffi_const_PPMD_FILTER_TRANSPOSE(unsigned long long *o)
+{
+  int n = (PPMD_FILTER_TRANSPOSE) <= 0;
+  *o = (unsigned long long)((PPMD_FILTER_TRANSPOSE) | 0);  /* check that PPMD_FILTER_TRANSPOSE is an integer */
+  return n;
+}
+
+static int _cffi_const_PPMD_FILTER_X86(unsigned long long *o)
+{
+  int n = (PPMD_FILTER_X86) <= 0;
+  *o = (unsigned long long)((PPMD_FILTER_X86) | 0);  /* check that PPMD_FILTER_X86 is an integer */
+  return n;
+}
+
+static int _cffi_const_PPMD_RESULT_EOF(unsigned long long *o)
+{
+  int n = (PPMD_RESULT_EOF) <= 0;
+  *o = (unsigned long long)((PPMD_RESULT_EOF) | 0);  /* check that PPMD_RESULT_EOF is an integer */
+  return n;
+}
+
+static int _cffi_const_PPMD_RESULT_ERROR(unsigned long long *o)
+{
+  int n = (PPMD_RESULT_ERROR) <= 0;
+  *o = (unsigned long long)((PPMD_RESULT_ERROR) | 0);  /* check that PPMD_RESULT_ERROR is an integer */
+  return n;
+}
+
+static int _cffi_const_PPMD_RESULT_LIMIT(unsigned long long *o)
+{
+  int n = (PPMD_RESULT_LIMIT) <= 0;
+  *o = (unsigned long long)((PPMD_RESULT_LIMIT) | 0);  /* check that PPMD_RESULT_LIMIT is an integer */
+  return n;
+}
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld__CPpmd7_Context(CPpmd7_Context *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  (void)((p->NumStats) | 0);  /* check that 'CPpmd7_Context.NumStats' is an integer */
+  (void)((p->SummFreq) | 0);  /* check that 'CPpmd7_Context.SummFreq' is an integer */
+  (void)((p->Stats) | 0);  /* check that 'CPpmd7_Context.Stats' is an integer */
+  (void)((p->Suffix) | 0);  /* check that 'CPpmd7_Context.Suffix' is an integer */
+}
+struct _cffi_align__CPpmd7_Context { char x; CPpmd7_Context y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld__CPpmd8_Context(CPpmd8_Context *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  (void)((p->NumStats) | 0);  /* check that 'CPpmd8_Context.NumStats' is an integer */
+  (void)((p->Flags) | 0);  /* check that 'CPpmd8_Context.Flags' is an integer */
+  (void)((p->SummFreq) | 0);  /* check that 'CPpmd8_Context.SummFreq' is an integer */
+  (void)((p->Stats) | 0);  /* check that 'CPpmd8_Context.Stats' is an integer */
+  (void)((p->Suffix) | 0);  /* check that 'CPpmd8_Context.Suffix' is an integer */
+}
+struct _cffi_align__CPpmd8_Context { char x; CPpmd8_Context y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld__IAlloc(IAlloc *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { void *(* *tmp)(size_t) = &p->Alloc; (void)tmp; }
+  { void(* *tmp)(void *) = &p->Free; (void)tmp; }
+}
+struct _cffi_align__IAlloc { char x; IAlloc y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld__IByteIn(IByteIn *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { unsigned char(* *tmp)(IByteIn const *) = &p->Read; (void)tmp; }
+}
+struct _cffi_align__IByteIn { char x; IByteIn y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld__IByteOut(IByteOut *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { void(* *tmp)(IByteOut const *, unsigned char) = &p->Write; (void)tmp; }
+}
+struct _cffi_align__IByteOut { char x; IByteOut y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld__InBuffer(InBuffer *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { void const * *tmp = &p->src; (void)tmp; }
+  (void)((p->size) | 0);  /* check that 'InBuffer.size' is an integer */
+  (void)((p->pos) | 0);  /* check that 'InBuffer.pos' is an integer */
+}
+struct _cffi_align__InBuffer { char x; InBuffer y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld__OutBuffer(OutBuffer *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { void * *tmp = &p->dst; (void)tmp; }
+  (void)((p->size) | 0);  /* check that 'OutBuffer.size' is an integer */
+  (void)((p->pos) | 0);  /* check that 'OutBuffer.pos' is an integer */
+}
+struct _cffi_align__OutBuffer { char x; OutBuffer y; };
+
+_CFFI_UNUSED_FN
+static void _cffi_checkfld__ppmd_info(ppmd_info *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  { void * *tmp = &p->cPpmd; (void)tmp; }
+  { void * *tmp = &p->rc; (void)tmp; }
+  { InBuffer * *tmp = &p->in; (void)tmp; }
+  { OutBuffer * *tmp = &p->out; (void)tmp; }
+  (void)((p->max_length) | 0);  /* check that 'ppmd_info.max_length' is an integer */
+  (void)((p->result) | 0);  /* check that 'ppmd_info.result' is an integer */
+  { void * *tmp = &p->t; (void)tmp; }
+}
+struct _cffi_align__ppmd_info { char x; ppmd_info y; };
+
+static const struct _cffi_global_s _cffi_globals[] = {
+  { "PPMD_BATCH_MAX_WIDTH", (void *)_cffi_const_PPMD_BATCH_MAX_WIDTH, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "PPMD_CPU_AVX2", (void *)_cffi_const_PPMD_CPU_AVX2, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "PPMD_CPU_AVX512BW", (void *)_cffi_const_PPMD_CPU_AVX512BW, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "PPMD_CPU_NEON", (void *)_cffi_const_PPMD_CPU_NEON, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "PPMD_CPU_SSSE3", (void *)_cffi_const_PPMD_CPU_SSSE3, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "PPMD_FILTER_DELTA", (void *)_cffi_const_PPMD_FILTER_DELTA, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "PPMD_FILTER_NONE", (void *)_cffi_const_PPMD_FILTER_NONE, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "PPMD_FILTER_TRANSPOSE", (void *)_cffi_const_PPMD_FILTER_TRANSPOSE, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "PPMD_FILTER_X86", (void *)_cffi_const_PPMD_FILTER_X86, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "PPMD_RESULT_EOF", (void *)_cffi_const_PPMD_RESULT_EOF, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "PPMD_RESULT_ERROR", (void *)_cffi_const_PPMD_RESULT_ERROR, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "PPMD_RESULT_LIMIT", (void *)_cffi_const_PPMD_RESULT_LIMIT, _CFFI_OP(_CFFI_OP_CONSTANT_INT, -1), (void *)0 },
+  { "Ppmd7T_Free", (void *)_cffi_f_Ppmd7T_Free, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 122), (void *)_cffi_d_Ppmd7T_Free },
+  { "Ppmd7T_decode", (void *)_cffi_f_Ppmd7T_decode, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 14), (void *)_cffi_d_Ppmd7T_decode },
+  { "Ppmd7_Construct", (void *)_cffi_f_Ppmd7_Construct, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 110), (void *)_cffi_d_Ppmd7_Construct },
+  { "Ppmd7_DecodeSymbol", (void *)_cffi_f_Ppmd7_DecodeSymbol, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 2), (void *)_cffi_d_Ppmd7_DecodeSymbol },
+  { "Ppmd7_EncodeSymbol", (void *)_cffi_f_Ppmd7_EncodeSymbol, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 113), (void *)_cffi_d_Ppmd7_EncodeSymbol },
+  { "Ppmd7_GetUsedMemory", (void *)_cffi_f_Ppmd7_GetUsedMemory, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 96), (void *)_cffi_d_Ppmd7_GetUsedMemory },
+  { "Ppmd7_Init", (void *)_cffi_f_Ppmd7_Init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 127), (void *)_cffi_d_Ppmd7_Init },
+  { "Ppmd7z_RangeEnc_FlushData", (void *)_cffi_f_Ppmd7z_RangeEnc_FlushData, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 137), (void *)_cffi_d_Ppmd7z_RangeEnc_FlushData },
+  { "Ppmd7z_RangeEnc_Init", (void *)_cffi_f_Ppmd7z_RangeEnc_Init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 137), (void *)_cffi_d_Ppmd7z_RangeEnc_Init },
+  { "Ppmd8Batch_Decode", (void *)_cffi_f_Ppmd8Batch_Decode, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 179), (void *)_cffi_d_Ppmd8Batch_Decode },
+  { "Ppmd8Batch_Init", (void *)_cffi_f_Ppmd8Batch_Init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 75), (void *)_cffi_d_Ppmd8Batch_Init },
+  { "Ppmd8T_Free", (void *)_cffi_f_Ppmd8T_Free, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 165), (void *)_cffi_d_Ppmd8T_Free },
+  { "Ppmd8T_decode", (void *)_cffi_f_Ppmd8T_decode, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 48), (void *)_cffi_d_Ppmd8T_decode },
+  { "Ppmd8_Alloc", (void *)_cffi_f_Ppmd8_Alloc, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 70), (void *)_cffi_d_Ppmd8_Alloc },
+  { "Ppmd8_Construct", (void *)_cffi_f_Ppmd8_Construct, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 144), (void *)_cffi_d_Ppmd8_Construct },
+  { "Ppmd8_DecodeSymbol", (void *)_cffi_f_Ppmd8_DecodeSymbol, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 33), (void *)_cffi_d_Ppmd8_DecodeSymbol },
+  { "Ppmd8_EncodeSymbol", (void *)_cffi_f_Ppmd8_EncodeSymbol, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 161), (void *)_cffi_d_Ppmd8_EncodeSymbol },
+  { "Ppmd8_Free", (void *)_cffi_f_Ppmd8_Free, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 157), (void *)_cffi_d_Ppmd8_Free },
+  { "Ppmd8_GetUsedMemory", (void *)_cffi_f_Ppmd8_GetUsedMemory, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 99), (void *)_cffi_d_Ppmd8_GetUsedMemory },
+  { "Ppmd8_Init", (void *)_cffi_f_Ppmd8_Init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 170), (void *)_cffi_d_Ppmd8_Init },
+  { "Ppmd8_RangeDec_Init", (void *)_cffi_f_Ppmd8_RangeDec_Init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 33), (void *)_cffi_d_Ppmd8_RangeDec_Init },
+  { "Ppmd8_RangeEnc_FlushData", (void *)_cffi_f_Ppmd8_RangeEnc_FlushData, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 144), (void *)_cffi_d_Ppmd8_RangeEnc_FlushData },
+  { "Ppmd8_RangeEnc_Init", (void *)_cffi_f_Ppmd8_RangeEnc_Init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 144), (void *)_cffi_d_Ppmd8_RangeEnc_Init },
+  { "PpmdFilter_EncodeEnd", (void *)_cffi_f_PpmdFilter_EncodeEnd, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 183), (void *)_cffi_d_PpmdFilter_EncodeEnd },
+  { "PpmdFilter_Free", (void *)_cffi_f_PpmdFilter_Free, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 186), (void *)_cffi_d_PpmdFilter_Free },
+  { "PpmdFilter_Init", (void *)_cffi_f_PpmdFilter_Init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 81), (void *)_cffi_d_PpmdFilter_Init },
+  { "Ppmd_GetCpuFeatures", (void *)_cffi_f_Ppmd_GetCpuFeatures, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_N, 105), (void *)_cffi_d_Ppmd_GetCpuFeatures },
+  { "Ppmd_KernelFeatures", (void *)_cffi_f_Ppmd_KernelFeatures, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 102), (void *)_cffi_d_Ppmd_KernelFeatures },
+  { "Ppmd_KernelName", (void *)_cffi_f_Ppmd_KernelName, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_N, 0), (void *)_cffi_d_Ppmd_KernelName },
+  { "Ppmd_SelectKernels", (void *)_cffi_f_Ppmd_SelectKernels, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 190), (void *)_cffi_d_Ppmd_SelectKernels },
+  { "Ppmd_thread_Reader", (void *)_cffi_f_Ppmd_thread_Reader, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 93), (void *)_cffi_d_Ppmd_thread_Reader },
+  { "Reader", (void *)_cffi_f_Reader, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 93), (void *)_cffi_d_Reader },
+  { "Writer", (void *)_cffi_f_Writer, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 200), (void *)_cffi_d_Writer },
+  { "ppmd7_compress", (void *)_cffi_f_ppmd7_compress, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 21), (void *)_cffi_d_ppmd7_compress },
+  { "ppmd7_compress_flush", (void *)_cffi_f_ppmd7_compress_flush, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 113), (void *)_cffi_d_ppmd7_compress_flush },
+  { "ppmd7_compress_init", (void *)_cffi_f_ppmd7_compress_init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 140), (void *)_cffi_d_ppmd7_compress_init },
+  { "ppmd7_decompress", (void *)_cffi_f_ppmd7_decompress, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 6), (void *)_cffi_d_ppmd7_decompress },
+  { "ppmd7_decompress_init", (void *)_cffi_f_ppmd7_decompress_init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 27), (void *)_cffi_d_ppmd7_decompress_init },
+  { "ppmd7_state_close", (void *)_cffi_f_ppmd7_state_close, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 118), (void *)_cffi_d_ppmd7_state_close },
+  { "ppmd7_state_init", (void *)_cffi_f_ppmd7_state_init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 131), (void *)_cffi_d_ppmd7_state_init },
+  { "ppmd8_compress", (void *)_cffi_f_ppmd8_compress, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 36), (void *)_cffi_d_ppmd8_compress },
+  { "ppmd8_compress_filtered", (void *)_cffi_f_ppmd8_compress_filtered, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 54), (void *)_cffi_d_ppmd8_compress_filtered },
+  { "ppmd8_compress_init", (void *)_cffi_f_ppmd8_compress_init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 153), (void *)_cffi_d_ppmd8_compress_init },
+  { "ppmd8_decompress", (void *)_cffi_f_ppmd8_decompress, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 41), (void *)_cffi_d_ppmd8_decompress },
+  { "ppmd8_decompress_filtered", (void *)_cffi_f_ppmd8_decompress_filtered, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 60), (void *)_cffi_d_ppmd8_decompress_filtered },
+  { "ppmd8_decompress_init", (void *)_cffi_f_ppmd8_decompress_init, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 147), (void *)_cffi_d_ppmd8_decompress_init },
+  { "raw_alloc", (void *)&_cffi_externpy__raw_alloc, _CFFI_OP(_CFFI_OP_EXTERN_PYTHON, 263), (void *)raw_alloc },
+  { "raw_free", (void *)&_cffi_externpy__raw_free, _CFFI_OP(_CFFI_OP_EXTERN_PYTHON, 265), (void *)raw_free },
+};
+
+static const struct _cffi_field_s _cffi_fields[] = {
+  { "Read", offsetof(BatchReader, Read),
+            sizeof(((BatchReader *)0)->Read),
+            _CFFI_OP(_CFFI_OP_NOOP, 243) },
+  { "inBuffer", offsetof(BatchReader, inBuffer),
+                sizeof(((BatchReader *)0)->inBuffer),
+                _CFFI_OP(_CFFI_OP_NOOP, 10) },
+  { "Read", offsetof(BufferReader, Read),
+            sizeof(((BufferReader *)0)->Read),
+            _CFFI_OP(_CFFI_OP_NOOP, 243) },
+  { "inBuffer", offsetof(BufferReader, inBuffer),
+                sizeof(((BufferReader *)0)->inBuffer),
+                _CFFI_OP(_CFFI_OP_NOOP, 10) },
+  { "t", offsetof(BufferReader, t),
+         sizeof(((BufferReader *)0)->t),
+         _CFFI_OP(_CFFI_OP_NOOP, 12) },
+  { "Write", offsetof(BufferWriter, Write),
+             sizeof(((BufferWriter *)0)->Write),
+             _CFFI_OP(_CFFI_OP_NOOP, 266) },
+  { "outBuffer", offsetof(BufferWriter, outBuffer),
+                 sizeof(((BufferWriter *)0)->outBuffer),
+                 _CFFI_OP(_CFFI_OP_NOOP, 9) },
+  { "t", offsetof(BufferWriter, t),
+         sizeof(((BufferWriter *)0)->t),
+         _CFFI_OP(_CFFI_OP_NOOP, 12) },
+  { "MinContext", offsetof(CPpmd7, MinContext),
+                  sizeof(((CPpmd7 *)0)->MinContext),
+                  _CFFI_OP(_CFFI_OP_NOOP, 208) },
+  { "MaxContext", offsetof(CPpmd7, MaxContext),
+                  sizeof(((CPpmd7 *)0)->MaxContext),
+                  _CFFI_OP(_CFFI_OP_NOOP, 208) },
+  { "FoundState", offsetof(CPpmd7, FoundState),
+                  sizeof(((CPpmd7 *)0)->FoundState),
+                  _CFFI_OP(_CFFI_OP_NOOP, 224) },
+  { "OrderFall", offsetof(CPpmd7, OrderFall),
+                 sizeof(((CPpmd7 *)0)->OrderFall),
+                 _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "InitEsc", offsetof(CPpmd7, InitEsc),
+               sizeof(((CPpmd7 *)0)->InitEsc),
+               _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "PrevSuccess", offsetof(CPpmd7, PrevSuccess),
+                   sizeof(((CPpmd7 *)0)->PrevSuccess),
+                   _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "MaxOrder", offsetof(CPpmd7, MaxOrder),
+                sizeof(((CPpmd7 *)0)->MaxOrder),
+                _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "HiBitsFlag", offsetof(CPpmd7, HiBitsFlag),
+                  sizeof(((CPpmd7 *)0)->HiBitsFlag),
+                  _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "RunLength", offsetof(CPpmd7, RunLength),
+                 sizeof(((CPpmd7 *)0)->RunLength),
+                 _CFFI_OP(_CFFI_OP_NOOP, 18) },
+  { "InitRL", offsetof(CPpmd7, InitRL),
+              sizeof(((CPpmd7 *)0)->InitRL),
+              _CFFI_OP(_CFFI_OP_NOOP, 18) },
+  { "Size", offsetof(CPpmd7, Size),
+            sizeof(((CPpmd7 *)0)->Size),
+            _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "GlueCount", offsetof(CPpmd7, GlueCount),
+                 sizeof(((CPpmd7 *)0)->GlueCount),
+                 _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Base", offsetof(CPpmd7, Base),
+            sizeof(((CPpmd7 *)0)->Base),
+            _CFFI_OP(_CFFI_OP_NOOP, 241) },
+  { "LoUnit", offsetof(CPpmd7, LoUnit),
+              sizeof(((CPpmd7 *)0)->LoUnit),
+              _CFFI_OP(_CFFI_OP_NOOP, 241) },
+  { "HiUnit", offsetof(CPpmd7, HiUnit),
+              sizeof(((CPpmd7 *)0)->HiUnit),
+              _CFFI_OP(_CFFI_OP_NOOP, 241) },
+  { "Text", offsetof(CPpmd7, Text),
+            sizeof(((CPpmd7 *)0)->Text),
+            _CFFI_OP(_CFFI_OP_NOOP, 241) },
+  { "UnitsStart", offsetof(CPpmd7, UnitsStart),
+                  sizeof(((CPpmd7 *)0)->UnitsStart),
+                  _CFFI_OP(_CFFI_OP_NOOP, 241) },
+  { "AlignOffset", offsetof(CPpmd7, AlignOffset),
+                   sizeof(((CPpmd7 *)0)->AlignOffset),
+                   _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Indx2Units", offsetof(CPpmd7, Indx2Units),
+                  sizeof(((CPpmd7 *)0)->Indx2Units),
+                  _CFFI_OP(_CFFI_OP_NOOP, 250) },
+  { "Units2Indx", offsetof(CPpmd7, Units2Indx),
+                  sizeof(((CPpmd7 *)0)->Units2Indx),
+                  _CFFI_OP(_CFFI_OP_NOOP, 244) },
+  { "FreeList", offsetof(CPpmd7, FreeList),
+                sizeof(((CPpmd7 *)0)->FreeList),
+                _CFFI_OP(_CFFI_OP_NOOP, 252) },
+  { "NS2Indx", offsetof(CPpmd7, NS2Indx),
+               sizeof(((CPpmd7 *)0)->NS2Indx),
+               _CFFI_OP(_CFFI_OP_NOOP, 246) },
+  { "NS2BSIndx", offsetof(CPpmd7, NS2BSIndx),
+                 sizeof(((CPpmd7 *)0)->NS2BSIndx),
+                 _CFFI_OP(_CFFI_OP_NOOP, 246) },
+  { "HB2Flag", offsetof(CPpmd7, HB2Flag),
+               sizeof(((CPpmd7 *)0)->HB2Flag),
+               _CFFI_OP(_CFFI_OP_NOOP, 246) },
+  { "DummySee", offsetof(CPpmd7, DummySee),
+                sizeof(((CPpmd7 *)0)->DummySee),
+                _CFFI_OP(_CFFI_OP_NOOP, 215) },
+  { "See", offsetof(CPpmd7, See),
+           sizeof(((CPpmd7 *)0)->See),
+           _CFFI_OP(_CFFI_OP_NOOP, 220) },
+  { "BinSumm", offsetof(CPpmd7, BinSumm),
+               sizeof(((CPpmd7 *)0)->BinSumm),
+               _CFFI_OP(_CFFI_OP_NOOP, 257) },
+  { "Stats", offsetof(CPpmd7, Stats),
+             sizeof(((CPpmd7 *)0)->Stats),
+             _CFFI_OP(_CFFI_OP_NOOP, 226) },
+  { "Range", offsetof(CPpmd7z_RangeDec, Range),
+             sizeof(((CPpmd7z_RangeDec *)0)->Range),
+             _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Code", offsetof(CPpmd7z_RangeDec, Code),
+            sizeof(((CPpmd7z_RangeDec *)0)->Code),
+            _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Stream", offsetof(CPpmd7z_RangeDec, Stream),
+              sizeof(((CPpmd7z_RangeDec *)0)->Stream),
+              _CFFI_OP(_CFFI_OP_NOOP, 228) },
+  { "Low", offsetof(CPpmd7z_RangeEnc, Low),
+           sizeof(((CPpmd7z_RangeEnc *)0)->Low),
+           _CFFI_OP(_CFFI_OP_NOOP, 254) },
+  { "Range", offsetof(CPpmd7z_RangeEnc, Range),
+             sizeof(((CPpmd7z_RangeEnc *)0)->Range),
+             _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Cache", offsetof(CPpmd7z_RangeEnc, Cache),
+             sizeof(((CPpmd7z_RangeEnc *)0)->Cache),
+             _CFFI_OP(_CFFI_OP_NOOP, 177) },
+  { "CacheSize", offsetof(CPpmd7z_RangeEnc, CacheSize),
+                 sizeof(((CPpmd7z_RangeEnc *)0)->CacheSize),
+                 _CFFI_OP(_CFFI_OP_NOOP, 254) },
+  { "Stream", offsetof(CPpmd7z_RangeEnc, Stream),
+              sizeof(((CPpmd7z_RangeEnc *)0)->Stream),
+              _CFFI_OP(_CFFI_OP_NOOP, 230) },
+  { "MinContext", offsetof(CPpmd8, MinContext),
+                  sizeof(((CPpmd8 *)0)->MinContext),
+                  _CFFI_OP(_CFFI_OP_NOOP, 213) },
+  { "MaxContext", offsetof(CPpmd8, MaxContext),
+                  sizeof(((CPpmd8 *)0)->MaxContext),
+                  _CFFI_OP(_CFFI_OP_NOOP, 213) },
+  { "FoundState", offsetof(CPpmd8, FoundState),
+                  sizeof(((CPpmd8 *)0)->FoundState),
+                  _CFFI_OP(_CFFI_OP_NOOP, 224) },
+  { "OrderFall", offsetof(CPpmd8, OrderFall),
+                 sizeof(((CPpmd8 *)0)->OrderFall),
+                 _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "InitEsc", offsetof(CPpmd8, InitEsc),
+               sizeof(((CPpmd8 *)0)->InitEsc),
+               _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "PrevSuccess", offsetof(CPpmd8, PrevSuccess),
+                   sizeof(((CPpmd8 *)0)->PrevSuccess),
+                   _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "MaxOrder", offsetof(CPpmd8, MaxOrder),
+                sizeof(((CPpmd8 *)0)->MaxOrder),
+                _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "RunLength", offsetof(CPpmd8, RunLength),
+                 sizeof(((CPpmd8 *)0)->RunLength),
+                 _CFFI_OP(_CFFI_OP_NOOP, 18) },
+  { "InitRL", offsetof(CPpmd8, InitRL),
+              sizeof(((CPpmd8 *)0)->InitRL),
+              _CFFI_OP(_CFFI_OP_NOOP, 18) },
+  { "Size", offsetof(CPpmd8, Size),
+            sizeof(((CPpmd8 *)0)->Size),
+            _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "GlueCount", offsetof(CPpmd8, GlueCount),
+                 sizeof(((CPpmd8 *)0)->GlueCount),
+                 _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Base", offsetof(CPpmd8, Base),
+            sizeof(((CPpmd8 *)0)->Base),
+            _CFFI_OP(_CFFI_OP_NOOP, 241) },
+  { "LoUnit", offsetof(CPpmd8, LoUnit),
+              sizeof(((CPpmd8 *)0)->LoUnit),
+              _CFFI_OP(_CFFI_OP_NOOP, 241) },
+  { "HiUnit", offsetof(CPpmd8, HiUnit),
+              sizeof(((CPpmd8 *)0)->HiUnit),
+              _CFFI_OP(_CFFI_OP_NOOP, 241) },
+  { "Text", offsetof(CPpmd8, Text),
+            sizeof(((CPpmd8 *)0)->Text),
+            _CFFI_OP(_CFFI_OP_NOOP, 241) },
+  { "UnitsStart", offsetof(CPpmd8, UnitsStart),
+                  sizeof(((CPpmd8 *)0)->UnitsStart),
+                  _CFFI_OP(_CFFI_OP_NOOP, 241) },
+  { "AlignOffset", offsetof(CPpmd8, AlignOffset),
+                   sizeof(((CPpmd8 *)0)->AlignOffset),
+                   _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "RestoreMethod", offsetof(CPpmd8, RestoreMethod),
+                     sizeof(((CPpmd8 *)0)->RestoreMethod),
+                     _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Range", offsetof(CPpmd8, Range),
+             sizeof(((CPpmd8 *)0)->Range),
+             _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Code", offsetof(CPpmd8, Code),
+            sizeof(((CPpmd8 *)0)->Code),
+            _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Low", offsetof(CPpmd8, Low),
+           sizeof(((CPpmd8 *)0)->Low),
+           _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Stream", offsetof(CPpmd8, Stream),
+              sizeof(((CPpmd8 *)0)->Stream),
+              _CFFI_OP(_CFFI_OP_NOOP, 240) },
+  { "Indx2Units", offsetof(CPpmd8, Indx2Units),
+                  sizeof(((CPpmd8 *)0)->Indx2Units),
+                  _CFFI_OP(_CFFI_OP_NOOP, 250) },
+  { "Units2Indx", offsetof(CPpmd8, Units2Indx),
+                  sizeof(((CPpmd8 *)0)->Units2Indx),
+                  _CFFI_OP(_CFFI_OP_NOOP, 244) },
+  { "FreeList", offsetof(CPpmd8, FreeList),
+                sizeof(((CPpmd8 *)0)->FreeList),
+                _CFFI_OP(_CFFI_OP_NOOP, 252) },
+  { "Stamps", offsetof(CPpmd8, Stamps),
+              sizeof(((CPpmd8 *)0)->Stamps),
+              _CFFI_OP(_CFFI_OP_NOOP, 252) },
+  { "NS2BSIndx", offsetof(CPpmd8, NS2BSIndx),
+                 sizeof(((CPpmd8 *)0)->NS2BSIndx),
+                 _CFFI_OP(_CFFI_OP_NOOP, 246) },
+  { "NS2Indx", offsetof(CPpmd8, NS2Indx),
+               sizeof(((CPpmd8 *)0)->NS2Indx),
+               _CFFI_OP(_CFFI_OP_NOOP, 248) },
+  { "DummySee", offsetof(CPpmd8, DummySee),
+                sizeof(((CPpmd8 *)0)->DummySee),
+                _CFFI_OP(_CFFI_OP_NOOP, 215) },
+  { "See", offsetof(CPpmd8, See),
+           sizeof(((CPpmd8 *)0)->See),
+           _CFFI_OP(_CFFI_OP_NOOP, 218) },
+  { "BinSumm", offsetof(CPpmd8, BinSumm),
+               sizeof(((CPpmd8 *)0)->BinSumm),
+               _CFFI_OP(_CFFI_OP_NOOP, 259) },
+  { "Stats", offsetof(CPpmd8, Stats),
+             sizeof(((CPpmd8 *)0)->Stats),
+             _CFFI_OP(_CFFI_OP_NOOP, 226) },
+  { "Summ", offsetof(CPpmd_See, Summ),
+            sizeof(((CPpmd_See *)0)->Summ),
+            _CFFI_OP(_CFFI_OP_NOOP, 256) },
+  { "Shift", offsetof(CPpmd_See, Shift),
+             sizeof(((CPpmd_See *)0)->Shift),
+             _CFFI_OP(_CFFI_OP_NOOP, 177) },
+  { "Count", offsetof(CPpmd_See, Count),
+             sizeof(((CPpmd_See *)0)->Count),
+             _CFFI_OP(_CFFI_OP_NOOP, 177) },
+  { "Symbol", offsetof(CPpmd_State, Symbol),
+              sizeof(((CPpmd_State *)0)->Symbol),
+              _CFFI_OP(_CFFI_OP_NOOP, 177) },
+  { "Freq", offsetof(CPpmd_State, Freq),
+            sizeof(((CPpmd_State *)0)->Freq),
+            _CFFI_OP(_CFFI_OP_NOOP, 177) },
+  { "SuccessorLow", offsetof(CPpmd_State, SuccessorLow),
+                    sizeof(((CPpmd_State *)0)->SuccessorLow),
+                    _CFFI_OP(_CFFI_OP_NOOP, 256) },
+  { "SuccessorHigh", offsetof(CPpmd_State, SuccessorHigh),
+                     sizeof(((CPpmd_State *)0)->SuccessorHigh),
+                     _CFFI_OP(_CFFI_OP_NOOP, 256) },
+  { "Restarts", offsetof(CPpmd_Stats, Restarts),
+                sizeof(((CPpmd_Stats *)0)->Restarts),
+                _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "CutOffs", offsetof(CPpmd_Stats, CutOffs),
+               sizeof(((CPpmd_Stats *)0)->CutOffs),
+               _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Glues", offsetof(CPpmd_Stats, Glues),
+             sizeof(((CPpmd_Stats *)0)->Glues),
+             _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Rescales", offsetof(CPpmd_Stats, Rescales),
+                sizeof(((CPpmd_Stats *)0)->Rescales),
+                _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "PeakUsed", offsetof(CPpmd_Stats, PeakUsed),
+                sizeof(((CPpmd_Stats *)0)->PeakUsed),
+                _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "cPpmd8", offsetof(Ppmd8BatchStream, cPpmd8),
+              sizeof(((Ppmd8BatchStream *)0)->cPpmd8),
+              _CFFI_OP(_CFFI_OP_NOOP, 34) },
+  { "reader", offsetof(Ppmd8BatchStream, reader),
+              sizeof(((Ppmd8BatchStream *)0)->reader),
+              _CFFI_OP(_CFFI_OP_NOOP, 204) },
+  { "in", offsetof(Ppmd8BatchStream, in),
+          sizeof(((Ppmd8BatchStream *)0)->in),
+          _CFFI_OP(_CFFI_OP_NOOP, 232) },
+  { "out", offsetof(Ppmd8BatchStream, out),
+           sizeof(((Ppmd8BatchStream *)0)->out),
+           _CFFI_OP(_CFFI_OP_NOOP, 233) },
+  { "result", offsetof(Ppmd8BatchStream, result),
+              sizeof(((Ppmd8BatchStream *)0)->result),
+              _CFFI_OP(_CFFI_OP_NOOP, 18) },
+  { "kind", offsetof(PpmdFilter, kind),
+            sizeof(((PpmdFilter *)0)->kind),
+            _CFFI_OP(_CFFI_OP_NOOP, 18) },
+  { "param", offsetof(PpmdFilter, param),
+             sizeof(((PpmdFilter *)0)->param),
+             _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "buf", offsetof(PpmdFilter, buf),
+           sizeof(((PpmdFilter *)0)->buf),
+           _CFFI_OP(_CFFI_OP_NOOP, 241) },
+  { "NumStats", offsetof(CPpmd7_Context, NumStats),
+                sizeof(((CPpmd7_Context *)0)->NumStats),
+                _CFFI_OP(_CFFI_OP_NOOP, 256) },
+  { "SummFreq", offsetof(CPpmd7_Context, SummFreq),
+                sizeof(((CPpmd7_Context *)0)->SummFreq),
+                _CFFI_OP(_CFFI_OP_NOOP, 256) },
+  { "Stats", offsetof(CPpmd7_Context, Stats),
+             sizeof(((CPpmd7_Context *)0)->Stats),
+             _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Suffix", offsetof(CPpmd7_Context, Suffix),
+              sizeof(((CPpmd7_Context *)0)->Suffix),
+              _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "NumStats", offsetof(CPpmd8_Context, NumStats),
+                sizeof(((CPpmd8_Context *)0)->NumStats),
+                _CFFI_OP(_CFFI_OP_NOOP, 177) },
+  { "Flags", offsetof(CPpmd8_Context, Flags),
+             sizeof(((CPpmd8_Context *)0)->Flags),
+             _CFFI_OP(_CFFI_OP_NOOP, 177) },
+  { "SummFreq", offsetof(CPpmd8_Context, SummFreq),
+                sizeof(((CPpmd8_Context *)0)->SummFreq),
+                _CFFI_OP(_CFFI_OP_NOOP, 256) },
+  { "Stats", offsetof(CPpmd8_Context, Stats),
+             sizeof(((CPpmd8_Context *)0)->Stats),
+             _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Suffix", offsetof(CPpmd8_Context, Suffix),
+              sizeof(((CPpmd8_Context *)0)->Suffix),
+              _CFFI_OP(_CFFI_OP_NOOP, 72) },
+  { "Alloc", offsetof(IAlloc, Alloc),
+             sizeof(((IAlloc *)0)->Alloc),
+             _CFFI_OP(_CFFI_OP_NOOP, 263) },
+  { "Free", offsetof(IAlloc, Free),
+            sizeof(((IAlloc *)0)->Free),
+            _CFFI_OP(_CFFI_OP_NOOP, 265) },
+  { "Read", offsetof(IByteIn, Read),
+            sizeof(((IByteIn *)0)->Read),
+            _CFFI_OP(_CFFI_OP_NOOP, 242) },
+  { "Write", offsetof(IByteOut, Write),
+             sizeof(((IByteOut *)0)->Write),
+             _CFFI_OP(_CFFI_OP_NOOP, 264) },
+  { "src", offsetof(InBuffer, src),
+           sizeof(((InBuffer *)0)->src),
+           _CFFI_OP(_CFFI_OP_NOOP, 78) },
+  { "size", offsetof(InBuffer, size),
+            sizeof(((InBuffer *)0)->size),
+            _CFFI_OP(_CFFI_OP_NOOP, 11) },
+  { "pos", offsetof(InBuffer, pos),
+           sizeof(((InBuffer *)0)->pos),
+           _CFFI_OP(_CFFI_OP_NOOP, 11) },
+  { "dst", offsetof(OutBuffer, dst),
+           sizeof(((OutBuffer *)0)->dst),
+           _CFFI_OP(_CFFI_OP_NOOP, 91) },
+  { "size", offsetof(OutBuffer, size),
+            sizeof(((OutBuffer *)0)->size),
+            _CFFI_OP(_CFFI_OP_NOOP, 11) },
+  { "pos", offsetof(OutBuffer, pos),
+           sizeof(((OutBuffer *)0)->pos),
+           _CFFI_OP(_CFFI_OP_NOOP, 11) },
+  { "cPpmd", offsetof(ppmd_info, cPpmd),
+             sizeof(((ppmd_info *)0)->cPpmd),
+             _CFFI_OP(_CFFI_OP_NOOP, 91) },
+  { "rc", offsetof(ppmd_info, rc),
+          sizeof(((ppmd_info *)0)->rc),
+          _CFFI_OP(_CFFI_OP_NOOP, 91) },
+  { "in", offsetof(ppmd_info, in),
+          sizeof(((ppmd_info *)0)->in),
+          _CFFI_OP(_CFFI_OP_NOOP, 10) },
+  { "out", offsetof(ppmd_info, out),
+           sizeof(((ppmd_info *)0)->out),
+           _CFFI_OP(_CFFI_OP_NOOP, 9) },
+  { "max_length", offsetof(ppmd_info, max_length),
+                  sizeof(((ppmd_info *)0)->max_length),
+                  _CFFI_OP(_CFFI_OP_NOOP, 18) },
+  { "result", offsetof(ppmd_info, result),
+              sizeof(((ppmd_info *)0)->result),
+              _CFFI_OP(_CFFI_OP_NOOP, 18) },
+  { "t", offsetof(ppmd_info, t),
+         sizeof(((ppmd_info *)0)->t),
+         _CFFI_OP(_CFFI_OP_NOOP, 91) },
+  { "In", (size_t)-1,
+          (size_t)-1,
+          _CFFI_OP(_CFFI_OP_NOOP, 228) },
+  { "Out", (size_t)-1,
+           (size_t)-1,
+           _CFFI_OP(_CFFI_OP_NOOP, 230) },
+};
+
+static const struct _cffi_struct_union_s _cffi_struct_unions[] = {
+  { "$1", 240, _CFFI_F_UNION|_CFFI_F_CHECK_FIELDS,
+    (size_t)-2, -2, 122, 2 /* unnamed */ },
+  { "$BatchReader", 204, 0,
+    sizeof(BatchReader), offsetof(struct _cffi_align_typedef_BatchReader, y), 0, 2 },
+  { "$BufferReader", 205, _CFFI_F_CHECK_FIELDS,
+    sizeof(BufferReader), offsetof(struct _cffi_align_typedef_BufferReader, y), 2, 3 },
+  { "$BufferWriter", 206, _CFFI_F_CHECK_FIELDS,
+    sizeof(BufferWriter), offsetof(struct _cffi_align_typedef_BufferWriter, y), 5, 3 },
+  { "$CPpmd7", 207, 0,
+    sizeof(CPpmd7), offsetof(struct _cffi_align_typedef_CPpmd7, y), 8, 28 },
+  { "$CPpmd7z_RangeDec", 210, 0,
+    sizeof(CPpmd7z_RangeDec), offsetof(struct _cffi_align_typedef_CPpmd7z_RangeDec, y), 36, 3 },
+  { "$CPpmd7z_RangeEnc", 211, 0,
+    sizeof(CPpmd7z_RangeEnc), offsetof(struct _cffi_align_typedef_CPpmd7z_RangeEnc, y), 39, 5 },
+  { "$CPpmd8", 212, 0,
+    sizeof(CPpmd8), offsetof(struct _cffi_align_typedef_CPpmd8, y), 44, 32 },
+  { "$CPpmd_See", 215, 0,
+    sizeof(CPpmd_See), offsetof(struct _cffi_align_typedef_CPpmd_See, y), 76, 3 },
+  { "$CPpmd_State", 225, _CFFI_F_CHECK_FIELDS,
+    sizeof(CPpmd_State), offsetof(struct _cffi_align_typedef_CPpmd_State, y), 79, 4 },
+  { "$CPpmd_Stats", 226, _CFFI_F_CHECK_FIELDS,
+    sizeof(CPpmd_Stats), offsetof(struct _cffi_align_typedef_CPpmd_Stats, y), 83, 5 },
+  { "$Ppmd8BatchStream", 234, 0,
+    sizeof(Ppmd8BatchStream), offsetof(struct _cffi_align_typedef_Ppmd8BatchStream, y), 88, 5 },
+  { "$PpmdFilter", 235, 0,
+    sizeof(PpmdFilter), offsetof(struct _cffi_align_typedef_PpmdFilter, y), 93, 3 },
+  { "CPpmd7_Context_", 209, _CFFI_F_CHECK_FIELDS,
+    sizeof(CPpmd7_Context), offsetof(struct _cffi_align__CPpmd7_Context, y), 96, 4 },
+  { "CPpmd8_Context_", 214, _CFFI_F_CHECK_FIELDS,
+    sizeof(CPpmd8_Context), offsetof(struct _cffi_align__CPpmd8_Context, y), 100, 5 },
+  { "IAlloc", 227, _CFFI_F_CHECK_FIELDS,
+    sizeof(IAlloc), offsetof(struct _cffi_align__IAlloc, y), 105, 2 },
+  { "IByteIn", 229, _CFFI_F_CHECK_FIELDS,
+    sizeof(IByteIn), offsetof(struct _cffi_align__IByteIn, y), 107, 1 },
+  { "IByteOut", 231, _CFFI_F_CHECK_FIELDS,
+    sizeof(IByteOut), offsetof(struct _cffi_align__IByteOut, y), 108, 1 },
+  { "InBuffer_s", 232, _CFFI_F_CHECK_FIELDS,
+    sizeof(InBuffer), offsetof(struct _cffi_align__InBuffer, y), 109, 3 },
+  { "OutBuffer_s", 233, _CFFI_F_CHECK_FIELDS,
+    sizeof(OutBuffer), offsetof(struct _cffi_align__OutBuffer, y), 112, 3 },
+  { "ppmd_info_s", 238, _CFFI_F_CHECK_FIELDS,
+    sizeof(ppmd_info), offsetof(struct _cffi_align__ppmd_info, y), 115, 7 },
+};
+
+static const struct _cffi_typename_s _cffi_typenames[] = {
+  { "BatchReader", 204 },
+  { "Bool", 18 },
+  { "BufferReader", 205 },
+  { "BufferWriter", 206 },
+  { "Byte", 177 },
+  { "CPpmd7", 207 },
+  { "CPpmd7_Context", 209 },
+  { "CPpmd7_Context_Ref", 72 },
+  { "CPpmd7z_RangeDec", 210 },
+  { "CPpmd7z_RangeEnc", 211 },
+  { "CPpmd8", 212 },
+  { "CPpmd8_Context", 214 },
+  { "CPpmd8_Context_Ref", 72 },
+  { "CPpmd_See", 215 },
+  { "CPpmd_State", 225 },
+  { "CPpmd_State_Ref", 72 },
+  { "CPpmd_Stats", 226 },
+  { "CPpmd_Void_Ref", 72 },
+  { "IAlloc", 227 },
+  { "IByteIn", 229 },
+  { "IByteOut", 231 },
+  { "InBuffer", 232 },
+  { "Int16", 239 },
+  { "Int32", 18 },
+  { "Int64", 237 },
+  { "OutBuffer", 233 },
+  { "Ppmd8BatchStream", 234 },
+  { "PpmdFilter", 235 },
+  { "UInt16", 256 },
+  { "UInt32", 72 },
+  { "UInt64", 254 },
+  { "ppmd_info", 238 },
+  { "pthread_t", 255 },
+};
+
+static const struct _cffi_type_context_s _cffi_type_context = {
+  _cffi_types,
+  _cffi_globals,
+  _cffi_fields,
+  _cffi_struct_unions,
+  NULL,  /* no enums */
+  _cffi_typenames,
+  60,  /* num_globals */
+  21,  /* num_struct_unions */
+  0,  /* num_enums */
+  33,  /* num_typenames */
+  NULL,  /* no includes */
+  268,  /* num_types */
+  1,  /* flags */
+};
+
+#ifdef __GNUC__
+#  pragma GCC visibility push(default)  /* for -fvisibility= */
+#endif
+
+#ifdef PYPY_VERSION
+PyMODINIT_FUNC
+_cffi_pypyinit__cffi_ppmd(const void *p[])
+{
+    if (((intptr_t)p[0]) >= 0x0A03) {
+        _cffi_call_python_org = (void(*)(struct _cffi_externpy_s *, char *))p[1];
+    }
+    p[0] = (const void *)0x2601;
+    p[1] = &_cffi_type_context;
+    return NULL;
+}
+#  ifdef _MSC_VER
+     PyMODINIT_FUNC
+     PyInit__cffi_ppmd(void) { return NULL; }
+#  endif
+#else
+PyMODINIT_FUNC
+PyInit__cffi_ppmd(void)
+{
+  return _cffi_init("pyppmd.cffi._cffi_ppmd", 0x2601, &_cffi_type_context);
+}
+#endif
+
+#ifdef __GNUC__
+#  pragma GCC visibility pop
+#endif
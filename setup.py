@@ -20,8 +20,12 @@ kwargs = {
             "src/lib/ppmd/Ppmd7Enc.c",
             "src/lib/ppmd/Ppmd8Enc.c",
             "src/lib/ppmd/Ppmd7Dec.c",
+            "src/lib/ppmd/PpmdMask.c",
+            "src/lib/ppmd/CpuArch.c",
             "src/lib/buffer/Buffer.c",
             "src/lib/buffer/ThreadDecoder.c",
+            "src/lib/buffer/BatchDecoder.c",
+            "src/lib/buffer/Filter.c",
         ],
     "define_macros": [],
 }
@@ -35,6 +39,14 @@ def has_option(option):
         return False
 
 
+# prefetch successor and suffix contexts in the decoders
+if has_option("--prefetch"):
+    kwargs["define_macros"].append(("PPMD_USE_PREFETCH", None))
+
+# divide by frequency totals through cached reciprocals in the range coders
+if has_option("--reciprocal"):
+    kwargs["define_macros"].append(("PPMD_USE_RECIPROCAL", None))
+
 if has_option("--cffi") or platform.python_implementation() == "PyPy":
     # packages
     packages = ["pyppmd", "pyppmd.cffi"]
@@ -58,6 +70,17 @@ else:  # C implementation
 
 
 WARNING_AS_ERROR = has_option("--warning-as-error")
+# link time optimization, lets the compiler inline the model updates into the coders
+LTO = has_option("--lto")
+# profile guided optimization; utils/pgo_build.py drives the instrumented build,
+# the training run and the optimized rebuild
+PGO_GENERATE = has_option("--pgo-generate")
+PGO_USE = has_option("--pgo-use")
+PGO_PROFILE_DIR = os.path.abspath(os.environ.get("PPMD_PGO_DIR", os.path.join("build", "pgo")))
+
+
+def is_clang(compiler) -> bool:
+    return "clang" in os.path.basename(compiler.compiler[0])
 
 
 class build_ext_compiler_check(build_ext):
@@ -71,12 +94,31 @@ class build_ext_compiler_check(build_ext):
                 extension.extra_link_args.append("-pthread")
                 if WARNING_AS_ERROR:
                     extension.extra_compile_args.append("-Werror")
+                flags = []
+                if LTO:
+                    flags.append("-flto")
+                if PGO_GENERATE:
+                    flags.append("-fprofile-generate=" + PGO_PROFILE_DIR)
+                    if not is_clang(self.compiler):
+                        # the threaded decoder updates counters from several threads
+                        flags.append("-fprofile-update=prefer-atomic")
+                elif PGO_USE and is_clang(self.compiler):
+                    flags.append("-fprofile-use=" + os.path.join(PGO_PROFILE_DIR, "default.profdata"))
+                elif PGO_USE:
+                    flags.extend(["-fprofile-use=" + PGO_PROFILE_DIR, "-fprofile-correction", "-Wno-missing-profile"])
+                extension.extra_compile_args.extend(flags)
+                extension.extra_link_args.extend(flags)
             elif self.compiler.compiler_type.lower() == "msvc":
                 # /GF eliminates duplicate strings
                 # /Gy does function level linking
                 more_options = ["/GF", "/Gy"]
                 if WARNING_AS_ERROR:
                     more_options.append("/WX")
+                if LTO:
+                    more_options.append("/GL")
+                    extension.extra_link_args.append("/LTCG")
+                if PGO_GENERATE or PGO_USE:
+                    raise RuntimeError("Profile guided builds are supported with GCC and Clang only.")
                 extension.extra_compile_args.extend(more_options)
         super().build_extensions()
 
@@ -0,0 +1,635 @@
+//
+// ppmd.c -- command line compressor on top of libppmd
+//
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#include "win_pthreads.h"
+#else
+#include <pthread.h>
+#endif
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <windows.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "libppmd.h"
+
+/*
+  Blocked files start with a 16 byte header
+
+    "PPMB", version 1, flags, variant (7 or 8), max order, restore method,
+    2 reserved bytes, mem size (40-bit little endian)
+
+  Flag BLOCKED_FLAG_WIDE_REF marks the output of a PPMD_WIDE_REF build, which
+  other builds cannot decode; without it the mem size takes 32 bits.
+
+  followed by blocks of
+
+    uncompressed size, compressed size (32-bit little endian), data
+
+  and a final uncompressed size of 0. Every block is an independent stream
+  without end marker, so blocks are compressed and decompressed in parallel.
+*/
+#define BLOCKED_MAGIC "PPMB"
+#define BLOCKED_VERSION 1
+#define BLOCKED_HEADER_SIZE 16
+#define BLOCKED_FLAG_WIDE_REF 0x01
+#define MAX_BLOCK_SIZE (1UL << 30)
+#define MAX_THREADS 256
+#define STREAM_CHUNK (1 << 16)
+
+typedef struct {
+    ppmd_params params;
+    size_t block_size;
+    unsigned threads;
+    int decompress;
+    int raw;
+    int benchmark;
+    const char *input;
+    const char *output;
+} options;
+
+typedef struct {
+    const ppmd_params *params;
+    unsigned char *src;
+    size_t src_size;
+    unsigned char *dst;
+    size_t dst_size;
+    size_t dst_capacity;
+    int result;
+} block_job;
+
+static void usage(FILE *f)
+{
+    fputs("usage: ppmd [options] [input [output]]\n"
+          "Compress or decompress input (default stdin) to output (default stdout).\n"
+          "\n"
+          "  -d            decompress\n"
+          "  -H, -I        PPMd variant H (7-Zip) or I (default)\n"
+          "  -o ORDER      model order, 2..64 for H, 2..16 for I (default 6)\n"
+          "  -m SIZE       model memory per thread, up to 4G, or 1T for a wide-ref build (default 16M)\n"
+          "  -r METHOD     variant I restore method, 0=restart, 1=cutoff, 4=replay (default 0)\n"
+          "  -t N          threads, 0 for one per CPU (default 1)\n"
+          "  -b SIZE       block size (default 8M)\n"
+          "  --raw         single stream with end marker, as written by pyppmd\n"
+          "  --benchmark   compress and decompress input in memory and report speed\n"
+          "  -h, --help    show this help\n"
+          "\n"
+          "SIZE takes K, M and G suffixes. Without --raw, input is split into blocks\n"
+          "compressed independently by the threads.\n",
+          f);
+}
+
+static int parse_size(const char *arg, unsigned long max, unsigned long *value)
+{
+    char *end;
+    unsigned long long v;
+    errno = 0;
+    v = strtoull(arg, &end, 10);
+    if (errno != 0 || end == arg)
+        return 0;
+    switch (*end) {
+    case 'K': case 'k': v <<= 10; end++; break;
+    case 'M': case 'm': v <<= 20; end++; break;
+    case 'G': case 'g': v <<= 30; end++; break;
+    default: break;
+    }
+    if (*end != '\0' || v > max)
+        return 0;
+    *value = (unsigned long)v;
+    return 1;
+}
+
+/* beyond 4 GiB needs 64-bit references and a 64-bit unsigned long */
+static unsigned long max_mem_size(void)
+{
+    if (ppmd_format() == PPMD_FORMAT_WIDE_REF && sizeof(unsigned long) > 4)
+        return (unsigned long)((unsigned long long)1 << 40);
+    return 0xFFFFFFFFUL;
+}
+
+static unsigned cpu_count(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (unsigned)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (unsigned)n : 1;
+#endif
+}
+
+static double now(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+static int parse_args(int argc, char **argv, options *opt)
+{
+    int i, positional = 0;
+    unsigned long value;
+    ppmd_params_default(&opt->params, PPMD_VARIANT_I);
+    opt->block_size = 8 << 20;
+    opt->threads = 1;
+    for (i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        const char *next = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(a, "-h") == 0 || strcmp(a, "--help") == 0) {
+            usage(stdout);
+            exit(0);
+        } else if (strcmp(a, "-d") == 0) {
+            opt->decompress = 1;
+        } else if (strcmp(a, "-H") == 0) {
+            opt->params.variant = PPMD_VARIANT_H;
+        } else if (strcmp(a, "-I") == 0) {
+            opt->params.variant = PPMD_VARIANT_I;
+        } else if (strcmp(a, "--raw") == 0) {
+            opt->raw = 1;
+        } else if (strcmp(a, "--benchmark") == 0) {
+            opt->benchmark = 1;
+        } else if (strcmp(a, "-o") == 0 && next != NULL && parse_size(next, 64, &value)) {
+            opt->params.max_order = (unsigned)value;
+            i++;
+        } else if (strcmp(a, "-m") == 0 && next != NULL && parse_size(next, max_mem_size(), &value)) {
+            opt->params.mem_size = value;
+            i++;
+        } else if (strcmp(a, "-r") == 0 && next != NULL && parse_size(next, PPMD_RESTORE_METHOD_REPLAY, &value)
+                   && (value <= PPMD_RESTORE_METHOD_CUTOFF || value == PPMD_RESTORE_METHOD_REPLAY)) {
+            opt->params.restore_method = (unsigned)value;
+            i++;
+        } else if (strcmp(a, "-t") == 0 && next != NULL && parse_size(next, MAX_THREADS, &value)) {
+            opt->threads = (unsigned)value;
+            i++;
+        } else if (strcmp(a, "-b") == 0 && next != NULL && parse_size(next, MAX_BLOCK_SIZE, &value) && value > 0) {
+            opt->block_size = value;
+            i++;
+        } else if (a[0] != '-' || strcmp(a, "-") == 0) {
+            if (positional == 0)
+                opt->input = a;
+            else if (positional == 1)
+                opt->output = a;
+            else
+                return 0;
+            positional++;
+        } else {
+            return 0;
+        }
+    }
+    if (opt->threads == 0)
+        opt->threads = cpu_count() < MAX_THREADS ? cpu_count() : MAX_THREADS;
+    return 1;
+}
+
+static void put_u32(unsigned char *p, unsigned long v)
+{
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static unsigned long get_u32(const unsigned char *p)
+{
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8) | ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
+
+static int ensure_capacity(block_job *job, size_t needed)
+{
+    unsigned char *dst;
+    size_t capacity = job->dst_capacity ? job->dst_capacity : 4096;
+    if (needed <= job->dst_capacity)
+        return 1;
+    while (capacity < needed)
+        capacity *= 2;
+    dst = (unsigned char *)realloc(job->dst, capacity);
+    if (dst == NULL)
+        return 0;
+    job->dst = dst;
+    job->dst_capacity = capacity;
+    return 1;
+}
+
+/* Compresses src into dst, growing dst as needed. */
+static void *compress_block(void *arg)
+{
+    block_job *job = (block_job *)arg;
+    ppmd_stream *enc = ppmd_encoder_create(job->params);
+    ppmd_buffer in = {job->src, job->src_size, 0};
+    int ret, flushing = 0;
+    job->dst_size = 0;
+    job->result = PPMD_ERROR_MEMORY;
+    if (enc == NULL || !ensure_capacity(job, job->src_size / 2 + 64))
+        goto done;
+    for (;;) {
+        ppmd_buffer out = {job->dst + job->dst_size, job->dst_capacity - job->dst_size, 0};
+        if (in.pos < in.size) {
+            ret = ppmd_encode_chunk(enc, &in, &out);
+        } else {
+            ret = ppmd_flush(enc, &out);
+            flushing = 1;
+        }
+        job->dst_size += out.pos;
+        if (ret < 0)
+            goto done;
+        if (flushing && ret == PPMD_OK)
+            break;
+        if (job->dst_size == job->dst_capacity && !ensure_capacity(job, job->dst_capacity * 2))
+            goto done;
+    }
+    job->result = PPMD_OK;
+done:
+    ppmd_free(enc);
+    return NULL;
+}
+
+/* Decompresses src into dst, whose size is known from the block header. */
+static void *decompress_block(void *arg)
+{
+    block_job *job = (block_job *)arg;
+    ppmd_stream *dec = ppmd_decoder_create(job->params);
+    ppmd_buffer in = {job->src, job->src_size, 0};
+    ppmd_buffer out = {job->dst, job->dst_size, 0};
+    job->result = PPMD_ERROR_MEMORY;
+    if (dec != NULL) {
+        job->result = ppmd_decode_chunk(dec, &in, &out, 1);
+        if (job->result == PPMD_OK && out.pos != out.size)
+            job->result = PPMD_ERROR_DATA;
+    }
+    ppmd_free(dec);
+    return NULL;
+}
+
+/* Runs fn over the jobs, one thread each; a single job runs on the caller. */
+static int run_jobs(block_job *jobs, unsigned count, void *(*fn)(void *))
+{
+    pthread_t handles[MAX_THREADS];
+    unsigned i, started = 0;
+    int result = PPMD_OK;
+    if (count == 1) {
+        fn(&jobs[0]);
+    } else {
+        for (; started < count; started++) {
+            if (pthread_create(&handles[started], NULL, fn, &jobs[started]) != 0)
+                break;
+        }
+        for (i = started; i < count; i++)
+            fn(&jobs[i]);
+        for (i = 0; i < started; i++)
+            pthread_join(handles[i], NULL);
+    }
+    for (i = 0; i < count; i++) {
+        if (jobs[i].result < 0 && result == PPMD_OK)
+            result = jobs[i].result;
+    }
+    return result;
+}
+
+static int fail(const char *what, int code)
+{
+    fprintf(stderr, "ppmd: %s: %s\n", what, code ? ppmd_error_string(code) : strerror(errno));
+    return 1;
+}
+
+static int write_all(FILE *f, const void *data, size_t size)
+{
+    return fwrite(data, 1, size, f) == size;
+}
+
+static int compress_blocked(const options *opt, FILE *in, FILE *out)
+{
+    block_job jobs[MAX_THREADS];
+    unsigned char header[BLOCKED_HEADER_SIZE] = {0};
+    unsigned i, count;
+    int ret = 0;
+    memset(jobs, 0, sizeof(jobs));
+    memcpy(header, BLOCKED_MAGIC, 4);
+    header[4] = BLOCKED_VERSION;
+    header[5] = ppmd_format() == PPMD_FORMAT_WIDE_REF ? BLOCKED_FLAG_WIDE_REF : 0;
+    header[6] = (unsigned char)opt->params.variant;
+    header[7] = (unsigned char)opt->params.max_order;
+    header[8] = (unsigned char)opt->params.restore_method;
+    put_u32(header + 12, opt->params.mem_size);
+    header[11] = (unsigned char)((unsigned long long)opt->params.mem_size >> 32);
+    if (!write_all(out, header, sizeof(header)))
+        return fail("write", 0);
+    for (i = 0; i < opt->threads; i++) {
+        jobs[i].params = &opt->params;
+        jobs[i].src = (unsigned char *)malloc(opt->block_size);
+        if (jobs[i].src == NULL) {
+            ret = fail("input buffer", PPMD_ERROR_MEMORY);
+            goto done;
+        }
+    }
+    do {
+        for (count = 0; count < opt->threads; count++) {
+            jobs[count].src_size = fread(jobs[count].src, 1, opt->block_size, in);
+            if (jobs[count].src_size == 0)
+                break;
+        }
+        if (ferror(in)) {
+            ret = fail("read", 0);
+            goto done;
+        }
+        if (count > 0 && (ret = run_jobs(jobs, count, compress_block)) != PPMD_OK) {
+            ret = fail("compress", ret);
+            goto done;
+        }
+        for (i = 0; i < count; i++) {
+            unsigned char sizes[8];
+            put_u32(sizes, (unsigned long)jobs[i].src_size);
+            put_u32(sizes + 4, (unsigned long)jobs[i].dst_size);
+            if (!write_all(out, sizes, 8) || !write_all(out, jobs[i].dst, jobs[i].dst_size)) {
+                ret = fail("write", 0);
+                goto done;
+            }
+        }
+    } while (count == opt->threads);
+    put_u32(header, 0);
+    if (!write_all(out, header, 4))
+        ret = fail("write", 0);
+done:
+    for (i = 0; i < opt->threads; i++) {
+        free(jobs[i].src);
+        free(jobs[i].dst);
+    }
+    return ret;
+}
+
+static int decompress_blocked(const options *opt, FILE *in, FILE *out)
+{
+    block_job jobs[MAX_THREADS];
+    unsigned char header[BLOCKED_HEADER_SIZE];
+    ppmd_params params;
+    unsigned i, count;
+    int ret = 0, end = 0;
+    memset(jobs, 0, sizeof(jobs));
+    if (fread(header, 1, sizeof(header), in) != sizeof(header) || memcmp(header, BLOCKED_MAGIC, 4) != 0
+        || header[4] != BLOCKED_VERSION || (header[6] != PPMD_VARIANT_H && header[6] != PPMD_VARIANT_I))
+        return fail("input", PPMD_ERROR_DATA);
+    if ((header[5] & BLOCKED_FLAG_WIDE_REF) != (ppmd_format() == PPMD_FORMAT_WIDE_REF ? BLOCKED_FLAG_WIDE_REF : 0)) {
+        fprintf(stderr, "ppmd: input: written by a %s build\n",
+                (header[5] & BLOCKED_FLAG_WIDE_REF) ? "wide-ref" : "standard");
+        return 1;
+    }
+    if (header[11] != 0 && sizeof(unsigned long) <= 4)
+        return fail("input", PPMD_ERROR_PARAM);
+    ppmd_params_default(&params, header[6]);
+    params.max_order = header[7];
+    params.restore_method = header[8];
+    params.mem_size = get_u32(header + 12);
+    if (header[11] != 0)
+        params.mem_size |= (unsigned long)((unsigned long long)header[11] << 32);
+    params.endmark = 0;
+    for (i = 0; i < opt->threads; i++)
+        jobs[i].params = &params;
+    while (!end) {
+        for (count = 0; count < opt->threads; count++) {
+            block_job *job = &jobs[count];
+            unsigned char sizes[8];
+            unsigned long size, packed;
+            if (fread(sizes, 1, 4, in) != 4) {
+                ret = fail("input", PPMD_ERROR_DATA);
+                goto done;
+            }
+            if ((size = get_u32(sizes)) == 0) {
+                end = 1;
+                break;
+            }
+            if (fread(sizes + 4, 1, 4, in) != 4 || size > MAX_BLOCK_SIZE || (packed = get_u32(sizes + 4)) > 2 * MAX_BLOCK_SIZE) {
+                ret = fail("input", PPMD_ERROR_DATA);
+                goto done;
+            }
+            job->src = (unsigned char *)realloc(job->src, packed ? packed : 1);
+            job->dst_size = size;
+            if (job->src == NULL || !ensure_capacity(job, size)) {
+                ret = fail("decompress", PPMD_ERROR_MEMORY);
+                goto done;
+            }
+            if ((job->src_size = fread(job->src, 1, packed, in)) != packed) {
+                ret = fail("input", PPMD_ERROR_DATA);
+                goto done;
+            }
+        }
+        if (count > 0 && (ret = run_jobs(jobs, count, decompress_block)) != PPMD_OK) {
+            ret = fail("decompress", ret);
+            goto done;
+        }
+        for (i = 0; i < count; i++) {
+            if (!write_all(out, jobs[i].dst, jobs[i].dst_size)) {
+                ret = fail("write", 0);
+                goto done;
+            }
+        }
+    }
+done:
+    for (i = 0; i < opt->threads; i++) {
+        free(jobs[i].src);
+        free(jobs[i].dst);
+    }
+    return ret;
+}
+
+static int process_raw(const options *opt, FILE *in, FILE *out)
+{
+    ppmd_params params = opt->params;
+    ppmd_stream *stream;
+    unsigned char *src = (unsigned char *)malloc(STREAM_CHUNK);
+    unsigned char *dst = (unsigned char *)malloc(STREAM_CHUNK);
+    int ret = PPMD_OK, eof = 0;
+    params.endmark = 1;
+    stream = opt->decompress ? ppmd_decoder_create(&params) : ppmd_encoder_create(&params);
+    if (stream == NULL || src == NULL || dst == NULL) {
+        ret = fail(opt->decompress ? "decompress" : "compress", PPMD_ERROR_MEMORY);
+        goto done;
+    }
+    while (!eof && ret != PPMD_STREAM_END) {
+        ppmd_buffer ib = {src, fread(src, 1, STREAM_CHUNK, in), 0};
+        int flushing = 0;
+        if (ferror(in)) {
+            ret = fail("read", 0);
+            goto done;
+        }
+        eof = ib.size < STREAM_CHUNK;
+        for (;;) {
+            ppmd_buffer ob = {dst, STREAM_CHUNK, 0};
+            if (opt->decompress) {
+                ret = ppmd_decode_chunk(stream, &ib, &ob, eof);
+            } else if (ib.pos < ib.size) {
+                ret = ppmd_encode_chunk(stream, &ib, &ob);
+            } else if (eof) {
+                ret = ppmd_flush(stream, &ob);
+                flushing = 1;
+            } else {
+                break;
+            }
+            if (ret < 0) {
+                ret = fail(opt->decompress ? "decompress" : "compress", ret);
+                goto done;
+            }
+            if (!write_all(out, dst, ob.pos)) {
+                ret = fail("write", 0);
+                goto done;
+            }
+            if (flushing ? ret == PPMD_OK
+                         : opt->decompress && (ret == PPMD_STREAM_END || (ob.pos < ob.size && ib.pos == ib.size)))
+                break;
+        }
+    }
+    if (opt->decompress && ret != PPMD_STREAM_END)
+        ret = fail("decompress", PPMD_ERROR_DATA);
+    else
+        ret = 0;
+done:
+    ppmd_free(stream);
+    free(src);
+    free(dst);
+    return ret;
+}
+
+/* Splits data into blocks like the blocked format and times both directions. */
+static int benchmark(const options *opt, FILE *in)
+{
+    block_job *jobs;
+    unsigned char *data = NULL;
+    size_t size = 0, capacity = 0, packed = 0, nblocks, i, batch;
+    double start, compress_time, decompress_time = 0;
+    ppmd_params params = opt->params;
+    size_t block_size = opt->raw ? (size_t)-1 : opt->block_size;
+    int ret;
+    for (;;) {
+        size_t n;
+        if (size == capacity) {
+            unsigned char *grown;
+            capacity = capacity ? capacity * 2 : 1 << 20;
+            if ((grown = (unsigned char *)realloc(data, capacity)) == NULL) {
+                free(data);
+                return fail("input buffer", PPMD_ERROR_MEMORY);
+            }
+            data = grown;
+        }
+        if ((n = fread(data + size, 1, capacity - size, in)) == 0)
+            break;
+        size += n;
+    }
+    if (ferror(in)) {
+        free(data);
+        return fail("read", 0);
+    }
+    if (block_size > size)
+        block_size = size ? size : 1;
+    nblocks = size ? (size + block_size - 1) / block_size : 0;
+    jobs = (block_job *)calloc(nblocks ? nblocks : 1, sizeof(block_job));
+    if (jobs == NULL) {
+        free(data);
+        return fail("benchmark", PPMD_ERROR_MEMORY);
+    }
+    params.endmark = 0;
+    for (i = 0; i < nblocks; i++) {
+        jobs[i].params = &params;
+        jobs[i].src = data + i * block_size;
+        jobs[i].src_size = i + 1 < nblocks ? block_size : size - i * block_size;
+    }
+
+    start = now();
+    for (i = 0, ret = PPMD_OK; i < nblocks && ret == PPMD_OK; i += batch) {
+        batch = nblocks - i < opt->threads ? nblocks - i : opt->threads;
+        ret = run_jobs(jobs + i, (unsigned)batch, compress_block);
+    }
+    compress_time = now() - start;
+    for (i = 0; i < nblocks; i++) {
+        /* decompress from the packed bytes into the place of the source */
+        unsigned char *packed_data = jobs[i].dst;
+        jobs[i].dst = jobs[i].src;
+        jobs[i].src = packed_data;
+        packed += jobs[i].dst_size;
+        jobs[i].src_size = jobs[i].dst_size;
+        jobs[i].dst_size = i + 1 < nblocks ? block_size : size - i * block_size;
+    }
+    if (ret == PPMD_OK) {
+        unsigned char *copy = (unsigned char *)malloc(size ? size : 1);
+        if (copy != NULL)
+            memcpy(copy, data, size);
+        memset(data, 0, size);
+        start = now();
+        for (i = 0; i < nblocks && ret == PPMD_OK; i += batch) {
+            batch = nblocks - i < opt->threads ? nblocks - i : opt->threads;
+            ret = run_jobs(jobs + i, (unsigned)batch, decompress_block);
+        }
+        decompress_time = now() - start;
+        if (ret == PPMD_OK && (copy == NULL || memcmp(copy, data, size) != 0))
+            ret = PPMD_ERROR_DATA;
+        free(copy);
+    }
+    for (i = 0; i < nblocks; i++)
+        free(jobs[i].src);
+    free(jobs);
+    free(data);
+    if (ret != PPMD_OK)
+        return fail("benchmark", ret);
+    printf("variant %c, order %u, mem %luM, %u thread(s), %lu block(s), %s kernels\n",
+           params.variant == PPMD_VARIANT_H ? 'H' : 'I', params.max_order, params.mem_size >> 20,
+           opt->threads, (unsigned long)nblocks, ppmd_kernel_name());
+    printf("%lu -> %lu bytes (%.3f), compress %.2f MB/s, decompress %.2f MB/s\n",
+           (unsigned long)size, (unsigned long)packed, size ? (double)packed / (double)size : 0.0,
+           (double)size / compress_time / 1e6, (double)size / decompress_time / 1e6);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    options opt;
+    FILE *in = stdin, *out = stdout;
+    int ret;
+    memset(&opt, 0, sizeof(opt));
+    if (!parse_args(argc, argv, &opt)) {
+        usage(stderr);
+        return 2;
+    }
+    /* select the kernels before any worker thread starts */
+    ppmd_kernel_name();
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    if (opt.input != NULL && strcmp(opt.input, "-") != 0 && (in = fopen(opt.input, "rb")) == NULL)
+        return fail(opt.input, 0);
+    if (opt.benchmark) {
+        ret = benchmark(&opt, in);
+    } else {
+        if (opt.output != NULL && strcmp(opt.output, "-") != 0 && (out = fopen(opt.output, "wb")) == NULL)
+            return fail(opt.output, 0);
+        if (opt.raw)
+            ret = process_raw(&opt, in, out);
+        else if (opt.decompress)
+            ret = decompress_blocked(&opt, in, out);
+        else
+            ret = compress_blocked(&opt, in, out);
+        if (fflush(out) != 0 && ret == 0)
+            ret = fail("write", 0);
+        if (out != stdout)
+            fclose(out);
+    }
+    if (in != stdin)
+        fclose(in);
+    return ret;
+}
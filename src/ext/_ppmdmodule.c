@@ -16,9 +16,13 @@
 
 #include "Ppmd7.h"
 #include "Ppmd8.h"
+#include "PpmdMask.h"
+#include "CpuArch.h"
 
 #include "Buffer.h"
 #include "ThreadDecoder.h"
+#include "BatchDecoder.h"
+#include "Filter.h"
 
 #ifndef Py_UNREACHABLE
     #define Py_UNREACHABLE() assert(0)
@@ -84,6 +88,9 @@ typedef struct {
     char inited;
     /* decode has been called with some data*/
     char inited2;
+
+    /* Input consumed and output produced so far, to size the output */
+    unsigned long long in_total, out_total;
 } Ppmd7Decoder;
 
 typedef struct {
@@ -95,6 +102,9 @@ typedef struct {
     /* Ppmd8 context */
     CPpmd8 *cPpmd8;
 
+    /* Filter in front of the coder, or NULL */
+    PpmdFilter *filter;
+
     /* __init__ has been called, 0 or 1. */
     char inited;
     /* flush() has been called, 0 or 1. */
@@ -124,6 +134,12 @@ typedef struct {
     /* 1 when end mark observed */
     char eof;
 
+    /* Filter behind the decoder, or NULL; its output may outlast the end mark */
+    PpmdFilter *filter;
+    char stream_end;
+    /* the decoder stopped for input, and must not resume without */
+    char stream_waiting;
+
     /* Output Buffer */
     BlocksOutputBuffer *blocksOutputBuffer;
 
@@ -131,6 +147,9 @@ typedef struct {
     char inited;
     /* decode has been called with some data*/
     char inited2;
+
+    /* Input consumed and output produced so far, to size the output */
+    unsigned long long in_total, out_total;
 } Ppmd8Decoder;
 
 typedef struct {
@@ -153,6 +172,40 @@ static _ppmd_state static_state;
 
 static const char init_twice_msg[] = "__init__ method is called twice.";
 static const char flush_twice_msg[] = "flush method is called twice.";
+static const char filter_msg[] = "Unknown filter, or filter_param out of range: a distance of 1 to 256 "
+                                 "for PPMD8_FILTER_DELTA, a record width of 2 to 4096 for "
+                                 "PPMD8_FILTER_TRANSPOSE and 0 for PPMD8_FILTER_X86.";
+
+static PpmdFilter *
+filter_new(int kind, int param)
+{
+    PpmdFilter *f = PyMem_Malloc(sizeof(PpmdFilter));
+    if (f == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    if (!PpmdFilter_Init(f, kind, (unsigned)param, &allocator)) {
+        PyMem_Free(f);
+        PyErr_SetString(PyExc_ValueError, filter_msg);
+        return NULL;
+    }
+    if (f->buf == NULL) {
+        PpmdFilter_Free(f, &allocator);
+        PyMem_Free(f);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    return f;
+}
+
+static void
+filter_free(PpmdFilter *f)
+{
+    if (f != NULL) {
+        PpmdFilter_Free(f, &allocator);
+        PyMem_Free(f);
+    }
+}
 
 static inline void
 clamp_max_order(unsigned long *max_order, unsigned long max) {
@@ -173,6 +226,87 @@ clamp_memory_size(unsigned long *memorySize) {
     }
 }
 
+static inline int
+check_restore_method(int restore_method) {
+    if (restore_method != PPMD8_RESTORE_METHOD_RESTART && restore_method != PPMD8_RESTORE_METHOD_CUT_OFF &&
+        restore_method != PPMD8_RESTORE_METHOD_REPLAY) {
+        PyErr_SetString(PyExc_ValueError, "restore_method should be one of the PPMD8_RESTORE_METHOD_* constants.");
+        return -1;
+    }
+    return 0;
+}
+
+static const char ppmd7_props_msg[] = "PPMd7 properties should be 5 bytes: max order 2..64, then memory size.";
+
+static PyObject *
+ppmd7_props_get(const CPpmd7 *cPpmd7)
+{
+    Byte props[PPMD7_PROPS_SIZE];
+    if (cPpmd7 == NULL || !Ppmd7_WasAllocated(cPpmd7)) {
+        PyErr_SetString(PyExc_ValueError, "The model is not initialized.");
+        return NULL;
+    }
+    Ppmd7_WriteProps(props, cPpmd7->MaxOrder, cPpmd7->Size);
+    return PyBytes_FromStringAndSize((const char *)props, PPMD7_PROPS_SIZE);
+}
+
+static int
+ppmd7_props_parse(PyObject *obj, unsigned *max_order, UInt32 *mem_size)
+{
+    Py_buffer props;
+    Bool ok;
+    if (PyObject_GetBuffer(obj, &props, PyBUF_SIMPLE) < 0) {
+        return -1;
+    }
+    ok = Ppmd7_ReadProps((const Byte *)props.buf, (size_t)props.len, max_order, mem_size);
+    PyBuffer_Release(&props);
+    if (!ok) {
+        PyErr_SetString(PyExc_ValueError, ppmd7_props_msg);
+        return -1;
+    }
+    return 0;
+}
+
+PyDoc_STRVAR(stats_doc, "stats()\n"
+"----\n"
+"Return a dict of model memory telemetry: mem_size, used_memory and\n"
+"peak_memory in bytes, then the counts of restarts (the memory ran out\n"
+"and the model started over), cutoffs (variant I passes pruning the\n"
+"context tree), glues (free block defragmentations) and rescales.");
+
+static PyObject *
+model_stats(const CPpmd_Stats *stats, UInt32 size, UInt32 used)
+{
+    return Py_BuildValue("{s:I,s:I,s:I,s:I,s:I,s:I,s:I}",
+                         "mem_size", (unsigned int)size,
+                         "used_memory", (unsigned int)used,
+                         "peak_memory", (unsigned int)(stats->PeakUsed > used ? stats->PeakUsed : used),
+                         "restarts", (unsigned int)stats->Restarts,
+                         "cutoffs", (unsigned int)stats->CutOffs,
+                         "glues", (unsigned int)stats->Glues,
+                         "rescales", (unsigned int)stats->Rescales);
+}
+
+static PyObject *
+ppmd7_stats_get(const CPpmd7 *cPpmd7)
+{
+    if (cPpmd7 == NULL || !Ppmd7_WasAllocated(cPpmd7)) {
+        PyErr_SetString(PyExc_ValueError, "The model is not initialized.");
+        return NULL;
+    }
+    return model_stats(&cPpmd7->Stats, cPpmd7->Size, Ppmd7_GetUsedMemory(cPpmd7));
+}
+
+static PyObject *
+ppmd8_stats_get(const CPpmd8 *cPpmd8)
+{
+    if (cPpmd8 == NULL || !Ppmd8_WasAllocated(cPpmd8)) {
+        PyErr_SetString(PyExc_ValueError, "The model is not initialized.");
+        return NULL;
+    }
+    return model_stats(&cPpmd8->Stats, cPpmd8->Size, Ppmd8_GetUsedMemory(cPpmd8));
+}
+
 /* -----------------------
      Ppmd7Decoder code
    ------------------------ */
@@ -389,22 +523,27 @@ Ppmd7_unused_data_get(Ppmd7Decoder *self, void *Py_UNUSED(ignored))
     return ret;
 }
 
-PyDoc_STRVAR(Ppmd7Decoder_decode_doc, "decode()\n"
+PyDoc_STRVAR(Ppmd7Decoder_decode_doc, "decode(data, length, as_chunks=False, exact=False)\n"
              "----\n"
-             "A PPMd compression decode.");
+             "A PPMd compression decode.\n\n"
+             "With as_chunks, return the output blocks as a list of bytes\n"
+             "instead of joining them into one bytes object. With exact, length is\n"
+             "the size of the output rather than a bound, and is allocated up front.");
 
 static PyObject *
 Ppmd7Decoder_decode(Ppmd7Decoder *self,  PyObject *args, PyObject *kwargs) {
-    static char *kwlist[] = {"data", "length", NULL};
+    static char *kwlist[] = {"data", "length", "as_chunks", "exact", NULL};
     Py_buffer data;
     int length;
+    int as_chunks = 0;
+    int exact = 0;
     PyObject *ret = NULL;
     char use_input_buffer;
     ppmd_info *threadInfo;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwargs,
-                                     "y*i:Ppmd7Decoder.decode", kwlist,
-                                     &data, &length)) {
+                                     "y*i|pp:Ppmd7Decoder.decode", kwlist,
+                                     &data, &length, &as_chunks, &exact)) {
         return NULL;
     }
 
@@ -501,7 +640,8 @@ Ppmd7Decoder_decode(Ppmd7Decoder *self,  PyObject *args, PyObject *kwargs) {
     }
     assert(in->pos == 0);
 
-    if (OutputBuffer_InitAndGrow(self->blocksOutputBuffer, out, length) < 0) {
+    if (OutputBuffer_InitEstimate(self->blocksOutputBuffer, out, length,
+                                  OutputBuffer_Estimate(in->size, self->in_total, self->out_total), exact) < 0) {
         PyErr_SetString(PyExc_ValueError, "No Memory.");
         RELEASE_LOCK(self);
         return NULL;
@@ -549,7 +689,13 @@ Ppmd7Decoder_decode(Ppmd7Decoder *self,  PyObject *args, PyObject *kwargs) {
         goto error;
     }
 
-    ret = OutputBuffer_Finish(self->blocksOutputBuffer, out);
+    self->in_total += in->pos;
+    self->out_total += OutputBuffer_GetDataSize(self->blocksOutputBuffer, out);
+    if (as_chunks) {
+        ret = OutputBuffer_FinishChunks(self->blocksOutputBuffer, out);
+    } else {
+        ret = OutputBuffer_Finish(self->blocksOutputBuffer, out);
+    }
     if (Ppmd7z_RangeDec_IsFinishedOK(self->rangeDec)) {
         self->eof = True;
     }
@@ -626,9 +772,47 @@ reduce_cannot_pickle(PyObject *self)
     return NULL;
 }
 
+PyDoc_STRVAR(Ppmd7Decoder_from_props_doc, "from_props(props)\n"
+"----\n"
+"Create a decoder from the 5 byte PPMd coder properties of a 7z folder.\n\n"
+"Arguments\n"
+"props: bytes-like object, max order in the first byte, memory size\n"
+"       as 32-bit little endian in the next four.");
+
+static PyObject *
+Ppmd7Decoder_from_props(PyObject *cls, PyObject *props)
+{
+    unsigned max_order;
+    UInt32 mem_size;
+    if (ppmd7_props_parse(props, &max_order, &mem_size) < 0) {
+        return NULL;
+    }
+    return PyObject_CallFunction(cls, "Ik", max_order, (unsigned long)mem_size);
+}
+
+static PyObject *
+Ppmd7Decoder_props_get(Ppmd7Decoder *self, void *Py_UNUSED(ignored))
+{
+    return ppmd7_props_get(self->cPpmd7);
+}
+
+static PyObject *
+Ppmd7Decoder_stats(Ppmd7Decoder *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *ret;
+    ACQUIRE_LOCK(self);
+    ret = ppmd7_stats_get(self->cPpmd7);
+    RELEASE_LOCK(self);
+    return ret;
+}
+
 static PyMethodDef Ppmd7Decoder_methods[] = {
         {"decode", (PyCFunction)Ppmd7Decoder_decode,
                      METH_VARARGS|METH_KEYWORDS, Ppmd7Decoder_decode_doc},
+        {"from_props", (PyCFunction)Ppmd7Decoder_from_props,
+                     METH_O|METH_CLASS, Ppmd7Decoder_from_props_doc},
+        {"stats", (PyCFunction)Ppmd7Decoder_stats,
+                     METH_NOARGS, stats_doc},
         {"__reduce__", (PyCFunction)reduce_cannot_pickle,
                      METH_NOARGS, reduce_cannot_pickle_doc},
         {NULL, NULL, 0, NULL}
@@ -648,9 +832,13 @@ static PyMemberDef Ppmd7Decoder_members[] = {
         {NULL}
 };
 
+PyDoc_STRVAR(Ppmd7_props_doc, "The 5 byte 7z coder properties, max order and memory size, of the model.");
+
 static PyGetSetDef Ppmd7Decoder_getset[] = {
         {"unused_data", (getter)Ppmd7_unused_data_get, NULL,
                 Ppmd7Decoder_unused_data__doc},
+        {"props", (getter)Ppmd7Decoder_props_get, NULL,
+                Ppmd7_props_doc},
         {NULL},
 };
 
@@ -818,7 +1006,11 @@ Ppmd7Encoder_encode(Ppmd7Encoder *self,  PyObject *args, PyObject *kwargs) {
     Bool result = True;
     for (UInt32 i = 0; i < data.len; i++){
         Py_BEGIN_ALLOW_THREADS
-        Ppmd7_EncodeSymbol(self->cPpmd7, self->rangeEnc, *((Byte *)data.buf + i));
+        /* a run writes no output, so it needs no room in out */
+        if (Ppmd7_InRun(self->cPpmd7))
+            i += (UInt32) Ppmd7_EncodeRun(self->cPpmd7, self->rangeEnc, (Byte *)data.buf + i, (size_t)(data.len - i));
+        if (i < data.len)
+            Ppmd7_EncodeSymbol(self->cPpmd7, self->rangeEnc, *((Byte *)data.buf + i));
         Py_END_ALLOW_THREADS
         if (out.size == out.pos) {
             if (OutputBuffer_Grow(&buffer, &out) < 0) {
@@ -895,21 +1087,46 @@ error:
     return NULL;
 }
 
+static PyObject *
+Ppmd7Encoder_stats(Ppmd7Encoder *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *ret;
+    ACQUIRE_LOCK(self);
+    ret = ppmd7_stats_get(self->cPpmd7);
+    RELEASE_LOCK(self);
+    return ret;
+}
+
 static PyMethodDef Ppmd7Encoder_methods[] = {
         {"encode", (PyCFunction)Ppmd7Encoder_encode,
                      METH_VARARGS|METH_KEYWORDS, Ppmd7Encoder_encode_doc},
         {"flush", (PyCFunction)Ppmd7Encoder_flush,
                      METH_VARARGS|METH_KEYWORDS, Ppmd7Encoder_flush_doc},
+        {"stats", (PyCFunction)Ppmd7Encoder_stats,
+                     METH_NOARGS, stats_doc},
         {"__reduce__", (PyCFunction)reduce_cannot_pickle,
                      METH_NOARGS, reduce_cannot_pickle_doc},
         {NULL, NULL, 0, NULL}
 };
 
+static PyObject *
+Ppmd7Encoder_props_get(Ppmd7Encoder *self, void *Py_UNUSED(ignored))
+{
+    return ppmd7_props_get(self->cPpmd7);
+}
+
+static PyGetSetDef Ppmd7Encoder_getset[] = {
+        {"props", (getter)Ppmd7Encoder_props_get, NULL,
+                Ppmd7_props_doc},
+        {NULL},
+};
+
 static PyType_Slot Ppmd7Encoder_slots[] = {
         {Py_tp_new, Ppmd7Encoder_new},
         {Py_tp_dealloc, Ppmd7Encoder_dealloc},
         {Py_tp_init, Ppmd7Encoder_init},
         {Py_tp_methods, Ppmd7Encoder_methods},
+        {Py_tp_getset, Ppmd7Encoder_getset},
         {Py_tp_doc, (char *)Ppmd7Encoder_doc},
         {0, 0}
 };
@@ -965,13 +1182,14 @@ Ppmd8Decoder_dealloc(Ppmd8Decoder *self) {
         PyMem_Free(self->blocksOutputBuffer);
         PyMem_Free(self->cPpmd8);
     }
+    filter_free(self->filter);
     PyTypeObject *tp = Py_TYPE(self);
     tp->tp_free((PyObject*)self);
     Py_DECREF(tp);
 }
 
 PyDoc_STRVAR(Ppmd8Decoder_doc, "A PPMd compression algorithm decoder.\n\n"
-                                 "Ppmd8Decoder.__init__(self, max_order, mem_size, restore_method=0)\n"
+                                 "Ppmd8Decoder.__init__(self, max_order, mem_size, restore_method=0, filter=0, filter_param=0)\n"
                                  "----\n"
                                  "Initialize a Ppmd8Decoder object.\n\n"
                                  "Arguments\n"
@@ -981,16 +1199,19 @@ PyDoc_STRVAR(Ppmd8Decoder_doc, "A PPMd compression algorithm decoder.\n\n"
                                  "mem_size:  max memory size in bytes the compressor is able to use, bigger values improve compression,\n"
                                  "           raging from 10kB to physical memory size.\n"
                                  "           Default size is 16MB.\n"
-                                 "restore_method: restore method, 0=restart, 1=cutoff.\n"
+                                 "restore_method: restore method, 0=restart, 1=cutoff, 4=replay.\n"
+                                 "filter:    PPMD8_FILTER_* the data was encoded with, and its filter_param.\n"
                                  );
 
 static int
 Ppmd8Decoder_init(Ppmd8Decoder *self, PyObject *args, PyObject *kwargs)
 {
-    static char *kwlist[] = {"max_order", "mem_size", "restore_method", NULL};
+    static char *kwlist[] = {"max_order", "mem_size", "restore_method", "filter", "filter_param", NULL};
     PyObject *max_order = Py_None;
     PyObject *mem_size = Py_None;
     int restore_method = PPMD8_RESTORE_METHOD_RESTART;
+    int filter = PPMD_FILTER_NONE;
+    int filter_param = 0;
     BlocksOutputBuffer *blocksOutputBuffer;
     BufferReader *bufferReader;
     InBuffer *in;
@@ -998,8 +1219,8 @@ Ppmd8Decoder_init(Ppmd8Decoder *self, PyObject *args, PyObject *kwargs)
     ppmd_info *threadInfo;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwargs,
-                                     "OO|i:Ppmd8Decoder.__init__", kwlist,
-                                     &max_order, &mem_size, &restore_method)) {
+                                     "OO|iii:Ppmd8Decoder.__init__", kwlist,
+                                     &max_order, &mem_size, &restore_method, &filter, &filter_param)) {
         return -1;
     }
 
@@ -1011,6 +1232,14 @@ Ppmd8Decoder_init(Ppmd8Decoder *self, PyObject *args, PyObject *kwargs)
     self->inited = 1;
     self->needs_input = 1;
 
+    if (check_restore_method(restore_method) < 0) {
+        goto error;
+    }
+
+    if (filter != PPMD_FILTER_NONE && (self->filter = filter_new(filter, filter_param)) == NULL) {
+        goto error;
+    }
+
     unsigned long maximum_order = 6;
     unsigned long memory_size = 16 << 20;
 
@@ -1132,26 +1361,32 @@ unused_data_get(Ppmd8Decoder *self, void *Py_UNUSED(ignored))
     return ret;
 }
 
-PyDoc_STRVAR(Ppmd8Decoder_decode_doc, "decode()\n"
+PyDoc_STRVAR(Ppmd8Decoder_decode_doc, "decode(data, length=-1, as_chunks=False, exact=False)\n"
              "----\n"
-             "A PPMd compression decode.");
+             "A PPMd compression decode.\n\n"
+             "With as_chunks, return the output blocks as a list of bytes\n"
+             "instead of joining them into one bytes object. With exact, length is\n"
+             "the size of the output rather than a bound, and is allocated up front.");
 
 static PyObject *
 Ppmd8Decoder_decode(Ppmd8Decoder *self,  PyObject *args, PyObject *kwargs) {
-    static char *kwlist[] = {"data", "length", NULL};
+    static char *kwlist[] = {"data", "length", "as_chunks", "exact", NULL};
     Py_buffer data;
     int length = -1;
+    int as_chunks = 0;
+    int exact = 0;
     PyObject *ret = NULL;
     char use_input_buffer;
     ppmd_info *threadInfo;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwargs,
-                                     "y*|i:Ppmd8Decoder.decode", kwlist,
-                                     &data, &length)) {
+                                     "y*|ipp:Ppmd8Decoder.decode", kwlist,
+                                     &data, &length, &as_chunks, &exact)) {
         return NULL;
     }
 
-    if (self->inited2 == 0 && data.len < 5) {
+    /* the range decoder starts with a 4 byte code */
+    if (self->inited2 == 0 && data.len < 4) {
        PyErr_SetString(PyExc_ValueError,
                        "Not enough data for starting decompression.");
        return NULL;
@@ -1159,10 +1394,21 @@ Ppmd8Decoder_decode(Ppmd8Decoder *self,  PyObject *args, PyObject *kwargs) {
 
     ACQUIRE_LOCK(self);
 
+    /* Nothing follows the end mark */
+    if (self->eof) {
+        ret = as_chunks ? PyList_New(0) : PyBytes_FromStringAndSize(NULL, 0);
+        goto success;
+    }
+
     BufferReader *bufferReader = (BufferReader *) self->cPpmd8->Stream.In;
     InBuffer *in = bufferReader->inBuffer;
     threadInfo = bufferReader->t;
     OutBuffer *out = threadInfo->out;
+    OutBuffer filtered;
+    if (self->filter != NULL) {
+        /* the decoder writes to the filter, out gets what comes through */
+        out = &filtered;
+    }
 
     /* Prepare input buffer w/wo unconsumed data */
     if (self->in_begin == self->in_end) {
@@ -1244,7 +1490,8 @@ Ppmd8Decoder_decode(Ppmd8Decoder *self,  PyObject *args, PyObject *kwargs) {
     }
     assert(in->pos == 0);
 
-    if (OutputBuffer_InitAndGrow(self->blocksOutputBuffer, out, length) < 0) {
+    if (OutputBuffer_InitEstimate(self->blocksOutputBuffer, out, length,
+                                  OutputBuffer_Estimate(in->size, self->in_total, self->out_total), exact) < 0) {
         PyErr_SetString(PyExc_ValueError, "L1551: No Memory.");
         RELEASE_LOCK(self);
         return NULL;
@@ -1262,7 +1509,7 @@ Ppmd8Decoder_decode(Ppmd8Decoder *self,  PyObject *args, PyObject *kwargs) {
 
     int result;
     int remains = length >= 0 ? length : INT_MAX;
-    while (True) {
+    while (self->filter == NULL) {
         Py_BEGIN_ALLOW_THREADS
         result = Ppmd8T_decode(self->cPpmd8, out, remains, threadInfo);
         Py_END_ALLOW_THREADS
@@ -1282,6 +1529,52 @@ Ppmd8Decoder_decode(Ppmd8Decoder *self,  PyObject *args, PyObject *kwargs) {
             }
         }
     }
+    if (self->filter != NULL) {
+        PpmdFilter *f = self->filter;
+        OutBuffer *stage = threadInfo->out;
+        result = self->stream_waiting && in->pos == in->size ? 0 : 1;
+        while (remains > 0) {
+            size_t n = PpmdFilter_Ready(f);
+            if (n != 0) {
+                if (out->pos == out->size && OutputBuffer_Grow(self->blocksOutputBuffer, out) < 0) {
+                    PyErr_SetString(PyExc_ValueError, "No memory.");
+                    goto error;
+                }
+                n = n < out->size - out->pos ? n : out->size - out->pos;
+                n = n < (size_t)remains ? n : (size_t)remains;
+                memcpy((Byte *)out->dst + out->pos, PpmdFilter_Data(f), n);
+                PpmdFilter_Skip(f, n);
+                out->pos += n;
+                remains -= (int)n;
+                continue;
+            }
+            if (self->stream_end || result == 0) {
+                break;  // end mark, or waiting for input
+            }
+            /* block filters decode ahead, the others just as far as asked */
+            size_t room;
+            stage->dst = PpmdFilter_Space(f, &room);
+            stage->pos = 0;
+            stage->size = PpmdFilter_InBlocks(f) || room < (size_t)remains ? room : (size_t)remains;
+            Py_BEGIN_ALLOW_THREADS
+            result = Ppmd8T_decode(self->cPpmd8, stage, (int)stage->size, threadInfo);
+            if (result != -2) {
+                PpmdFilter_Decode(f, stage->pos, result == -1);
+            }
+            Py_END_ALLOW_THREADS
+            if (result == -2) {
+                break;
+            }
+            if (result == -1) {
+                self->stream_end = True;
+            }
+            self->stream_waiting = result == 0;
+        }
+        if (result != -2) {
+            /* output left in the filter puts off the end */
+            result = PpmdFilter_Ready(f) != 0 ? 1 : self->stream_end ? -1 : result;
+        }
+    }
     if (result == 0) {
         self->needs_input = True;
     }
@@ -1294,7 +1587,13 @@ Ppmd8Decoder_decode(Ppmd8Decoder *self,  PyObject *args, PyObject *kwargs) {
         goto error;
     }
 
-    ret = OutputBuffer_Finish(self->blocksOutputBuffer, out);
+    self->in_total += in->pos;
+    self->out_total += OutputBuffer_GetDataSize(self->blocksOutputBuffer, out);
+    if (as_chunks) {
+        ret = OutputBuffer_FinishChunks(self->blocksOutputBuffer, out);
+    } else {
+        ret = OutputBuffer_Finish(self->blocksOutputBuffer, out);
+    }
 
     /* Unconsumed input data */
     if (in->pos == in->size) {
@@ -1351,9 +1650,21 @@ success:
     return ret;
 }
 
+static PyObject *
+Ppmd8Decoder_stats(Ppmd8Decoder *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *ret;
+    ACQUIRE_LOCK(self);
+    ret = ppmd8_stats_get(self->cPpmd8);
+    RELEASE_LOCK(self);
+    return ret;
+}
+
 static PyMethodDef Ppmd8Decoder_methods[] = {
         {"decode", (PyCFunction)Ppmd8Decoder_decode,
                      METH_VARARGS|METH_KEYWORDS, Ppmd8Decoder_decode_doc},
+        {"stats", (PyCFunction)Ppmd8Decoder_stats,
+                     METH_NOARGS, stats_doc},
         {"__reduce__", (PyCFunction)reduce_cannot_pickle,
                      METH_NOARGS, reduce_cannot_pickle_doc},
         {NULL, NULL, 0, NULL}
@@ -1426,6 +1737,7 @@ Ppmd8Encoder_dealloc(Ppmd8Encoder *self)
     if (self->cPpmd8 != NULL) {
         Ppmd8_Free(self->cPpmd8, &allocator);
     }
+    filter_free(self->filter);
     if (self->lock) {
         PyThread_free_lock(self->lock);
     }
@@ -1435,7 +1747,7 @@ Ppmd8Encoder_dealloc(Ppmd8Encoder *self)
 }
 
 PyDoc_STRVAR(Ppmd8Encoder_doc, "A PPMd compression algorithm.\n\n"
-                                 "Ppmd8Encoder.__init__(self, max_order, mem_size, restore_method=0)\n"
+                                 "Ppmd8Encoder.__init__(self, max_order, mem_size, restore_method=0, filter=0, filter_param=0)\n"
                                  "----\n"
                                  "Initialize a Ppmd8Encoder object.\n\n"
                                  "Arguments\n"
@@ -1444,20 +1756,25 @@ PyDoc_STRVAR(Ppmd8Encoder_doc, "A PPMd compression algorithm.\n\n"
                                  "mem_size:  max memory size in bytes the compressor is able to use, bigger values improve compression,\n"
                                  "           raging from 10kB to physical memory size.\n"
                                  "           Default size is 16MB.\n"
-                                 "restore_method: restore method, 0=restart, 1=cutoff.\n"
+                                 "restore_method: restore method, 0=restart, 1=cutoff, 4=replay.\n"
+                                 "filter:    PPMD8_FILTER_DELTA (filter_param: distance, 1 to 256),\n"
+                                 "           PPMD8_FILTER_X86 or PPMD8_FILTER_TRANSPOSE (filter_param: record width,\n"
+                                 "           2 to 4096) transforms the data before it is coded. Default is PPMD8_FILTER_NONE.\n"
                                  );
 
 static int
 Ppmd8Encoder_init(Ppmd8Encoder *self, PyObject *args, PyObject *kwargs)
 {
-    static char *kwlist[] = {"max_order", "mem_size", "restore_method", NULL};
+    static char *kwlist[] = {"max_order", "mem_size", "restore_method", "filter", "filter_param", NULL};
     PyObject *max_order = Py_None;
     PyObject *mem_size = Py_None;
     int restore_method = PPMD8_RESTORE_METHOD_RESTART;
+    int filter = PPMD_FILTER_NONE;
+    int filter_param = 0;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwargs,
-                                     "OO|i:Ppmd8Encoder.__init__", kwlist,
-                                     &max_order, &mem_size, &restore_method)) {
+                                     "OO|iii:Ppmd8Encoder.__init__", kwlist,
+                                     &max_order, &mem_size, &restore_method, &filter, &filter_param)) {
         goto error;
     }
 
@@ -1468,6 +1785,14 @@ Ppmd8Encoder_init(Ppmd8Encoder *self, PyObject *args, PyObject *kwargs)
     }
     self->inited = 1;
 
+    if (check_restore_method(restore_method) < 0) {
+        goto error;
+    }
+
+    if (filter != PPMD_FILTER_NONE && (self->filter = filter_new(filter, filter_param)) == NULL) {
+        goto error;
+    }
+
     unsigned long maximum_order = 6;
     unsigned long memory_size = 16 << 20;
 
@@ -1516,6 +1841,31 @@ PyDoc_STRVAR(Ppmd8Encoder_encode_doc, "encode()\n"
              "----\n"
              "A PPMd compression encode.");
 
+/* Codes size bytes of src, growing out as the range coder fills it. */
+static Bool
+Ppmd8Encoder_encode_bytes(Ppmd8Encoder *self, const Byte *src, size_t size,
+                          BlocksOutputBuffer *buffer, OutBuffer *out, BufferWriter *writer)
+{
+    for (size_t i = 0; i < size; i++){
+        Py_BEGIN_ALLOW_THREADS
+        /* a run writes no output, so it needs no room in out */
+        if (Ppmd8_InRun(self->cPpmd8))
+            i += Ppmd8_EncodeRun(self->cPpmd8, src + i, size - i);
+        if (i < size)
+            Ppmd8_EncodeSymbol(self->cPpmd8, src[i]);
+        Py_END_ALLOW_THREADS
+        if (out->size == out->pos) {
+            if (OutputBuffer_Grow(buffer, out) < 0) {
+                PyErr_SetString(PyExc_ValueError, "No memory.");
+                return False;
+            } else {
+                writer->outBuffer = out;
+            }
+        }
+    }
+    return True;
+}
+
 static PyObject *
 Ppmd8Encoder_encode(Ppmd8Encoder *self,  PyObject *args, PyObject *kwargs) {
     static char *kwlist[] = {"data", NULL};
@@ -1542,19 +1892,16 @@ Ppmd8Encoder_encode(Ppmd8Encoder *self,  PyObject *args, PyObject *kwargs) {
     self->cPpmd8->Stream.Out = (IByteOut *)&writer;
 
     Bool result = True;
-    for (UInt32 i = 0; i < data.len; i++){
+    if (self->filter == NULL) {
+        result = Ppmd8Encoder_encode_bytes(self, (const Byte *)data.buf, (size_t)data.len, &buffer, &out, &writer);
+    }
+    for (size_t done = 0; self->filter != NULL && result && done < (size_t)data.len;) {
         Py_BEGIN_ALLOW_THREADS
-        Ppmd8_EncodeSymbol(self->cPpmd8, *((Byte *)data.buf + i));
+        done += PpmdFilter_Encode(self->filter, (const Byte *)data.buf + done, (size_t)data.len - done);
         Py_END_ALLOW_THREADS
-        if (out.size == out.pos) {
-            if (OutputBuffer_Grow(&buffer, &out) < 0) {
-                PyErr_SetString(PyExc_ValueError, "No memory.");
-                result = False;
-                break;
-            } else {
-                writer.outBuffer = &out;
-            }
-        }
+        result = Ppmd8Encoder_encode_bytes(self, PpmdFilter_Data(self->filter), PpmdFilter_Ready(self->filter),
+                                           &buffer, &out, &writer);
+        PpmdFilter_Skip(self->filter, PpmdFilter_Ready(self->filter));
     }
     if (!result)
         goto error;
@@ -1594,6 +1941,11 @@ Ppmd8Encoder_flush(Ppmd8Encoder *self, PyObject *args, PyObject *kwargs)
         PyErr_SetString(PyExc_ValueError, flush_twice_msg);
         goto error;
     }
+    /* the decoder finds the last block by the end mark */
+    if (self->filter != NULL && PpmdFilter_InBlocks(self->filter) && !endmark) {
+        PyErr_SetString(PyExc_ValueError, "PPMD8_FILTER_TRANSPOSE needs the end mark.");
+        goto error;
+    }
 
     if (OutputBuffer_InitAndGrow(&buffer, &out, -1) < 0) {
         PyErr_SetString(PyExc_ValueError, "No memory.");
@@ -1603,6 +1955,13 @@ Ppmd8Encoder_flush(Ppmd8Encoder *self, PyObject *args, PyObject *kwargs)
     writer.Write = (void (*)(void *, Byte)) Writer;
     writer.outBuffer = &out;
     self->cPpmd8->Stream.Out = (IByteOut *) &writer;
+    if (self->filter != NULL) {
+        PpmdFilter_EncodeEnd(self->filter);
+        if (!Ppmd8Encoder_encode_bytes(self, PpmdFilter_Data(self->filter), PpmdFilter_Ready(self->filter),
+                                       &buffer, &out, &writer)) {
+            goto error;
+        }
+    }
     if (endmark) {
         Ppmd8_EncodeSymbol(self->cPpmd8, -1);
     }
@@ -1618,11 +1977,23 @@ error:
     return NULL;
 }
 
+static PyObject *
+Ppmd8Encoder_stats(Ppmd8Encoder *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *ret;
+    ACQUIRE_LOCK(self);
+    ret = ppmd8_stats_get(self->cPpmd8);
+    RELEASE_LOCK(self);
+    return ret;
+}
+
 static PyMethodDef Ppmd8Encoder_methods[] = {
         {"encode", (PyCFunction)Ppmd8Encoder_encode,
                      METH_VARARGS|METH_KEYWORDS, Ppmd8Encoder_encode_doc},
         {"flush", (PyCFunction)Ppmd8Encoder_flush,
                      METH_VARARGS|METH_KEYWORDS, Ppmd8Encoder_flush_doc},
+        {"stats", (PyCFunction)Ppmd8Encoder_stats,
+                     METH_NOARGS, stats_doc},
         {"__reduce__", (PyCFunction)reduce_cannot_pickle,
                      METH_NOARGS, reduce_cannot_pickle_doc},
         {NULL, NULL, 0, NULL}
@@ -1644,11 +2015,266 @@ static PyType_Spec Ppmd8Encoder_type_spec = {
         .slots = Ppmd8Encoder_slots,
 };
 
+/* -----------------------
+     decompress_many code
+   ------------------------ */
+
+PyDoc_STRVAR(decompress_many_doc, "decompress_many(datas, lengths=None, max_order=6, mem_size=16 << 20, restore_method=0, width=1)\n"
+"----\n"
+"Decompress a sequence of independent PPMd variant I streams and return a list of bytes.\n"
+"With width > 1, up to width streams are decoded together on the calling thread, one symbol\n"
+"of each in turn, so that their memory stalls can overlap. Whether this pays off depends on\n"
+"the cache sizes of the machine. Each stream in a group needs its own mem_size model.\n"
+"lengths gives the size of each decompressed stream; with None every stream must end with an end mark.");
+
+static PyObject *
+decompress_many(PyObject *module, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {"datas", "lengths", "max_order", "mem_size", "restore_method", "width", NULL};
+    PyObject *datas;
+    PyObject *lengths = Py_None;
+    unsigned long maximum_order = 6;
+    unsigned long memory_size = 16 << 20;
+    int restore_method = PPMD8_RESTORE_METHOD_RESTART;
+    int width = 1;
+    PyObject *datas_seq = NULL, *lengths_seq = NULL, *ret = NULL;
+    CPpmd8 *models = NULL;
+    Ppmd8BatchStream streams[PPMD_BATCH_MAX_WIDTH];
+    BlocksOutputBuffer buffers[PPMD_BATCH_MAX_WIDTH];
+    Py_buffer views[PPMD_BATCH_MAX_WIDTH];
+    int allocated = 0, viewed = 0, buffered = 0, finished = 0;
+    Py_ssize_t n, base;
+    int i;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs,
+                                     "O|Okkii:decompress_many", kwlist,
+                                     &datas, &lengths, &maximum_order, &memory_size,
+                                     &restore_method, &width)) {
+        return NULL;
+    }
+    if (width < 1 || width > PPMD_BATCH_MAX_WIDTH) {
+        PyErr_Format(PyExc_ValueError, "width should be in range 1 to %d.", PPMD_BATCH_MAX_WIDTH);
+        return NULL;
+    }
+    if (check_restore_method(restore_method) < 0) {
+        return NULL;
+    }
+    clamp_max_order(&maximum_order, PPMD8_MAX_ORDER);
+    clamp_memory_size(&memory_size);
+
+    datas_seq = PySequence_Fast(datas, "datas should be a sequence of bytes-like objects.");
+    if (datas_seq == NULL) {
+        return NULL;
+    }
+    n = PySequence_Fast_GET_SIZE(datas_seq);
+    if (lengths != Py_None) {
+        lengths_seq = PySequence_Fast(lengths, "lengths should be a sequence of int.");
+        if (lengths_seq == NULL) {
+            goto error;
+        }
+        if (PySequence_Fast_GET_SIZE(lengths_seq) != n) {
+            PyErr_SetString(PyExc_ValueError, "lengths should have the same size as datas.");
+            goto error;
+        }
+    }
+    if (n < width) {
+        width = (int) n;
+    }
+
+    models = PyMem_Malloc(sizeof(CPpmd8) * (width > 0 ? width : 1));
+    if (models == NULL) {
+        PyErr_NoMemory();
+        goto error;
+    }
+    for (; allocated < width; allocated++) {
+        Ppmd8_Construct(&models[allocated]);
+        if (!Ppmd8_Alloc(&models[allocated], memory_size, &allocator)) {
+            PyErr_NoMemory();
+            goto error;
+        }
+    }
+
+    ret = PyList_New(n);
+    if (ret == NULL) {
+        goto error;
+    }
+
+    for (base = 0; base < n; base += width) {
+        const int count = (int) (n - base < width ? n - base : width);
+
+        viewed = buffered = finished = 0;
+        while (buffered < count) {
+            Py_ssize_t length = -1;
+            if (PyObject_GetBuffer(PySequence_Fast_GET_ITEM(datas_seq, base + viewed),
+                                   &views[viewed], PyBUF_SIMPLE) < 0) {
+                goto error;
+            }
+            viewed++;
+            if (lengths_seq != NULL) {
+                length = PyLong_AsSsize_t(PySequence_Fast_GET_ITEM(lengths_seq, base + buffered));
+                if (length < 0) {
+                    if (!PyErr_Occurred()) {
+                        PyErr_SetString(PyExc_ValueError, "lengths should not be negative.");
+                    }
+                    goto error;
+                }
+            }
+            Ppmd8_Init(&models[buffered], maximum_order, restore_method);
+            if (!Ppmd8Batch_Init(&streams[buffered], &models[buffered],
+                                 views[buffered].buf, views[buffered].len)) {
+                PyErr_SetString(PyExc_ValueError, "Corrupted input data.");
+                goto error;
+            }
+            if (OutputBuffer_InitEstimate(&buffers[buffered], &streams[buffered].out, length,
+                                          OutputBuffer_Estimate(views[buffered].len, 0, 0), 1) < 0) {
+                goto error;
+            }
+            if (length == 0) {
+                streams[buffered].result = PPMD_RESULT_LIMIT;
+            }
+            buffered++;
+        }
+
+        for (;;) {
+            int pending = 0;
+            Py_BEGIN_ALLOW_THREADS
+            Ppmd8Batch_Decode(streams, (unsigned) count);
+            Py_END_ALLOW_THREADS
+            for (i = 0; i < count; i++) {
+                if (streams[i].result != 0) {
+                    continue;
+                }
+                if (OutputBuffer_ReachedMaxLength(&buffers[i], &streams[i].out)) {
+                    streams[i].result = PPMD_RESULT_LIMIT;
+                    continue;
+                }
+                if (OutputBuffer_Grow(&buffers[i], &streams[i].out) < 0) {
+                    goto error;
+                }
+                pending = 1;
+            }
+            if (!pending) {
+                break;
+            }
+        }
+
+        for (i = 0; i < count; i++) {
+            if (streams[i].result == PPMD_RESULT_ERROR) {
+                PyErr_SetString(PyExc_ValueError, "Corrupted input data.");
+                goto error;
+            }
+        }
+        for (; finished < count; finished++) {
+            PyObject *decoded = OutputBuffer_Finish(&buffers[finished], &streams[finished].out);
+            if (decoded == NULL) {
+                goto error;
+            }
+            PyList_SET_ITEM(ret, base + finished, decoded);
+        }
+        for (i = 0; i < viewed; i++) {
+            PyBuffer_Release(&views[i]);
+        }
+        viewed = buffered = finished = 0;
+    }
+    goto done;
+
+error:
+    for (i = finished; i < buffered; i++) {
+        OutputBuffer_OnError(&buffers[i]);
+    }
+    for (i = 0; i < viewed; i++) {
+        PyBuffer_Release(&views[i]);
+    }
+    Py_CLEAR(ret);
+done:
+    for (i = 0; i < allocated; i++) {
+        Ppmd8_Free(&models[i], &allocator);
+    }
+    PyMem_Free(models);
+    Py_XDECREF(lengths_seq);
+    Py_DECREF(datas_seq);
+    return ret;
+}
+
+/* -----------------------
+     7z coder properties code
+   ------------------------ */
+
+PyDoc_STRVAR(ppmd7_props_doc, "ppmd7_props(max_order, mem_size)\n"
+"----\n"
+"Return the 5 byte PPMd coder properties 7z stores for a folder: max order in\n"
+"the first byte, memory size as 32-bit little endian in the next four.");
+
+static PyObject *
+ppmd7_props(PyObject *module, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {"max_order", "mem_size", NULL};
+    unsigned long max_order, mem_size;
+    Byte props[PPMD7_PROPS_SIZE];
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "kk:ppmd7_props", kwlist, &max_order, &mem_size)) {
+        return NULL;
+    }
+    if (max_order < PPMD7_MIN_ORDER || max_order > PPMD7_MAX_ORDER
+        || mem_size < PPMD7_MIN_MEM_SIZE || mem_size > PPMD7_MAX_MEM_SIZE) {
+        PyErr_SetString(PyExc_ValueError, ppmd7_props_msg);
+        return NULL;
+    }
+    Ppmd7_WriteProps(props, (unsigned)max_order, (UInt32)mem_size);
+    return PyBytes_FromStringAndSize((const char *)props, PPMD7_PROPS_SIZE);
+}
+
+PyDoc_STRVAR(parse_ppmd7_props_doc, "parse_ppmd7_props(props)\n"
+"----\n"
+"Return (max_order, mem_size) from 5 byte PPMd coder properties of a 7z folder.\n"
+"Raise ValueError when the size or a value is out of range.");
+
+static PyObject *
+parse_ppmd7_props(PyObject *module, PyObject *props)
+{
+    unsigned max_order;
+    UInt32 mem_size;
+    if (ppmd7_props_parse(props, &max_order, &mem_size) < 0) {
+        return NULL;
+    }
+    return Py_BuildValue("(Ik)", max_order, (unsigned long)mem_size);
+}
+
+/* -----------------------
+     cpu_features code
+   ------------------------ */
+
+PyDoc_STRVAR(cpu_features_doc, "cpu_features()\n"
+"----\n"
+"Return a dict of the SIMD extensions detected on the running CPU and the name\n"
+"of the kernels selected for the escape path frequency scans under 'kernel'.\n"
+"The PYPPMD_KERNEL environment variable caps the selection at import time.");
+
+static PyObject *
+cpu_features(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    UInt32 features = Ppmd_GetCpuFeatures();
+    return Py_BuildValue("{sOsOsOsOss}",
+                         "ssse3", (features & PPMD_CPU_SSSE3) ? Py_True : Py_False,
+                         "avx2", (features & PPMD_CPU_AVX2) ? Py_True : Py_False,
+                         "avx512bw", (features & PPMD_CPU_AVX512BW) ? Py_True : Py_False,
+                         "neon", (features & PPMD_CPU_NEON) ? Py_True : Py_False,
+                         "kernel", Ppmd_KernelName());
+}
+
 /* --------------------
      Initialize code
    -------------------- */
 
 static PyMethodDef _ppmd_methods[] = {
+    {"decompress_many", (PyCFunction)decompress_many,
+     METH_VARARGS|METH_KEYWORDS, decompress_many_doc},
+    {"cpu_features", (PyCFunction)cpu_features,
+     METH_NOARGS, cpu_features_doc},
+    {"ppmd7_props", (PyCFunction)ppmd7_props,
+     METH_VARARGS|METH_KEYWORDS, ppmd7_props_doc},
+    {"parse_ppmd7_props", (PyCFunction)parse_ppmd7_props,
+     METH_O, parse_ppmd7_props_doc},
     {NULL}
 };
 
@@ -1716,8 +2342,15 @@ PyInit__ppmd(void) {
     if (!module) {
         goto error;
     }
+    /* select the kernels once, before any coder can run */
+    Ppmd_SelectKernels(Ppmd_GetCpuFeatures() & Ppmd_KernelFeatures(getenv("PYPPMD_KERNEL")));
     PyModule_AddIntConstant(module, "PPMD8_RESTORE_METHOD_RESTART", 0);
     PyModule_AddIntConstant(module, "PPMD8_RESTORE_METHOD_CUT_OFF", 1);
+    PyModule_AddIntConstant(module, "PPMD8_RESTORE_METHOD_REPLAY", 4);
+    PyModule_AddIntConstant(module, "PPMD8_FILTER_NONE", PPMD_FILTER_NONE);
+    PyModule_AddIntConstant(module, "PPMD8_FILTER_DELTA", PPMD_FILTER_DELTA);
+    PyModule_AddIntConstant(module, "PPMD8_FILTER_X86", PPMD_FILTER_X86);
+    PyModule_AddIntConstant(module, "PPMD8_FILTER_TRANSPOSE", PPMD_FILTER_TRANSPOSE);
     // #ifdef PPMD8_FREEZE_SUPPORT
     // PyModule_AddIntConstant(module, "PPMD8_RESTORE_METHOD_FREEZE", 2);
     // #endif
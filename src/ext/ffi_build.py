@@ -72,6 +72,14 @@ typedef struct
   UInt16 SuccessorLow;
   UInt16 SuccessorHigh;
 } CPpmd_State;
+typedef struct
+{
+  UInt32 Restarts;
+  UInt32 CutOffs;
+  UInt32 Glues;
+  UInt32 Rescales;
+  UInt32 PeakUsed;
+} CPpmd_Stats;
 """
 
 if is_64bit():
@@ -110,12 +118,14 @@ typedef struct
   Byte NS2Indx[256], NS2BSIndx[256], HB2Flag[256];
   CPpmd_See DummySee, See[25][16];
   UInt16 BinSumm[128][64];
+  CPpmd_Stats Stats;
 } CPpmd7;
 typedef struct
 {
   UInt32 Range;
   UInt32 Code;
   IByteIn *Stream;
+  ...;
 } CPpmd7z_RangeDec;
 typedef struct
 {
@@ -124,6 +134,7 @@ typedef struct
   Byte Cache;
   UInt64 CacheSize;
   IByteOut *Stream;
+  ...;
 } CPpmd7z_RangeEnc;
 """
 
@@ -174,6 +185,8 @@ typedef struct
   Byte NS2BSIndx[256], NS2Indx[260];
   CPpmd_See DummySee, See[24][32];
   UInt16 BinSumm[25][64];
+  CPpmd_Stats Stats;
+  ...;
 } CPpmd8;
 """
 
@@ -226,6 +239,64 @@ int Ppmd8T_decode(CPpmd8 *cPpmd8, OutBuffer *out, int max_length, ppmd_info *arg
 void Ppmd8T_Free(CPpmd8 *cPpmd8, ppmd_info *args, IAlloc *allocator);
 """
 
+# BatchDecoder.h
+defs += r"""
+#define PPMD_BATCH_MAX_WIDTH ...
+#define PPMD_RESULT_EOF ...
+#define PPMD_RESULT_ERROR ...
+#define PPMD_RESULT_LIMIT ...
+
+typedef struct {
+    Byte (*Read)(void *p);
+    InBuffer *inBuffer;
+    ...;
+} BatchReader;
+
+typedef struct {
+    CPpmd8 *cPpmd8;
+    BatchReader reader;
+    InBuffer in;
+    OutBuffer out;
+    int result;
+} Ppmd8BatchStream;
+
+Bool Ppmd8Batch_Init(Ppmd8BatchStream *stream, CPpmd8 *cPpmd8, const void *src, size_t size);
+void Ppmd8Batch_Decode(Ppmd8BatchStream *streams, unsigned count);
+"""
+
+# Filter.h
+defs += r"""
+#define PPMD_FILTER_NONE ...
+#define PPMD_FILTER_DELTA ...
+#define PPMD_FILTER_X86 ...
+#define PPMD_FILTER_TRANSPOSE ...
+
+typedef struct {
+    int kind;
+    unsigned param;
+    Byte *buf;
+    ...;
+} PpmdFilter;
+
+Bool PpmdFilter_Init(PpmdFilter *f, int kind, unsigned param, IAlloc *alloc);
+void PpmdFilter_Free(PpmdFilter *f, IAlloc *alloc);
+void PpmdFilter_EncodeEnd(PpmdFilter *f);
+"""
+
+# CpuArch.h
+# PpmdMask.h
+defs += r"""
+#define PPMD_CPU_SSSE3 ...
+#define PPMD_CPU_AVX2 ...
+#define PPMD_CPU_AVX512BW ...
+#define PPMD_CPU_NEON ...
+
+UInt32 Ppmd_GetCpuFeatures(void);
+void Ppmd_SelectKernels(UInt32 features);
+const char *Ppmd_KernelName(void);
+UInt32 Ppmd_KernelFeatures(const char *name);
+"""
+
 # ----------- python binding API ---------------------
 defs += r"""
 extern "Python" void *raw_alloc(size_t);
@@ -260,6 +331,7 @@ int ppmd7_decompress(CPpmd7 *p, CPpmd7z_RangeDec *rc, OutBuffer *out_buf, InBuff
 
 void Ppmd7_Construct(CPpmd7 *p);
 void Ppmd7_Init(CPpmd7 *p, unsigned maxOrder);
+UInt32 Ppmd7_GetUsedMemory(const CPpmd7 *p);
 int Ppmd7_DecodeSymbol(CPpmd7 *p, CPpmd7z_RangeDec *rc);
 
 void Ppmd7z_RangeEnc_Init(CPpmd7z_RangeEnc *p);
@@ -270,11 +342,15 @@ void ppmd8_compress_init(CPpmd8 *ppmd, BufferWriter *writer);
 int ppmd8_compress(CPpmd8 *ppmd, OutBuffer *out_buf, InBuffer *in_buf);
 void ppmd8_decompress_init(CPpmd8 *ppmd, BufferReader *reader, ppmd_info *threadInfo, IAlloc *allocator);
 int ppmd8_decompress(CPpmd8 *ppmd, OutBuffer *out_buf, InBuffer *in_buf, int length, ppmd_info *threadInfo);
+int ppmd8_compress_filtered(CPpmd8 *ppmd, PpmdFilter *f, OutBuffer *out_buf, InBuffer *in_buf);
+int ppmd8_decompress_filtered(CPpmd8 *ppmd, PpmdFilter *f, OutBuffer *stage, int *state,
+                              OutBuffer *out_buf, InBuffer *in_buf, int length, ppmd_info *threadInfo);
 
 void Ppmd8_Construct(CPpmd8 *ppmd);
 Bool Ppmd8_Alloc(CPpmd8 *p, UInt32 size, IAlloc *alloc);
 void Ppmd8_Free(CPpmd8 *p, IAlloc *alloc);
 void Ppmd8_Init(CPpmd8 *ppmd, unsigned maxOrder, unsigned restoreMethod);
+UInt32 Ppmd8_GetUsedMemory(const CPpmd8 *p);
 void Ppmd8_EncodeSymbol(CPpmd8 *ppmd, int symbol);
 void Ppmd8_RangeEnc_Init(CPpmd8 *ppmd);
 void Ppmd8_RangeEnc_FlushData(CPpmd8 *ppmd);
@@ -287,9 +363,14 @@ source = r"""
 #include "Ppmd8.h"
 #include "Buffer.h"
 #include "ThreadDecoder.h"
+#include "BatchDecoder.h"
+#include "Filter.h"
+#include "PpmdMask.h"
+#include "CpuArch.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef _WIN32
 #include "win_pthreads.h"
@@ -335,6 +416,12 @@ int ppmd7_compress(CPpmd7 *p, CPpmd7z_RangeEnc *rc, OutBuffer *out_buf, InBuffer
     Byte* c = (Byte *) in_buf->src + in_buf->pos;
     const Byte* in_end = (Byte *)in_buf->src + in_buf->size;
     while (c < in_end) {
+        if (Ppmd7_InRun(p)) {
+            c += Ppmd7_EncodeRun(p, rc, c, in_end - c);
+            if (c == in_end) {
+                break;
+            }
+        }
         Ppmd7_EncodeSymbol(p, rc, *c++);
         if (out_buf->pos >= out_buf->size) {
             break;
@@ -367,6 +454,12 @@ int ppmd8_compress(CPpmd8 *ppmd, OutBuffer *out_buf, InBuffer *in_buf) {
     Byte* pos = (Byte *) in_buf->src + in_buf->pos;
     const Byte* in_end = (Byte *)in_buf->src + in_buf->size;
     while (pos < in_end) {
+        if (Ppmd8_InRun(ppmd)) {
+            pos += Ppmd8_EncodeRun(ppmd, pos, in_end - pos);
+            if (pos == in_end) {
+                break;
+            }
+        }
         Byte c = *pos++;
         Ppmd8_EncodeSymbol(ppmd, c);
         if (out_buf->pos >= out_buf->size) {
@@ -390,6 +483,68 @@ int ppmd8_decompress(CPpmd8 *ppmd, OutBuffer *out_buf, InBuffer *in_buf, int len
     info->in = in_buf;
     return Ppmd8T_decode(ppmd, out_buf, length, info);
 }
+
+/* returns 0 once all of in_buf went through the filter and the coder */
+int ppmd8_compress_filtered(CPpmd8 *ppmd, PpmdFilter *f, OutBuffer *out_buf, InBuffer *in_buf) {
+    while (out_buf->pos < out_buf->size) {
+        InBuffer chunk;
+        if (PpmdFilter_Ready(f) == 0) {
+            if (in_buf->pos == in_buf->size) {
+                return 0;
+            }
+            in_buf->pos += PpmdFilter_Encode(f, (const Byte *)in_buf->src + in_buf->pos, in_buf->size - in_buf->pos);
+        }
+        chunk.src = PpmdFilter_Data(f);
+        chunk.size = PpmdFilter_Ready(f);
+        chunk.pos = 0;
+        ppmd8_compress(ppmd, out_buf, &chunk);
+        PpmdFilter_Skip(f, chunk.pos);
+    }
+    return 1;
+}
+
+#define FILTERED_END 1
+#define FILTERED_WAITING 2
+
+/* The coder decodes to stage, which the filter provides; returns the bytes
+   moved to out_buf, -1 when all output is out or -2 on corrupted input.
+   state keeps whether the end mark was met or the coder waits for input. */
+int ppmd8_decompress_filtered(CPpmd8 *ppmd, PpmdFilter *f, OutBuffer *stage, int *state,
+                              OutBuffer *out_buf, InBuffer *in_buf, int length, ppmd_info *info) {
+    int done = 0;
+    int result;
+    info->in = in_buf;
+    info->out = stage;
+    if (*state == FILTERED_WAITING && in_buf->pos < in_buf->size) {
+        *state = 0;
+    }
+    while (done < length && out_buf->pos < out_buf->size) {
+        size_t n = PpmdFilter_Ready(f);
+        size_t room;
+        if (n != 0) {
+            n = n < out_buf->size - out_buf->pos ? n : out_buf->size - out_buf->pos;
+            n = n < (size_t)(length - done) ? n : (size_t)(length - done);
+            memcpy((Byte *)out_buf->dst + out_buf->pos, PpmdFilter_Data(f), n);
+            PpmdFilter_Skip(f, n);
+            out_buf->pos += n;
+            done += (int)n;
+            continue;
+        }
+        if (*state != 0) {
+            break;
+        }
+        stage->dst = PpmdFilter_Space(f, &room);
+        stage->pos = 0;
+        stage->size = PpmdFilter_InBlocks(f) || room < (size_t)(length - done) ? room : (size_t)(length - done);
+        result = Ppmd8T_decode(ppmd, stage, (int)stage->size, info);
+        if (result == -2) {
+            return -2;
+        }
+        PpmdFilter_Decode(f, stage->pos, result == -1);
+        *state = result == -1 ? FILTERED_END : result == 0 ? FILTERED_WAITING : 0;
+    }
+    return done == 0 && *state == FILTERED_END && PpmdFilter_Ready(f) == 0 ? -1 : done;
+}
 """
 
 
@@ -415,8 +570,12 @@ if __name__ == "__main__":
             "src/lib/ppmd/Ppmd7Enc.c",
             "src/lib/ppmd/Ppmd8Enc.c",
             "src/lib/ppmd/Ppmd7Dec.c",
+            "src/lib/ppmd/PpmdMask.c",
+            "src/lib/ppmd/CpuArch.c",
             "src/lib/buffer/Buffer.c",
             "src/lib/buffer/ThreadDecoder.c",
+            "src/lib/buffer/BatchDecoder.c",
+            "src/lib/buffer/Filter.c",
         ],
         "define_macros": [],
         "module_name": "pyppmd.cffi._cffi_ppmd",
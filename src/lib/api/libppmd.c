@@ -0,0 +1,395 @@
+//
+// libppmd.c -- streaming C API over the PPMd7 (var.H) and PPMd8 (var.I) engines
+//
+
+#include "libppmd.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Ppmd7.h"
+#include "Ppmd8.h"
+#include "PpmdMask.h"
+
+/* Bytes a single symbol can take from the input: every escape to a shorter
+   context costs one range decoder step of at most four bytes, and there are
+   at most PPMD7_MAX_ORDER + 1 escapes before the end marker. */
+#define DECODE_MARGIN 512
+
+typedef struct {
+    /* Inherits from IByteOut */
+    void (*Write)(const IByteOut *p, Byte b);
+    ppmd_buffer *out;
+    /* bytes that did not fit into out, written ahead of anything else */
+    Byte *pending;
+    size_t pendingPos;
+    size_t pendingSize;
+    size_t pendingCapacity;
+    Bool failed;
+} StreamWriter;
+
+typedef struct {
+    /* Inherits from IByteIn */
+    Byte (*Read)(const IByteIn *p);
+    const Byte *cur;
+    const Byte *end;
+    /* the carry buffer is read first, then the caller's input */
+    Bool inCaller;
+    ppmd_buffer *in;
+    Bool overrun;
+    Byte carry[DECODE_MARGIN];
+    size_t carryPos;
+    size_t carrySize;
+} StreamReader;
+
+struct ppmd_stream_s {
+    ppmd_params params;
+    Bool decoder;
+    Bool started;
+    Bool flushed;
+    int result;
+    CPpmd7 ppmd7;
+    CPpmd8 ppmd8;
+    CPpmd7z_RangeEnc rangeEnc;
+    CPpmd7z_RangeDec rangeDec;
+    StreamWriter writer;
+    StreamReader reader;
+};
+
+static const IAlloc allocator = {malloc, free};
+
+static void Stream_Write(const IByteOut *p, Byte b)
+{
+    StreamWriter *w = (StreamWriter *)p;
+    ppmd_buffer *out = w->out;
+    if (w->pendingSize == 0 && out->pos < out->size) {
+        ((Byte *)out->data)[out->pos++] = b;
+        return;
+    }
+    if (w->pendingSize == w->pendingCapacity) {
+        size_t capacity = w->pendingCapacity ? w->pendingCapacity * 2 : DECODE_MARGIN;
+        Byte *pending = (Byte *)realloc(w->pending, capacity);
+        if (pending == NULL) {
+            w->failed = True;
+            return;
+        }
+        w->pending = pending;
+        w->pendingCapacity = capacity;
+    }
+    w->pending[w->pendingSize++] = b;
+}
+
+static void Stream_Drain(StreamWriter *w, ppmd_buffer *out)
+{
+    size_t n = w->pendingSize - w->pendingPos;
+    if (n > out->size - out->pos)
+        n = out->size - out->pos;
+    if (n == 0)
+        return;
+    memcpy((Byte *)out->data + out->pos, w->pending + w->pendingPos, n);
+    out->pos += n;
+    w->pendingPos += n;
+    if (w->pendingPos == w->pendingSize)
+        w->pendingPos = w->pendingSize = 0;
+}
+
+static Byte Stream_Read(const IByteIn *p)
+{
+    StreamReader *r = (StreamReader *)p;
+    if (r->cur != r->end)
+        return *r->cur++;
+    if (!r->inCaller) {
+        r->inCaller = True;
+        r->cur = (const Byte *)r->in->data + r->in->pos;
+        r->end = (const Byte *)r->in->data + r->in->size;
+        if (r->cur != r->end)
+            return *r->cur++;
+    }
+    r->overrun = True;
+    return 0;
+}
+
+static void Reader_Begin(StreamReader *r, ppmd_buffer *in)
+{
+    r->in = in;
+    r->overrun = False;
+    r->inCaller = (r->carryPos == r->carrySize);
+    if (r->inCaller) {
+        r->carryPos = r->carrySize = 0;
+        r->cur = (const Byte *)in->data + in->pos;
+        r->end = (const Byte *)in->data + in->size;
+    } else {
+        r->cur = r->carry + r->carryPos;
+        r->end = r->carry + r->carrySize;
+    }
+}
+
+static size_t Reader_Available(const StreamReader *r)
+{
+    size_t n = (size_t)(r->end - r->cur);
+    if (!r->inCaller)
+        n += r->in->size - r->in->pos;
+    return n;
+}
+
+/* Writes the read positions back; with keep set the unread rest, which is
+   shorter than DECODE_MARGIN, moves into the carry buffer. */
+static void Reader_End(StreamReader *r, Bool keep)
+{
+    ppmd_buffer *in = r->in;
+    if (r->inCaller) {
+        r->carryPos = r->carrySize = 0;
+        in->pos = (size_t)(r->cur - (const Byte *)in->data);
+    } else {
+        r->carryPos = (size_t)(r->cur - r->carry);
+    }
+    if (keep) {
+        size_t rest = r->carrySize - r->carryPos;
+        memmove(r->carry, r->carry + r->carryPos, rest);
+        if (in->size > in->pos)
+            memcpy(r->carry + rest, (const Byte *)in->data + in->pos, in->size - in->pos);
+        r->carryPos = 0;
+        r->carrySize = rest + in->size - in->pos;
+        in->pos = in->size;
+    }
+}
+
+void ppmd_params_default(ppmd_params *params, int variant)
+{
+    params->variant = variant;
+    params->max_order = 6;
+    params->mem_size = 16 << 20;
+    params->restore_method = PPMD_RESTORE_METHOD_RESTART;
+    params->endmark = (variant == PPMD_VARIANT_I);
+}
+
+static ppmd_stream *stream_create(const ppmd_params *params, Bool decoder)
+{
+    ppmd_stream *s;
+    unsigned max_order_limit;
+    Bool allocated;
+    if (params == NULL)
+        return NULL;
+    if (params->variant == PPMD_VARIANT_H)
+        max_order_limit = PPMD7_MAX_ORDER;
+    else if (params->variant == PPMD_VARIANT_I)
+        max_order_limit = PPMD8_MAX_ORDER;
+    else
+        return NULL;
+    if (params->variant == PPMD_VARIANT_I && params->restore_method != PPMD_RESTORE_METHOD_RESTART &&
+        params->restore_method != PPMD_RESTORE_METHOD_CUTOFF && params->restore_method != PPMD_RESTORE_METHOD_REPLAY)
+        return NULL;
+    s = (ppmd_stream *)calloc(1, sizeof(ppmd_stream));
+    if (s == NULL)
+        return NULL;
+    s->params = *params;
+    if (s->params.max_order < PPMD7_MIN_ORDER)
+        s->params.max_order = PPMD7_MIN_ORDER;
+    else if (s->params.max_order > max_order_limit)
+        s->params.max_order = max_order_limit;
+    if (s->params.mem_size < PPMD7_MIN_MEM_SIZE)
+        s->params.mem_size = PPMD7_MIN_MEM_SIZE;
+    else if (s->params.mem_size > PPMD7_MAX_MEM_SIZE)
+        s->params.mem_size = PPMD7_MAX_MEM_SIZE;
+    s->decoder = decoder;
+    s->writer.Write = Stream_Write;
+    s->reader.Read = Stream_Read;
+    if (s->params.variant == PPMD_VARIANT_H) {
+        Ppmd7_Construct(&s->ppmd7);
+        allocated = Ppmd7_Alloc(&s->ppmd7, (CPpmd_Size)s->params.mem_size, &allocator);
+        if (allocated)
+            Ppmd7_Init(&s->ppmd7, s->params.max_order);
+        s->rangeEnc.Stream = (IByteOut *)&s->writer;
+        s->rangeDec.Stream = (IByteIn *)&s->reader;
+        if (!decoder)
+            Ppmd7z_RangeEnc_Init(&s->rangeEnc);
+    } else {
+        Ppmd8_Construct(&s->ppmd8);
+        allocated = Ppmd8_Alloc(&s->ppmd8, (CPpmd_Size)s->params.mem_size, &allocator);
+        if (allocated)
+            Ppmd8_Init(&s->ppmd8, s->params.max_order, s->params.restore_method);
+        if (decoder) {
+            s->ppmd8.Stream.In = (IByteIn *)&s->reader;
+        } else {
+            s->ppmd8.Stream.Out = (IByteOut *)&s->writer;
+            Ppmd8_RangeEnc_Init(&s->ppmd8);
+        }
+    }
+    if (!allocated) {
+        ppmd_free(s);
+        return NULL;
+    }
+    return s;
+}
+
+ppmd_stream *ppmd_encoder_create(const ppmd_params *params)
+{
+    return stream_create(params, False);
+}
+
+ppmd_stream *ppmd_decoder_create(const ppmd_params *params)
+{
+    return stream_create(params, True);
+}
+
+int ppmd_encode_chunk(ppmd_stream *stream, ppmd_buffer *in, ppmd_buffer *out)
+{
+    StreamWriter *w;
+    const Byte *c, *in_end;
+    if (stream == NULL || stream->decoder || stream->flushed || in == NULL || out == NULL)
+        return PPMD_ERROR_PARAM;
+    w = &stream->writer;
+    w->out = out;
+    Stream_Drain(w, out);
+    c = (const Byte *)in->data + in->pos;
+    in_end = (const Byte *)in->data + in->size;
+    if (stream->params.variant == PPMD_VARIANT_H) {
+        while (c < in_end && out->pos < out->size && w->pendingSize == 0) {
+            if (Ppmd7_InRun(&stream->ppmd7))
+                c += Ppmd7_EncodeRun(&stream->ppmd7, &stream->rangeEnc, c, (size_t)(in_end - c));
+            if (c < in_end)
+                Ppmd7_EncodeSymbol(&stream->ppmd7, &stream->rangeEnc, *c++);
+        }
+    } else {
+        while (c < in_end && out->pos < out->size && w->pendingSize == 0) {
+            if (Ppmd8_InRun(&stream->ppmd8))
+                c += Ppmd8_EncodeRun(&stream->ppmd8, c, (size_t)(in_end - c));
+            if (c < in_end)
+                Ppmd8_EncodeSymbol(&stream->ppmd8, *c++);
+        }
+    }
+    in->pos = (size_t)(c - (const Byte *)in->data);
+    return w->failed ? PPMD_ERROR_MEMORY : PPMD_OK;
+}
+
+int ppmd_flush(ppmd_stream *stream, ppmd_buffer *out)
+{
+    StreamWriter *w;
+    if (stream == NULL || stream->decoder || out == NULL)
+        return PPMD_ERROR_PARAM;
+    w = &stream->writer;
+    w->out = out;
+    Stream_Drain(w, out);
+    if (!stream->flushed) {
+        stream->flushed = True;
+        if (stream->params.variant == PPMD_VARIANT_H) {
+            if (stream->params.endmark)
+                Ppmd7_EncodeSymbol(&stream->ppmd7, &stream->rangeEnc, -1);
+            Ppmd7z_RangeEnc_FlushData(&stream->rangeEnc);
+        } else {
+            if (stream->params.endmark)
+                Ppmd8_EncodeSymbol(&stream->ppmd8, -1);
+            Ppmd8_RangeEnc_FlushData(&stream->ppmd8);
+        }
+    }
+    if (w->failed)
+        return PPMD_ERROR_MEMORY;
+    return w->pendingSize == 0 ? PPMD_OK : PPMD_MORE_OUTPUT;
+}
+
+int ppmd_decode_chunk(ppmd_stream *stream, ppmd_buffer *in, ppmd_buffer *out, int last_input)
+{
+    StreamReader *r;
+    Byte *dst, *dst_end;
+    Bool keep = False;
+    if (stream == NULL || !stream->decoder || in == NULL || out == NULL)
+        return PPMD_ERROR_PARAM;
+    if (stream->result != PPMD_OK)
+        return stream->result;
+    r = &stream->reader;
+    Reader_Begin(r, in);
+    if (!stream->started) {
+        Bool ok;
+        if (!last_input && Reader_Available(r) < DECODE_MARGIN) {
+            Reader_End(r, True);
+            return PPMD_OK;
+        }
+        stream->started = True;
+        if (stream->params.variant == PPMD_VARIANT_H)
+            ok = Ppmd7z_RangeDec_Init(&stream->rangeDec);
+        else
+            ok = Ppmd8_RangeDec_Init(&stream->ppmd8);
+        if (!ok || r->overrun) {
+            Reader_End(r, False);
+            return stream->result = PPMD_ERROR_DATA;
+        }
+    }
+    dst = (Byte *)out->data + out->pos;
+    dst_end = (Byte *)out->data + out->size;
+    while (dst < dst_end) {
+        int sym;
+        if (!last_input && Reader_Available(r) < DECODE_MARGIN) {
+            keep = True;
+            break;
+        }
+        if (stream->params.variant == PPMD_VARIANT_H)
+            sym = Ppmd7_DecodeSymbol(&stream->ppmd7, &stream->rangeDec);
+        else
+            sym = Ppmd8_DecodeSymbol(&stream->ppmd8);
+        if (r->overrun || sym < -1) {
+            stream->result = PPMD_ERROR_DATA;
+            break;
+        }
+        if (sym < 0) {
+            stream->result = PPMD_STREAM_END;
+            break;
+        }
+        *dst++ = (Byte)sym;
+        /* a run reads no input, so it needs no margin */
+        if (stream->params.variant == PPMD_VARIANT_H) {
+            if (Ppmd7_InRun(&stream->ppmd7))
+                dst += Ppmd7_DecodeRun(&stream->ppmd7, &stream->rangeDec, dst, (size_t)(dst_end - dst));
+        } else if (Ppmd8_InRun(&stream->ppmd8)) {
+            dst += Ppmd8_DecodeRun(&stream->ppmd8, dst, (size_t)(dst_end - dst));
+        }
+    }
+    out->pos = (size_t)(dst - (Byte *)out->data);
+    Reader_End(r, keep);
+    return stream->result;
+}
+
+void ppmd_free(ppmd_stream *stream)
+{
+    if (stream == NULL)
+        return;
+    if (stream->params.variant == PPMD_VARIANT_H)
+        Ppmd7_Free(&stream->ppmd7, &allocator);
+    else
+        Ppmd8_Free(&stream->ppmd8, &allocator);
+    free(stream->writer.pending);
+    free(stream);
+}
+
+const char *ppmd_kernel_name(void)
+{
+    return Ppmd_KernelName();
+}
+
+int ppmd_format(void)
+{
+#ifdef PPMD_WIDE_REF
+    return PPMD_FORMAT_WIDE_REF;
+#else
+    return PPMD_FORMAT_STANDARD;
+#endif
+}
+
+const char *ppmd_error_string(int code)
+{
+    switch (code) {
+    case PPMD_OK:
+        return "no error";
+    case PPMD_STREAM_END:
+        return "end of stream";
+    case PPMD_MORE_OUTPUT:
+        return "output buffer is full";
+    case PPMD_ERROR_PARAM:
+        return "invalid argument";
+    case PPMD_ERROR_MEMORY:
+        return "out of memory";
+    case PPMD_ERROR_DATA:
+        return "corrupt or truncated data";
+    default:
+        return "unknown error";
+    }
+}
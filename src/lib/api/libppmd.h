@@ -0,0 +1,109 @@
+//
+// libppmd.h -- streaming C API over the PPMd7 (var.H) and PPMd8 (var.I) engines
+//
+
+#ifndef LIBPPMD_H
+#define LIBPPMD_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32) && defined(LIBPPMD_SHARED)
+#  ifdef LIBPPMD_BUILD
+#    define PPMD_API __declspec(dllexport)
+#  else
+#    define PPMD_API __declspec(dllimport)
+#  endif
+#elif defined(__GNUC__) && defined(LIBPPMD_SHARED)
+#  define PPMD_API __attribute__((visibility("default")))
+#else
+#  define PPMD_API
+#endif
+
+#define PPMD_API_VERSION 1
+
+#define PPMD_VARIANT_H 7 /* PPMd7, as used by 7-Zip */
+#define PPMD_VARIANT_I 8 /* PPMd8 */
+
+#define PPMD_RESTORE_METHOD_RESTART 0
+#define PPMD_RESTORE_METHOD_CUTOFF 1
+#define PPMD_RESTORE_METHOD_REPLAY 4 /* PPMd8 only, 2 and 3 are taken by 7-Zip's FREEZE */
+
+/* model memory layouts, see ppmd_format() */
+#define PPMD_FORMAT_STANDARD 0
+#define PPMD_FORMAT_WIDE_REF 1  /* 64-bit references, mem_size up to 1 TiB */
+
+/* return codes */
+#define PPMD_OK 0
+#define PPMD_STREAM_END 1       /* decoder: the end marker was decoded */
+#define PPMD_MORE_OUTPUT 2      /* flush: out filled up, call again with more room */
+#define PPMD_ERROR_PARAM (-1)   /* invalid argument, or a call in the wrong direction */
+#define PPMD_ERROR_MEMORY (-2)
+#define PPMD_ERROR_DATA (-3)    /* corrupt or truncated input */
+
+typedef struct ppmd_params_s {
+    int variant;                /**< PPMD_VARIANT_H or PPMD_VARIANT_I */
+    unsigned max_order;         /**< clamped to 2..64 (H) or 2..16 (I) */
+    unsigned long mem_size;     /**< model memory in bytes, clamped like the Python bindings
+                                     (to 4 GiB, or 1 TiB with PPMD_FORMAT_WIDE_REF) */
+    unsigned restore_method;    /**< PPMD_RESTORE_METHOD_*; variant I only */
+    int endmark;                /**< encoder: write an end marker when flushing */
+} ppmd_params;
+
+typedef struct ppmd_buffer_s {
+    void *data;                 /**< start of buffer; read only for input */
+    size_t size;                /**< size of buffer */
+    size_t pos;                 /**< position where reading or writing stopped. Will be updated. */
+} ppmd_buffer;
+
+typedef struct ppmd_stream_s ppmd_stream;
+
+/* Fills params with the defaults of the Python encoders: order 6, 16 MiB,
+   restart, no end marker for variant H and an end marker for variant I. */
+PPMD_API void ppmd_params_default(ppmd_params *params, int variant);
+
+/* Both return NULL when the variant or restore method is unknown or the model memory
+   cannot be allocated. */
+PPMD_API ppmd_stream *ppmd_encoder_create(const ppmd_params *params);
+PPMD_API ppmd_stream *ppmd_decoder_create(const ppmd_params *params);
+
+/* Encodes in->data[in->pos..in->size) into out. Returns PPMD_OK; when out
+   fills up, in->pos stops short and the call is repeated with more room.
+   Output of any size is accepted, down to one byte. */
+PPMD_API int ppmd_encode_chunk(ppmd_stream *stream, ppmd_buffer *in, ppmd_buffer *out);
+
+/* Writes the end marker (if requested) and the final range coder bytes.
+   Returns PPMD_OK once everything is out, or PPMD_MORE_OUTPUT. No more data
+   can be encoded afterwards. */
+PPMD_API int ppmd_flush(ppmd_stream *stream, ppmd_buffer *out);
+
+/* Decodes from in into out until out is full, input runs low or the end
+   marker is reached. A symbol may need a few hundred bytes of input, so when
+   less than that remains it is kept inside the stream and in->pos moves to
+   the end; pass last_input with the final chunk to decode to the end of the
+   data. Returns PPMD_OK, PPMD_STREAM_END once the end marker is read, or
+   PPMD_ERROR_DATA for corrupt or truncated input. */
+PPMD_API int ppmd_decode_chunk(ppmd_stream *stream, ppmd_buffer *in, ppmd_buffer *out, int last_input);
+
+PPMD_API void ppmd_free(ppmd_stream *stream);
+
+PPMD_API const char *ppmd_error_string(int code);
+
+/* Name of the SIMD kernel set used for the frequency scans ("scalar", "ssse3",
+   "avx2", "avx512bw" or "neon"). The first call, or the first stream, picks
+   it for the CPU; call this once before creating streams on several threads. */
+PPMD_API const char *ppmd_kernel_name(void);
+
+/* PPMD_FORMAT_STANDARD, or PPMD_FORMAT_WIDE_REF for a library built with
+   PPMD_WIDE_REF. The model layout decides when the memory runs out, so
+   streams only decode with a library of the same format. */
+PPMD_API int ppmd_format(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBPPMD_H
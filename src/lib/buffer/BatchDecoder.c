@@ -0,0 +1,82 @@
+//
+// BatchDecoder.c -- interleaved decoding of independent PPMd8 streams
+//
+
+#include "BatchDecoder.h"
+
+static Byte Batch_Reader(const void *p) {
+    BatchReader *reader = (BatchReader *)p;
+    InBuffer *in = reader->inBuffer;
+    if (in->pos == in->size) {
+        reader->overrun = True;
+        return 0;
+    }
+    return *((const Byte *)in->src + in->pos++);
+}
+
+Bool Ppmd8Batch_Init(Ppmd8BatchStream *stream, CPpmd8 *cPpmd8, const void *src, size_t size) {
+    stream->cPpmd8 = cPpmd8;
+    stream->in.src = src;
+    stream->in.size = size;
+    stream->in.pos = 0;
+    stream->out.dst = NULL;
+    stream->out.size = 0;
+    stream->out.pos = 0;
+    stream->reader.Read = (Byte (*)(void *)) Batch_Reader;
+    stream->reader.inBuffer = &stream->in;
+    stream->reader.overrun = False;
+    cPpmd8->Stream.In = (IByteIn *) &stream->reader;
+    if (!Ppmd8_RangeDec_Init(cPpmd8) || stream->reader.overrun) {
+        stream->result = PPMD_RESULT_ERROR;
+        return False;
+    }
+    stream->result = 0;
+    return True;
+}
+
+static inline Bool Batch_Step(Ppmd8BatchStream *s) {
+    int sym;
+    if (s->result != 0 || s->out.pos == s->out.size) {
+        return False;
+    }
+    sym = Ppmd8_DecodeSymbol(s->cPpmd8);
+    if (s->reader.overrun) {
+        /* truncated input */
+        s->result = PPMD_RESULT_ERROR;
+    } else if (sym < 0) {
+        s->result = sym == -1 ? PPMD_RESULT_EOF : PPMD_RESULT_ERROR;
+    } else {
+        *((Byte *)s->out.dst + s->out.pos++) = (Byte)sym;
+        if (Ppmd8_InRun(s->cPpmd8))
+            s->out.pos += Ppmd8_DecodeRun(s->cPpmd8, (Byte *)s->out.dst + s->out.pos, s->out.size - s->out.pos);
+    }
+    return True;
+}
+
+void Ppmd8Batch_Decode(Ppmd8BatchStream *streams, unsigned count) {
+    Bool running = True;
+    unsigned i;
+    /* keep the common widths branch free of the generic loop */
+    if (count == 2) {
+        while (running) {
+            running = Batch_Step(&streams[0]);
+            running |= Batch_Step(&streams[1]);
+        }
+        return;
+    }
+    if (count == 4) {
+        while (running) {
+            running = Batch_Step(&streams[0]);
+            running |= Batch_Step(&streams[1]);
+            running |= Batch_Step(&streams[2]);
+            running |= Batch_Step(&streams[3]);
+        }
+        return;
+    }
+    while (running) {
+        running = False;
+        for (i = 0; i < count; i++) {
+            running |= Batch_Step(&streams[i]);
+        }
+    }
+}
@@ -0,0 +1,46 @@
+//
+// BatchDecoder.h -- interleaved decoding of independent PPMd8 streams
+//
+
+#ifndef PYPPMD_BATCHDECODER_H
+#define PYPPMD_BATCHDECODER_H
+
+#include "Buffer.h"
+#include "ThreadDecoder.h"
+
+/* Streams decoded together on one core. Each stream needs its own model,
+   so the caller bounds the memory use by choosing how many run at once. */
+#define PPMD_BATCH_MAX_WIDTH 4
+
+/* Output reached the length limit set by the caller. */
+#define PPMD_RESULT_LIMIT 1
+
+typedef struct {
+    /* Inherits from IByteIn */
+    Byte (*Read)(void *p);
+    InBuffer *inBuffer;
+    /* set when the decoder reads past the end of the input */
+    Bool overrun;
+} BatchReader;
+
+typedef struct {
+    CPpmd8 *cPpmd8;
+    BatchReader reader;
+    InBuffer in;
+    OutBuffer out;
+    /* 0 while decoding, PPMD_RESULT_EOF, PPMD_RESULT_ERROR or PPMD_RESULT_LIMIT */
+    int result;
+} Ppmd8BatchStream;
+
+/* Attaches a complete compressed stream to an allocated and initialized
+   cPpmd8 and starts the range decoder. The output buffer is set with
+   stream->out before decoding. Returns 0 when the stream header is invalid. */
+Bool Ppmd8Batch_Init(Ppmd8BatchStream *stream, CPpmd8 *cPpmd8, const void *src, size_t size);
+
+/* Decodes one symbol from each running stream in turn, so that the memory
+   stalls of the streams overlap. A stream stops on end marker, error or
+   a full output buffer; the function returns when no stream is running.
+   After growing the output buffers it can be called again. */
+void Ppmd8Batch_Decode(Ppmd8BatchStream *streams, unsigned count);
+
+#endif //PYPPMD_BATCHDECODER_H
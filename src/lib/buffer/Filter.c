@@ -0,0 +1,289 @@
+//
+// Filter.c -- reversible transforms of the data in front of the PPMd8 coder
+//
+
+#include <string.h>
+
+#include "Filter.h"
+#include "CpuArch.h"
+
+/* SSE2 is in the x86-64 baseline, NEON in the AArch64 one */
+#if defined(PPMD_SIMD_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PPMD_FILTER_SSE2
+#include <emmintrin.h>
+#elif defined(PPMD_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+Bool PpmdFilter_Init(PpmdFilter *f, int kind, unsigned param, IAllocPtr alloc) {
+    memset(f, 0, sizeof(*f));
+    f->kind = kind;
+    f->param = param;
+    switch (kind) {
+        case PPMD_FILTER_DELTA:
+            if (param < 1 || param > PPMD_FILTER_MAX_DISTANCE) {
+                return False;
+            }
+            break;
+        case PPMD_FILTER_X86:
+            if (param != 0) {
+                return False;
+            }
+            break;
+        case PPMD_FILTER_TRANSPOSE:
+            if (param < 2 || param > PPMD_FILTER_MAX_WIDTH) {
+                return False;
+            }
+            f->blockSize = PPMD_FILTER_BLOCK / param * param;
+            f->block = IAlloc_Alloc(alloc, f->blockSize);
+            if (f->block == NULL) {
+                return True;
+            }
+            f->buf = IAlloc_Alloc(alloc, f->blockSize);
+            return True;
+        default:
+            return False;
+    }
+    f->buf = IAlloc_Alloc(alloc, PPMD_FILTER_CHUNK);
+    return True;
+}
+
+void PpmdFilter_Free(PpmdFilter *f, IAllocPtr alloc) {
+    if (f->block != NULL) {
+        IAlloc_Free(alloc, f->block);
+        f->block = NULL;
+    }
+    if (f->buf != NULL) {
+        IAlloc_Free(alloc, f->buf);
+        f->buf = NULL;
+    }
+}
+
+/* dst[i] = a[i] - b[i], or + when add is set. dst may be a, and it may lie
+   16 or more bytes past b: the vectors go forward, so b is read after it was
+   written. */
+static void Delta_Bytes(Byte *dst, const Byte *a, const Byte *b, size_t n, Bool add) {
+    size_t i = 0;
+#if defined(PPMD_FILTER_SSE2)
+    for (; i + 16 <= n; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(const void *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(const void *)(b + i));
+        _mm_storeu_si128((__m128i *)(void *)(dst + i), add ? _mm_add_epi8(va, vb) : _mm_sub_epi8(va, vb));
+    }
+#elif defined(PPMD_SIMD_NEON)
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t va = vld1q_u8(a + i);
+        uint8x16_t vb = vld1q_u8(b + i);
+        vst1q_u8(dst + i, add ? vaddq_u8(va, vb) : vsubq_u8(va, vb));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = (Byte)(add ? a[i] + b[i] : a[i] - b[i]);
+    }
+}
+
+/* keeps the last distance bytes of the data seen so far */
+static void Delta_Remember(PpmdFilter *f, const Byte *data, size_t n) {
+    size_t d = f->param;
+    if (n >= d) {
+        memcpy(f->history, data + n - d, d);
+    } else {
+        memmove(f->history, f->history + n, d - n);
+        memcpy(f->history + d - n, data, n);
+    }
+}
+
+static void Delta_Encode(PpmdFilter *f, Byte *dst, const Byte *src, size_t n) {
+    size_t d = f->param;
+    size_t k = n < d ? n : d;
+    Delta_Bytes(dst, src, f->history, k, False);
+    if (n > d) {
+        Delta_Bytes(dst + d, src + d, src, n - d, False);
+    }
+    Delta_Remember(f, src, n);
+}
+
+static void Delta_Decode(PpmdFilter *f, Byte *data, size_t n) {
+    size_t d = f->param;
+    size_t k = n < d ? n : d;
+    Delta_Bytes(data, data, f->history, k, True);
+    if (n > d) {
+        if (d >= 16) {
+            Delta_Bytes(data + d, data + d, data, n - d, True);
+        } else {
+            size_t i;
+            for (i = d; i < n; i++) {
+                data[i] = (Byte)(data[i] + data[i - d]);
+            }
+        }
+    }
+    Delta_Remember(f, data, n);
+}
+
+/* index of the first E8 or E9 byte in p[i .. n), or n */
+static size_t X86_FindOpcode(const Byte *p, size_t i, size_t n) {
+#if defined(PPMD_FILTER_SSE2)
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i e9 = _mm_set1_epi8((char)0xE9);
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_or_si128(_mm_loadu_si128((const __m128i *)(const void *)(p + i)), one);
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, e9));
+        if (m != 0) {
+            while (!(m & 1)) {
+                m >>= 1;
+                i++;
+            }
+            return i;
+        }
+    }
+#elif defined(PPMD_SIMD_NEON)
+    const uint8x16_t one = vdupq_n_u8(1);
+    const uint8x16_t e9 = vdupq_n_u8(0xE9);
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t v = vceqq_u8(vorrq_u8(vld1q_u8(p + i), one), e9);
+        if (vmaxvq_u8(v) != 0) {
+            break;
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if ((p[i] | 1) == 0xE9) {
+            break;
+        }
+    }
+    return i;
+}
+
+/*
+  x86 CALL (E8) and JMP (E9) carry a 32-bit displacement from the end of the
+  instruction. Calls to one function from many places have different
+  displacements but one target, so the filter adds the position of the next
+  instruction, as the BCJ filter of 7-Zip does. Unlike BCJ it converts every
+  E8/E9 without looking at the operand first: the conversion then goes one
+  byte at a time, low byte first with the carry, and the decoder can undo it
+  without reading ahead. The opcode bytes themselves are left alone, so both
+  sides find the same ones.
+*/
+static void X86_Convert(PpmdFilter *f, Byte *dst, const Byte *src, size_t n, Bool encoding) {
+    UInt32 pos = f->pos;
+    unsigned operand = f->operand;
+    UInt32 offset = f->offset;
+    size_t i = 0;
+    while (i < n) {
+        if (operand != 0) {
+            UInt32 t = encoding ? (UInt32)src[i] + (offset & 0xFF) : (UInt32)src[i] - (offset & 0xFF);
+            dst[i] = (Byte)t;
+            offset = (offset >> 8) + ((t >> 8) & 1);
+            operand--;
+            i++;
+            pos++;
+        } else {
+            size_t j = X86_FindOpcode(src, i, n);
+            if (dst != src) {
+                memcpy(dst + i, src + i, j - i);
+            }
+            pos += (UInt32)(j - i);
+            i = j;
+            if (i == n) {
+                break;
+            }
+            dst[i] = src[i];
+            i++;
+            pos++;
+            operand = 4;
+            offset = pos + 4;
+        }
+    }
+    f->pos = pos;
+    f->operand = operand;
+    f->offset = offset;
+}
+
+/* src holds rows records of width bytes; dst receives its columns one after another */
+static void Transpose(Byte *dst, const Byte *src, size_t rows, size_t width) {
+    /* tiles keep the strided side within a few cache lines */
+    const size_t tile = 32;
+    size_t r0, c0, r, c;
+    for (r0 = 0; r0 < rows; r0 += tile) {
+        size_t r1 = r0 + tile < rows ? r0 + tile : rows;
+        for (c0 = 0; c0 < width; c0 += tile) {
+            size_t c1 = c0 + tile < width ? c0 + tile : width;
+            for (r = r0; r < r1; r++) {
+                for (c = c0; c < c1; c++) {
+                    dst[c * rows + r] = src[r * width + c];
+                }
+            }
+        }
+    }
+}
+
+/* moves the block to buf, the whole records transposed and the rest as it is */
+static void Transpose_Block(PpmdFilter *f, Bool encoding) {
+    size_t rows = f->fill / f->param;
+    size_t body = rows * f->param;
+    if (encoding) {
+        Transpose(f->buf, f->block, rows, f->param);
+    } else {
+        Transpose(f->buf, f->block, f->param, rows);
+    }
+    memcpy(f->buf + body, f->block + body, f->fill - body);
+    f->head = 0;
+    f->ready = f->fill;
+    f->fill = 0;
+}
+
+size_t PpmdFilter_Encode(PpmdFilter *f, const Byte *src, size_t size) {
+    size_t n;
+    f->head = f->ready = 0;
+    if (PpmdFilter_InBlocks(f)) {
+        n = f->blockSize - f->fill;
+        n = size < n ? size : n;
+        memcpy(f->block + f->fill, src, n);
+        f->fill += n;
+        if (f->fill == f->blockSize) {
+            Transpose_Block(f, True);
+        }
+        return n;
+    }
+    n = size < PPMD_FILTER_CHUNK ? size : PPMD_FILTER_CHUNK;
+    if (f->kind == PPMD_FILTER_DELTA) {
+        Delta_Encode(f, f->buf, src, n);
+    } else {
+        X86_Convert(f, f->buf, src, n, True);
+    }
+    f->ready = n;
+    return n;
+}
+
+void PpmdFilter_EncodeEnd(PpmdFilter *f) {
+    if (PpmdFilter_InBlocks(f) && f->fill != 0) {
+        Transpose_Block(f, True);
+    }
+}
+
+Byte *PpmdFilter_Space(PpmdFilter *f, size_t *size) {
+    f->head = f->ready = 0;
+    if (PpmdFilter_InBlocks(f)) {
+        *size = f->blockSize - f->fill;
+        return f->block + f->fill;
+    }
+    *size = PPMD_FILTER_CHUNK;
+    return f->buf;
+}
+
+void PpmdFilter_Decode(PpmdFilter *f, size_t n, Bool last) {
+    if (PpmdFilter_InBlocks(f)) {
+        f->fill += n;
+        if (f->fill == f->blockSize || (last && f->fill != 0)) {
+            Transpose_Block(f, False);
+        }
+        return;
+    }
+    if (f->kind == PPMD_FILTER_DELTA) {
+        Delta_Decode(f, f->buf, n);
+    } else {
+        X86_Convert(f, f->buf, f->buf, n, False);
+    }
+    f->head = 0;
+    f->ready = n;
+}
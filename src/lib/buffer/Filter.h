@@ -0,0 +1,77 @@
+//
+// Filter.h -- reversible transforms of the data in front of the PPMd8 coder
+//
+
+#ifndef PYPPMD_FILTER_H
+#define PYPPMD_FILTER_H
+
+#include "Buffer.h"
+
+/*
+  PPMd predicts a byte from the bytes right before it, which suits text but
+  not numeric tables or machine code. A filter rewrites the data so that
+  related bytes meet: differences of neighbouring samples (delta), absolute
+  call targets (x86) or the columns of fixed width records (transpose). The
+  encoder filters the input before coding it, the decoder applies the inverse
+  to its output. The coded stream carries no trace of the filter, so both
+  sides must use the same one.
+*/
+#define PPMD_FILTER_NONE 0
+#define PPMD_FILTER_DELTA 1      /* param: distance in bytes, 1..PPMD_FILTER_MAX_DISTANCE */
+#define PPMD_FILTER_X86 2        /* param: 0 */
+#define PPMD_FILTER_TRANSPOSE 3  /* param: record width in bytes, 2..PPMD_FILTER_MAX_WIDTH */
+
+#define PPMD_FILTER_MAX_DISTANCE 256
+#define PPMD_FILTER_MAX_WIDTH 4096
+
+/* delta and x86 filter the data in chunks of this size */
+#define PPMD_FILTER_CHUNK (1 << 16)
+/* transpose works on blocks of as many whole records as fit */
+#define PPMD_FILTER_BLOCK (1 << 20)
+
+typedef struct {
+    int kind;
+    unsigned param;
+    /* delta: the last param bytes before the chunk, oldest first */
+    Byte history[PPMD_FILTER_MAX_DISTANCE];
+    /* x86: position of the next byte, operand bytes still to convert, and
+       the offset being added to (or taken from) the operand, low byte first */
+    UInt32 pos;
+    unsigned operand;
+    UInt32 offset;
+    /* transpose: the records collect in block until it is full */
+    Byte *block;
+    size_t blockSize, fill;
+    /* filtered data ready for the next stage: buf[head .. ready) */
+    Byte *buf;
+    size_t head, ready;
+} PpmdFilter;
+
+/* Returns False for an unknown kind or a param out of range; allocates the
+   buffers otherwise (check f->buf for NULL). */
+Bool PpmdFilter_Init(PpmdFilter *f, int kind, unsigned param, IAllocPtr alloc);
+void PpmdFilter_Free(PpmdFilter *f, IAllocPtr alloc);
+
+/* A block filter holds back output until a whole block is in, so a decoder
+   decodes ahead of the length the caller asked for, and an encoder must end
+   the stream with an end mark for the decoder to find the last block. */
+#define PpmdFilter_InBlocks(f) ((f)->kind == PPMD_FILTER_TRANSPOSE)
+
+/* The data ready for the next stage and how much of it was taken. */
+#define PpmdFilter_Data(f) ((f)->buf + (f)->head)
+#define PpmdFilter_Ready(f) ((f)->ready - (f)->head)
+#define PpmdFilter_Skip(f, n) ((f)->head += (n))
+
+/* Encoder. Filters the leading bytes of src, returns how many it took.
+   The data of the previous call must have been taken. */
+size_t PpmdFilter_Encode(PpmdFilter *f, const Byte *src, size_t size);
+/* makes the records of a last, partial transpose block ready */
+void PpmdFilter_EncodeEnd(PpmdFilter *f);
+
+/* Decoder. The PPMd output goes to PpmdFilter_Space(f) .. + *size, once
+   the previous data was taken; PpmdFilter_Decode then makes the n new bytes
+   ready, all of a partial block when last is set. */
+Byte *PpmdFilter_Space(PpmdFilter *f, size_t *size);
+void PpmdFilter_Decode(PpmdFilter *f, size_t n, Bool last);
+
+#endif //PYPPMD_FILTER_H
@@ -68,6 +68,7 @@ Byte Ppmd_thread_Reader(const void *p) {
     ppmd_thread_control_t *tc = (ppmd_thread_control_t *)threadInfo->t;
     InBuffer *inBuffer = threadInfo->in;
     if (inBuffer->pos == inBuffer->size) {
+        Bool stop;
         pthread_mutex_lock(&tc->mutex);
         tc->empty = True;
         pthread_cond_broadcast(&tc->inEmpty);
@@ -75,8 +76,13 @@ Byte Ppmd_thread_Reader(const void *p) {
         pthread_cleanup_push(ppmd_mutex_unlock, (void *)&tc->mutex);
         do {
             pthread_cond_wait(&tc->notEmpty, &tc->mutex);
-        } while (tc->empty);
+        } while (tc->empty && !tc->stop);
+        stop = tc->stop;
         pthread_cleanup_pop(1); /* unlocks mutex */
+        if (stop) {
+            /* the input may be gone already, finish the symbol on zeros */
+            return 0;
+        }
     }
     return *((const Byte *)inBuffer->src + inBuffer->pos++);
 }
@@ -90,6 +96,7 @@ Bool Ppmd_thread_decode_init(ppmd_info *threadInfo, IAllocPtr allocator) {
         pthread_cond_init(&threadControl->notEmpty, NULL);
         threadControl->empty = False;
         threadControl->finished = True;
+        threadControl->stop = False;
         return True;
     }
     return False;
@@ -131,9 +138,22 @@ Ppmd7T_decode_run(void *p) {
             goto exit;
         }
         pthread_mutex_lock(&tc->mutex);
+        if (tc->stop) {
+            /* the output buffer belongs to the caller again */
+            pthread_mutex_unlock(&tc->mutex);
+            break;
+        }
         *((Byte *)threadInfo->out->dst + threadInfo->out->pos++) = (Byte) c;
-        pthread_mutex_unlock(&tc->mutex);
         i++;
+        /* a run reads no input, so it cannot block while holding the lock */
+        if (Ppmd7_InRun(cPpmd7)) {
+            size_t room = threadInfo->out->size - threadInfo->out->pos;
+            size_t run = Ppmd7_DecodeRun(cPpmd7, rc, (Byte *)threadInfo->out->dst + threadInfo->out->pos,
+                                         room < (size_t)(max_length - i) ? room : (size_t)(max_length - i));
+            threadInfo->out->pos += run;
+            i += (int) run;
+        }
+        pthread_mutex_unlock(&tc->mutex);
     }
     // when success return produced size
     result = i;
@@ -195,6 +215,7 @@ void Ppmd7T_Free(CPpmd7 *cPpmd7, ppmd_info *threadInfo, IAllocPtr allocator) {
     if (tc && !(tc->finished)) {
         /* Wake worker if it's waiting for input, then cancel and join */
         pthread_mutex_lock(&tc->mutex);
+        tc->stop = True;
         tc->empty = False;
         pthread_cond_broadcast(&tc->notEmpty);
         pthread_mutex_unlock(&tc->mutex);
@@ -240,9 +261,22 @@ Ppmd8T_decode_run(void *p) {
             goto exit;
         }
         pthread_mutex_lock(&tc->mutex);
+        if (tc->stop) {
+            /* the output buffer belongs to the caller again */
+            pthread_mutex_unlock(&tc->mutex);
+            break;
+        }
         *((Byte *)threadInfo->out->dst + threadInfo->out->pos++) = (Byte) c;
-        pthread_mutex_unlock(&tc->mutex);
         i++;
+        /* a run reads no input, so it cannot block while holding the lock */
+        if (Ppmd8_InRun(cPpmd8)) {
+            size_t room = threadInfo->out->size - threadInfo->out->pos;
+            size_t run = Ppmd8_DecodeRun(cPpmd8, (Byte *)threadInfo->out->dst + threadInfo->out->pos,
+                                         room < (size_t)(max_length - i) ? room : (size_t)(max_length - i));
+            threadInfo->out->pos += run;
+            i += (int) run;
+        }
+        pthread_mutex_unlock(&tc->mutex);
     }
     // when success return produced size
     result = i;
@@ -304,6 +338,7 @@ void Ppmd8T_Free(CPpmd8 *cPpmd8, ppmd_info *threadInfo, IAllocPtr allocator) {
     if (tc && !(tc->finished)) {
         /* Wake worker if it's waiting for input, then cancel and join */
         pthread_mutex_lock(&tc->mutex);
+        tc->stop = True;
         tc->empty = False;
         pthread_cond_broadcast(&tc->notEmpty);
         pthread_mutex_unlock(&tc->mutex);
@@ -23,6 +23,8 @@ typedef struct ppmd_thread_control_s {
     pthread_cond_t notEmpty;
     Bool empty;
     Bool finished;
+    /* set when freeing: the worker must not touch the input or output buffers again */
+    Bool stop;
 } ppmd_thread_control_t;
 
 Byte Ppmd_thread_Reader(const void *p);
@@ -135,6 +135,73 @@ OutputBuffer_InitWithSize(BlocksOutputBuffer *buffer, OutBuffer *ob,
     return 0;
 }
 
+/* Largest output allocated as one block when the caller states its exact length. */
+#define OUTPUT_BUFFER_EXACT_LIMIT (1024 * MB)
+
+/* Initialize the buffer with a single block of exactly max_length bytes,
+   so the output is written in place and returned without joining blocks.
+   Only for a max_length the caller states as the exact output size, not a
+   bound. Without a limit, or above OUTPUT_BUFFER_EXACT_LIMIT, it grows as usual.
+   Return 0 on success
+   Return -1 on failure
+*/
+static inline int
+OutputBuffer_InitExact(BlocksOutputBuffer *buffer, OutBuffer *ob,
+                       Py_ssize_t max_length) {
+    if (max_length < 0 || max_length > OUTPUT_BUFFER_EXACT_LIMIT) {
+        return OutputBuffer_InitAndGrow(buffer, ob, max_length);
+    }
+    if (OutputBuffer_InitWithSize(buffer, ob, max_length) < 0) {
+        return -1;
+    }
+    buffer->max_length = max_length;
+    return 0;
+}
+
+/* Expansion assumed until a decoder has seen output, PPMd on text is 3-6x */
+#define OUTPUT_BUFFER_DEFAULT_RATIO 4.0
+
+/* Expected output for in_size bytes of input, from the input and output
+   totals a decoder has seen so far. A quarter is added as headroom so a
+   typical call fits in the first block; the unused tail is trimmed when
+   finishing. */
+static inline Py_ssize_t
+OutputBuffer_Estimate(Py_ssize_t in_size, unsigned long long in_total,
+                      unsigned long long out_total) {
+    const double ratio = in_total > 0 ? (double) out_total / (double) in_total
+                                      : OUTPUT_BUFFER_DEFAULT_RATIO;
+    const double estimate = (double) in_size * ratio * 1.25;
+    const int limit = BUFFER_BLOCK_SIZE[Py_ARRAY_LENGTH(BUFFER_BLOCK_SIZE) - 1];
+
+    return estimate < limit ? (Py_ssize_t) estimate : limit;
+}
+
+/* Initialize the buffer for a decoder expecting about estimate bytes.
+   With exact, max_length is the output size and is allocated in one block;
+   otherwise it is only a bound, and the first block is the estimate up to
+   max_length, unless that is below the first scheduled block.
+   Return 0 on success
+   Return -1 on failure
+*/
+static inline int
+OutputBuffer_InitEstimate(BlocksOutputBuffer *buffer, OutBuffer *ob,
+                          Py_ssize_t max_length, Py_ssize_t estimate, int exact) {
+    if (exact && max_length >= 0 && max_length <= OUTPUT_BUFFER_EXACT_LIMIT) {
+        return OutputBuffer_InitExact(buffer, ob, max_length);
+    }
+    if (estimate <= BUFFER_BLOCK_SIZE[0]) {
+        return OutputBuffer_InitAndGrow(buffer, ob, max_length);
+    }
+    if (max_length >= 0 && estimate > max_length) {
+        estimate = max_length;
+    }
+    if (OutputBuffer_InitWithSize(buffer, ob, estimate) < 0) {
+        return -1;
+    }
+    buffer->max_length = max_length;
+    return 0;
+}
+
 /* Grow the buffer. The avail_out must be 0, please check it before calling.
    Return 0 on success
    Return -1 on failure
@@ -143,14 +210,22 @@ static inline int
 OutputBuffer_Grow(BlocksOutputBuffer *buffer, OutBuffer *ob) {
     PyObject *b;
     const Py_ssize_t list_len = Py_SIZE(buffer->list);
+    Py_ssize_t index = 0, scheduled = 0;
     int block_size;
 
     /* Ensure no gaps in the data */
     assert(ob->pos == ob->size);
 
-    /* Get block size */
-    if (list_len < (Py_ssize_t) Py_ARRAY_LENGTH(BUFFER_BLOCK_SIZE)) {
-        block_size = BUFFER_BLOCK_SIZE[list_len];
+    /* Get block size, going on from the allocated size when the first
+       block was larger than the schedule */
+    while (index < (Py_ssize_t) Py_ARRAY_LENGTH(BUFFER_BLOCK_SIZE) && scheduled < buffer->allocated) {
+        scheduled += BUFFER_BLOCK_SIZE[index++];
+    }
+    if (index < list_len) {
+        index = list_len;
+    }
+    if (index < (Py_ssize_t) Py_ARRAY_LENGTH(BUFFER_BLOCK_SIZE)) {
+        block_size = BUFFER_BLOCK_SIZE[index];
     } else {
         block_size = BUFFER_BLOCK_SIZE[Py_ARRAY_LENGTH(BUFFER_BLOCK_SIZE) - 1];
     }
@@ -224,6 +299,18 @@ OutputBuffer_Finish(BlocksOutputBuffer *buffer, OutBuffer *ob) {
         return block;
     }
 
+    /* Single block filled in part, shrink it in place */
+    if (list_len == 1) {
+        block = PyList_GET_ITEM(buffer->list, 0);
+        Py_INCREF(block);
+
+        Py_DECREF(buffer->list);
+        if (_PyBytes_Resize(&block, ob->pos) < 0) {
+            return NULL;
+        }
+        return block;
+    }
+
     /* Final bytes object */
     result = PyBytes_FromStringAndSize(NULL, buffer->allocated - (ob->size - ob->pos));
     if (result == NULL) {
@@ -254,6 +341,40 @@ OutputBuffer_Finish(BlocksOutputBuffer *buffer, OutBuffer *ob) {
     return result;
 }
 
+/* Finish the buffer as the list of its blocks, without joining them.
+   The last block is trimmed to the data, or dropped when empty.
+   Return a list of bytes objects on success
+   Return NULL on failure; the blocks are released in both cases
+*/
+static PyObject *
+OutputBuffer_FinishChunks(BlocksOutputBuffer *buffer, OutBuffer *ob) {
+    PyObject *list = buffer->list, *block;
+    const Py_ssize_t last = Py_SIZE(list) - 1;
+
+    if (ob->pos == 0) {
+        if (PyList_SetSlice(list, last, last + 1, NULL) < 0) {
+            Py_DECREF(list);
+            return NULL;
+        }
+    } else if (ob->pos < ob->size) {
+        /* the list holds the only reference, shrink the block in place */
+        block = PyList_GET_ITEM(list, last);
+        PyList_SET_ITEM(list, last, NULL);
+        if (_PyBytes_Resize(&block, ob->pos) < 0) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, last, block);
+    }
+    return list;
+}
+
+/* Size of the data written to the buffer so far */
+static inline Py_ssize_t
+OutputBuffer_GetDataSize(BlocksOutputBuffer *buffer, OutBuffer *ob) {
+    return buffer->allocated - (Py_ssize_t) (ob->size - ob->pos);
+}
+
 /* Clean up the buffer */
 static inline void
 OutputBuffer_OnError(BlocksOutputBuffer *buffer)
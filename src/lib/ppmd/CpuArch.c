@@ -0,0 +1,63 @@
+//
+// CpuArch.c -- runtime CPU feature detection for the SIMD kernels
+// Based on CpuArch.c - 2017-06-30 : Igor Pavlov : Public domain
+//
+
+#include "CpuArch.h"
+
+#if defined(PPMD_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+static UInt32 DetectFeatures(void)
+{
+  UInt32 flags = 0;
+#if defined(PPMD_SIMD_X86)
+  #if defined(_MSC_VER)
+  int regs[4];
+  int maxLeaf;
+  __cpuid(regs, 0);
+  maxLeaf = regs[0];
+  if (maxLeaf >= 1)
+  {
+    __cpuid(regs, 1);
+    if (regs[2] & (1 << 9))
+      flags |= PPMD_CPU_SSSE3;
+    /* the wide registers are usable only when the OS saves them (OSXSAVE, XCR0) */
+    if ((regs[2] & (1 << 27)) && maxLeaf >= 7)
+    {
+      UInt64 xcr0 = _xgetbv(0);
+      __cpuidex(regs, 7, 0);
+      if ((xcr0 & 0x06) == 0x06 && (regs[1] & (1 << 5)))
+        flags |= PPMD_CPU_AVX2;
+      if ((xcr0 & 0xE6) == 0xE6 && (regs[1] & (1 << 16)) && (regs[1] & (1 << 30)))
+        flags |= PPMD_CPU_AVX512BW;
+    }
+  }
+  #else
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("ssse3"))
+    flags |= PPMD_CPU_SSSE3;
+  if (__builtin_cpu_supports("avx2"))
+    flags |= PPMD_CPU_AVX2;
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    flags |= PPMD_CPU_AVX512BW;
+  #endif
+#elif defined(PPMD_SIMD_NEON)
+  flags |= PPMD_CPU_NEON;
+#endif
+  return flags;
+}
+
+UInt32 Ppmd_GetCpuFeatures(void)
+{
+  /* bit 31 marks a completed detection; racing first callers store the same value */
+  static volatile UInt32 g_Features = 0;
+  UInt32 flags = g_Features;
+  if (flags == 0)
+  {
+    flags = DetectFeatures() | ((UInt32)1 << 31);
+    g_Features = flags;
+  }
+  return flags & ~((UInt32)1 << 31);
+}
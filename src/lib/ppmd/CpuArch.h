@@ -0,0 +1,79 @@
+//
+// CpuArch.h -- runtime CPU feature detection for the SIMD kernels
+// Based on CpuArch.h - 2017-07-17 : Igor Pavlov : Public domain
+//
+
+#ifndef PPMD_CPUARCH_H
+#define PPMD_CPUARCH_H
+
+#include "Arch.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  #define PPMD_ARCH_X86
+#endif
+
+/* The kernels load 6-byte states, so PPMD_WIDE_REF builds scan them with scalar code */
+#if defined(PPMD_WIDE_REF) && !defined(PPMD_NO_SIMD)
+  #define PPMD_NO_SIMD
+#endif
+
+#if defined(PPMD_ARCH_X86) && (defined(_MSC_VER) || defined(__GNUC__) || defined(__clang__)) \
+    && !defined(PPMD_NO_SIMD)
+  #define PPMD_SIMD_X86
+#endif
+
+/* NEON is part of the AArch64 baseline, no runtime check is needed */
+#if (defined(__aarch64__) || defined(_M_ARM64)) && !defined(PPMD_NO_SIMD)
+  #define PPMD_SIMD_NEON
+#endif
+
+/* Kernels are compiled for the baseline ISA plus these extensions;
+   functions using them are marked with PPMD_TARGET and only called
+   when the running CPU reports the matching feature bit. */
+#if defined(__GNUC__) || defined(__clang__)
+  #define PPMD_TARGET(isa) __attribute__((target(isa)))
+#else
+  #define PPMD_TARGET(isa)
+#endif
+
+/* Ppmd_Prefetch(addr) hints that addr will be read soon. It is a no-op unless
+   the library is built with PPMD_USE_PREFETCH. Prefetches never fault, so
+   addr may point to a context that is not valid (yet). */
+#if defined(PPMD_USE_PREFETCH) && (defined(__GNUC__) || defined(__clang__))
+  #define Ppmd_Prefetch(addr) __builtin_prefetch((const void *)(addr), 0, 3)
+#elif defined(PPMD_USE_PREFETCH) && defined(_MSC_VER) && defined(PPMD_ARCH_X86)
+  #include <xmmintrin.h>
+  #define Ppmd_Prefetch(addr) _mm_prefetch((const char *)(const void *)(addr), _MM_HINT_T0)
+#else
+  #define Ppmd_Prefetch(addr) ((void)0)
+#endif
+
+/* count of leading / trailing zero bits, v must not be 0 */
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+static inline unsigned Ppmd_Clz32(UInt32 v)
+{
+  unsigned long index;
+  _BitScanReverse(&index, v);
+  return 31 - (unsigned)index;
+}
+static inline unsigned Ppmd_Ctz32(UInt32 v)
+{
+  unsigned long index;
+  _BitScanForward(&index, v);
+  return (unsigned)index;
+}
+#else
+  #define Ppmd_Clz32(v) ((unsigned)__builtin_clz(v))
+  #define Ppmd_Ctz32(v) ((unsigned)__builtin_ctz(v))
+#endif
+
+#define PPMD_CPU_SSSE3     (1u << 0)
+#define PPMD_CPU_AVX2      (1u << 1)
+#define PPMD_CPU_AVX512BW  (1u << 2)
+#define PPMD_CPU_NEON      (1u << 3)
+
+/* returns a combination of PPMD_CPU_* flags, detected once per process */
+UInt32 Ppmd_GetCpuFeatures(void);
+
+#endif // PPMD_CPUARCH_H
@@ -24,6 +24,24 @@ This code is based on PPMd var.H (2001): Dmitry Shkarin : Public domain */
 #define PPMD_N4 ((128 + 3 - 1 * PPMD_N1 - 2 * PPMD_N2 - 3 * PPMD_N3) / 4)
 #define PPMD_NUM_INDEXES (PPMD_N1 + PPMD_N2 + PPMD_N3 + PPMD_N4)
 
+/* Offsets into the model memory and sizes of it. A PPMD_WIDE_REF build makes
+   them 64-bit for models beyond 4 GiB. A state then takes 10 bytes and a unit
+   20 instead of 6 and 12, so the model fills up at other points and from there
+   on the coded streams differ from those of the default build: both sides of a
+   stream must be built alike. */
+#ifdef PPMD_WIDE_REF
+  #ifdef PPMD_32BIT
+    #error "PPMD_WIDE_REF needs a 64-bit target"
+  #endif
+  typedef UInt64 CPpmd_Size;
+  typedef UInt32 CPpmd_HalfRef;
+  #define PPMD_UNIT_SIZE 20
+#else
+  typedef UInt32 CPpmd_Size;
+  typedef UInt16 CPpmd_HalfRef;
+  #define PPMD_UNIT_SIZE 12
+#endif
+
 #pragma pack(push, 1)
 /* Most compilers works OK here even without #pragma pack(push, 1), but some GCC compilers need it. */
 
@@ -42,17 +60,32 @@ typedef struct
 {
   Byte Symbol;
   Byte Freq;
-  UInt16 SuccessorLow;
-  UInt16 SuccessorHigh;
+  CPpmd_HalfRef SuccessorLow;
+  CPpmd_HalfRef SuccessorHigh;
 } CPpmd_State;
 
 #pragma pack(pop)
 
+#define PPMD_HALF_REF_BITS (8 * sizeof(CPpmd_HalfRef))
+#define Ppmd_GetSuccessor(s) ((s)->SuccessorLow | ((CPpmd_Size)(s)->SuccessorHigh << PPMD_HALF_REF_BITS))
+
+/* Model telemetry. The counters are only touched on the slow paths of the
+   model update, so they are always kept. PeakUsed is sampled before each
+   restart or cut-off; readers combine it with the current usage. */
+typedef struct
+{
+  UInt32 Restarts;  /* model restarts after Init, when the memory ran out */
+  UInt32 CutOffs;   /* CutOff passes over the context tree (PPMd8) */
+  UInt32 Glues;     /* GlueFreeBlocks calls */
+  UInt32 Rescales;  /* frequency rescales of a context */
+  CPpmd_Size PeakUsed; /* high-water mark of the used model memory in bytes */
+} CPpmd_Stats;
+
 typedef
   #ifdef PPMD_32BIT
     CPpmd_State *
   #else
-    UInt32
+    CPpmd_Size
   #endif
   CPpmd_State_Ref;
 
@@ -60,7 +93,7 @@ typedef
   #ifdef PPMD_32BIT
     void *
   #else
-    UInt32
+    CPpmd_Size
   #endif
   CPpmd_Void_Ref;
 
@@ -68,7 +101,7 @@ typedef
   #ifdef PPMD_32BIT
     Byte *
   #else
-    UInt32
+    CPpmd_Size
   #endif
   CPpmd_Byte_Ref;
 
@@ -5,21 +5,22 @@ This code is based on PPMd var.H (2001): Dmitry Shkarin : Public domain */
 #include <string.h>
 
 #include "Ppmd7.h"
+#include "PpmdSort.h"
 
 const Byte PPMD7_kExpEscape[16] = { 25, 14, 9, 7, 5, 5, 4, 4, 4, 3, 3, 3, 2, 2, 2, 2 };
 static const UInt16 kInitBinEsc[] = { 0x3CDD, 0x1F3F, 0x59BF, 0x48F3, 0x64A1, 0x5ABC, 0x6632, 0x6051};
 
 #define MAX_FREQ 124
-#define UNIT_SIZE 12
+#define UNIT_SIZE PPMD_UNIT_SIZE
 
-#define U2B(nu) ((UInt32)(nu) * UNIT_SIZE)
+#define U2B(nu) ((CPpmd_Size)(nu) * UNIT_SIZE)
 #define U2I(nu) (p->Units2Indx[(size_t)(nu) - 1])
 #define I2U(indx) (p->Indx2Units[indx])
 
 #ifdef PPMD_32BIT
   #define REF(ptr) (ptr)
 #else
-  #define REF(ptr) ((UInt32)((Byte *)(ptr) - (p)->Base))
+  #define REF(ptr) ((CPpmd_Size)((Byte *)(ptr) - (p)->Base))
 #endif
 
 #define STATS_REF(ptr) ((CPpmd_State_Ref)REF(ptr))
@@ -37,10 +38,14 @@ typedef
   #ifdef PPMD_32BIT
     struct CPpmd7_Node_ *
   #else
-    UInt32
+    CPpmd_Size
   #endif
   CPpmd7_Node_Ref;
 
+#ifdef PPMD_WIDE_REF
+#pragma pack(push, 1)
+#endif
+
 typedef struct CPpmd7_Node_
 {
   UInt16 Stamp; /* must be at offset 0 as CPpmd7_Context::NumStats. Stamp=0 means free */
@@ -49,6 +54,13 @@ typedef struct CPpmd7_Node_
   CPpmd7_Node_Ref Prev;
 } CPpmd7_Node;
 
+#ifdef PPMD_WIDE_REF
+#pragma pack(pop)
+#endif
+
+/* nodes are stepped over in units */
+typedef char CPpmd7_Node_Size_Check[sizeof(CPpmd7_Node) == UNIT_SIZE ? 1 : -1];
+
 #ifdef PPMD_32BIT
   #define NODE(ptr) (ptr)
 #else
@@ -93,7 +105,7 @@ void Ppmd7_Free(CPpmd7 *p, IAllocPtr alloc)
   p->Base = 0;
 }
 
-Bool Ppmd7_Alloc(CPpmd7 *p, UInt32 size, IAllocPtr alloc)
+Bool Ppmd7_Alloc(CPpmd7 *p, CPpmd_Size size, IAllocPtr alloc)
 {
   if (!p->Base || p->Size != size)
   {
@@ -152,26 +164,52 @@ static void GlueFreeBlocks(CPpmd7 *p)
   #endif
   
   CPpmd7_Node_Ref n = head;
-  unsigned i;
+  CPpmd7_Node_Ref next[PPMD_NUM_INDEXES], first[PPMD_NUM_INDEXES], last[PPMD_NUM_INDEXES];
+  Byte lists[PPMD_NUM_INDEXES];
+  unsigned i, k, numLists = 0;
 
   p->GlueCount = 255;
+  p->Stats.Glues++;
 
-  /* create doubly-linked list of free blocks */
+  /* create doubly-linked list of free blocks. The free lists are walked side
+     by side, so that their cache misses overlap, and then joined in order. */
   for (i = 0; i < PPMD_NUM_INDEXES; i++)
   {
-    UInt16 nu = I2U(i);
-    CPpmd7_Node_Ref next = (CPpmd7_Node_Ref)p->FreeList[i];
+    next[i] = (CPpmd7_Node_Ref)p->FreeList[i];
+    first[i] = last[i] = 0;
     p->FreeList[i] = 0;
-    while (next != 0)
+    if (next[i] != 0)
+      lists[numLists++] = (Byte)i;
+  }
+  while (numLists != 0)
+    for (k = 0; k < numLists;)
     {
-      CPpmd7_Node *node = NODE(next);
-      node->Next = n;
-      n = NODE(n)->Prev = next;
-      next = *(const CPpmd7_Node_Ref *)node;
+      unsigned j = lists[k];
+      CPpmd7_Node_Ref ref = next[j];
+      CPpmd7_Node *node = NODE(ref);
+      next[j] = *(const CPpmd7_Node_Ref *)node;
+      if (last[j] != 0)
+      {
+        node->Next = last[j];
+        NODE(last[j])->Prev = ref;
+      }
+      else
+        first[j] = ref;
+      last[j] = ref;
       node->Stamp = 0;
-      node->NU = (UInt16)nu;
+      node->NU = (UInt16)I2U(j);
+      if (next[j] != 0)
+        k++;
+      else
+        lists[k] = lists[--numLists];
+    }
+  for (i = 0; i < PPMD_NUM_INDEXES; i++)
+    if (first[i] != 0)
+    {
+      NODE(first[i])->Next = n;
+      NODE(n)->Prev = first[i];
+      n = last[i];
     }
-  }
   NODE(head)->Stamp = 1;
   NODE(head)->Next = n;
   NODE(n)->Prev = head;
@@ -229,9 +267,9 @@ static void *AllocUnitsRare(CPpmd7 *p, unsigned indx)
   {
     if (++i == PPMD_NUM_INDEXES)
     {
-      UInt32 numBytes = U2B(I2U(indx));
+      CPpmd_Size numBytes = U2B(I2U(indx));
       p->GlueCount--;
-      return ((UInt32)(p->UnitsStart - p->Text) > numBytes) ? (p->UnitsStart -= numBytes) : (NULL);
+      return ((CPpmd_Size)(p->UnitsStart - p->Text) > numBytes) ? (p->UnitsStart -= numBytes) : (NULL);
     }
   }
   while (p->FreeList[i] == 0);
@@ -242,11 +280,11 @@ static void *AllocUnitsRare(CPpmd7 *p, unsigned indx)
 
 static void *AllocUnits(CPpmd7 *p, unsigned indx)
 {
-  UInt32 numBytes;
+  CPpmd_Size numBytes;
   if (p->FreeList[indx] != 0)
     return RemoveNode(p, indx);
   numBytes = U2B(I2U(indx));
-  if (numBytes <= (UInt32)(p->HiUnit - p->LoUnit))
+  if (numBytes <= (CPpmd_Size)(p->HiUnit - p->LoUnit))
   {
     void *retVal = p->LoUnit;
     p->LoUnit += numBytes;
@@ -255,9 +293,9 @@ static void *AllocUnits(CPpmd7 *p, unsigned indx)
   return AllocUnitsRare(p, indx);
 }
 
-#define MyMem12Cpy(dest, src, num) \
-  { UInt32 *d = (UInt32 *)dest; const UInt32 *s = (const UInt32 *)src; UInt32 n = num; \
-    do { d[0] = s[0]; d[1] = s[1]; d[2] = s[2]; s += 3; d += 3; } while (--n); }
+#define MyMemUnitCpy(dest, src, num) \
+  { UInt32 *d = (UInt32 *)dest; const UInt32 *z = (const UInt32 *)src; UInt32 n = num; \
+    do { unsigned k; for (k = 0; k < UNIT_SIZE / 4; k++) d[k] = z[k]; z += UNIT_SIZE / 4; d += UNIT_SIZE / 4; } while (--n); }
 
 static void *ShrinkUnits(CPpmd7 *p, void *oldPtr, unsigned oldNU, unsigned newNU)
 {
@@ -268,7 +306,7 @@ static void *ShrinkUnits(CPpmd7 *p, void *oldPtr, unsigned oldNU, unsigned newNU
   if (p->FreeList[i1] != 0)
   {
     void *ptr = RemoveNode(p, i1);
-    MyMem12Cpy(ptr, oldPtr, newNU);
+    MyMemUnitCpy(ptr, oldPtr, newNU);
     InsertNode(p, oldPtr, i0);
     return ptr;
   }
@@ -276,12 +314,12 @@ static void *ShrinkUnits(CPpmd7 *p, void *oldPtr, unsigned oldNU, unsigned newNU
   return oldPtr;
 }
 
-#define SUCCESSOR(p) ((CPpmd_Void_Ref)((p)->SuccessorLow | ((UInt32)(p)->SuccessorHigh << 16)))
+#define SUCCESSOR(p) ((CPpmd_Void_Ref)Ppmd_GetSuccessor(p))
 
 static void SetSuccessor(CPpmd_State *p, CPpmd_Void_Ref v)
 {
-  (p)->SuccessorLow = (UInt16)((UInt32)(v) & 0xFFFF);
-  (p)->SuccessorHigh = (UInt16)(((UInt32)(v) >> 16) & 0xFFFF);
+  (p)->SuccessorLow = (CPpmd_HalfRef)(CPpmd_Size)(v);
+  (p)->SuccessorHigh = (CPpmd_HalfRef)((CPpmd_Size)(v) >> PPMD_HALF_REF_BITS);
 }
 
 static void RestartModel(CPpmd7 *p)
@@ -335,11 +373,35 @@ void Ppmd7_Init(CPpmd7 *p, unsigned maxOrder)
 {
   p->MaxOrder = maxOrder;
   RestartModel(p);
+  memset(&p->Stats, 0, sizeof(p->Stats));
   p->DummySee.Shift = PPMD_PERIOD_BITS;
   p->DummySee.Summ = 0; /* unused */
   p->DummySee.Count = 64; /* unused */
 }
 
+CPpmd_Size Ppmd7_GetUsedMemory(const CPpmd7 *p)
+{
+  CPpmd_Size v = 0;
+  unsigned i;
+  for (i = 0; i < PPMD_NUM_INDEXES; i++)
+  {
+    CPpmd_Void_Ref next = p->FreeList[i];
+    for (; next != 0; next = *(const CPpmd_Void_Ref *)Ppmd7_GetPtr(p, next))
+      v += I2U(i);
+  }
+  return p->Size - (CPpmd_Size)(p->HiUnit - p->LoUnit) - (CPpmd_Size)(p->UnitsStart - p->Text) - U2B(v);
+}
+
+/* The memory ran out: record it and start the model over. */
+static void RestoreModel(CPpmd7 *p)
+{
+  CPpmd_Size used = Ppmd7_GetUsedMemory(p);
+  if (p->Stats.PeakUsed < used)
+    p->Stats.PeakUsed = used;
+  p->Stats.Restarts++;
+  RestartModel(p);
+}
+
 static CTX_PTR CreateSuccessors(CPpmd7 *p, Bool skip)
 {
   CPpmd_State upState;
@@ -461,7 +523,7 @@ static void UpdateModel(CPpmd7 *p)
     p->MinContext = p->MaxContext = CreateSuccessors(p, True);
     if (p->MinContext == 0)
     {
-      RestartModel(p);
+      RestoreModel(p);
       return;
     }
     SetSuccessor(p->FoundState, REF(p->MinContext));
@@ -472,7 +534,7 @@ static void UpdateModel(CPpmd7 *p)
   successor = REF(p->Text);
   if (p->Text >= p->UnitsStart)
   {
-    RestartModel(p);
+    RestoreModel(p);
     return;
   }
   
@@ -483,7 +545,7 @@ static void UpdateModel(CPpmd7 *p)
       CTX_PTR cs = CreateSuccessors(p, False);
       if (cs == NULL)
       {
-        RestartModel(p);
+        RestoreModel(p);
         return;
       }
       fSuccessor = REF(cs);
@@ -519,11 +581,11 @@ static void UpdateModel(CPpmd7 *p)
           void *oldPtr;
           if (!ptr)
           {
-            RestartModel(p);
+            RestoreModel(p);
             return;
           }
           oldPtr = STATS(c);
-          MyMem12Cpy(ptr, oldPtr, oldNU);
+          MyMemUnitCpy(ptr, oldPtr, oldNU);
           InsertNode(p, oldPtr, i);
           c->Stats = STATS_REF(ptr);
         }
@@ -535,7 +597,7 @@ static void UpdateModel(CPpmd7 *p)
       CPpmd_State *s = (CPpmd_State*)AllocUnits(p, 0);
       if (!s)
       {
-        RestartModel(p);
+        RestoreModel(p);
         return;
       }
       *s = *ONE_STATE(c);
@@ -574,6 +636,7 @@ static void Rescale(CPpmd7 *p)
   unsigned i, adder, sumFreq, escFreq;
   CPpmd_State *stats = STATS(p->MinContext);
   CPpmd_State *s = p->FoundState;
+  p->Stats.Rescales++;
   {
     CPpmd_State tmp = *s;
     for (; s != stats; s--)
@@ -587,22 +650,29 @@ static void Rescale(CPpmd7 *p)
   sumFreq = s->Freq;
   
   i = p->MinContext->NumStats - 1;
-  do
+  if (i + 1 >= PPMD_SORT_MIN)
   {
-    escFreq -= (++s)->Freq;
-    s->Freq = (Byte)((s->Freq + adder) >> 1);
-    sumFreq += s->Freq;
-    if (s[0].Freq > s[-1].Freq)
+    escFreq -= Ppmd_HalveSortStates(stats, i + 1, adder, &sumFreq);
+    s += i;
+    i = 0;
+  }
+  else
+    do
     {
-      CPpmd_State *s1 = s;
-      CPpmd_State tmp = *s1;
-      do
-        s1[0] = s1[-1];
-      while (--s1 != stats && tmp.Freq > s1[-1].Freq);
-      *s1 = tmp;
+      escFreq -= (++s)->Freq;
+      s->Freq = (Byte)((s->Freq + adder) >> 1);
+      sumFreq += s->Freq;
+      if (s[0].Freq > s[-1].Freq)
+      {
+        CPpmd_State *s1 = s;
+        CPpmd_State tmp = *s1;
+        do
+          s1[0] = s1[-1];
+        while (--s1 != stats && tmp.Freq > s1[-1].Freq);
+        *s1 = tmp;
+      }
     }
-  }
-  while (--i);
+    while (--i);
   
   if (s->Freq == 0)
   {
@@ -667,6 +737,11 @@ static void NextContext(CPpmd7 *p)
     UpdateModel(p);
 }
 
+void Ppmd7_NextContext(CPpmd7 *p)
+{
+  NextContext(p);
+}
+
 void Ppmd7_Update1(CPpmd7 *p)
 {
   CPpmd_State *s = p->FoundState;
@@ -692,14 +767,6 @@ void Ppmd7_Update1_0(CPpmd7 *p)
   NextContext(p);
 }
 
-void Ppmd7_UpdateBin(CPpmd7 *p)
-{
-  p->FoundState->Freq = (Byte)(p->FoundState->Freq + (p->FoundState->Freq < 128 ? 1: 0));
-  p->PrevSuccess = 1;
-  p->RunLength++;
-  NextContext(p);
-}
-
 void Ppmd7_Update2(CPpmd7 *p)
 {
   p->MinContext->SummFreq += 4;
@@ -708,3 +775,27 @@ void Ppmd7_Update2(CPpmd7 *p)
   p->RunLength = p->InitRL;
   UpdateModel(p);
 }
+
+void Ppmd7_WriteProps(Byte *props, unsigned maxOrder, UInt32 memSize)
+{
+  unsigned i;
+  props[0] = (Byte)maxOrder;
+  for (i = 0; i < 4; i++)
+    props[1 + i] = (Byte)(memSize >> (8 * i));
+}
+
+Bool Ppmd7_ReadProps(const Byte *props, size_t size, unsigned *maxOrder, UInt32 *memSize)
+{
+  unsigned i;
+  UInt32 mem = 0;
+  if (size != PPMD7_PROPS_SIZE)
+    return False;
+  for (i = 0; i < 4; i++)
+    mem |= (UInt32)props[1 + i] << (8 * i);
+  if (props[0] < PPMD7_MIN_ORDER || props[0] > PPMD7_MAX_ORDER
+      || mem < PPMD7_MIN_MEM_SIZE || mem > PPMD7_PROPS_MAX_MEM_SIZE)
+    return False;
+  *maxOrder = props[0];
+  *memSize = mem;
+  return True;
+}
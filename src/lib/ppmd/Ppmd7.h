@@ -10,12 +10,17 @@ This code is based on PPMd var.H (2001): Dmitry Shkarin : Public domain */
 #define __PPMD7_H
 
 #include "Ppmd.h"
+#include "PpmdDiv.h"
 
 #define PPMD7_MIN_ORDER 2
 #define PPMD7_MAX_ORDER 64
 
 #define PPMD7_MIN_MEM_SIZE (1 << 11)
+#ifdef PPMD_WIDE_REF
+#define PPMD7_MAX_MEM_SIZE ((CPpmd_Size)1 << 40)
+#else
 #define PPMD7_MAX_MEM_SIZE (0xFFFFFFFF - 12 * 3)
+#endif
 
 struct CPpmd7_Context_;
 
@@ -23,10 +28,37 @@ typedef
   #ifdef PPMD_32BIT
     struct CPpmd7_Context_ *
   #else
-    UInt32
+    CPpmd_Size
   #endif
   CPpmd7_Context_Ref;
 
+#ifdef PPMD_WIDE_REF
+
+/* Wide refs sit unaligned after SummFreq, so the context is packed, and the
+   state of a binary context is a union member instead of a cast. */
+#pragma pack(push, 1)
+
+typedef struct CPpmd7_Context_
+{
+  UInt16 NumStats;
+  union
+  {
+    struct
+    {
+      UInt16 SummFreq;
+      CPpmd_State_Ref Stats;
+    };
+    CPpmd_State OneState;
+  };
+  CPpmd7_Context_Ref Suffix;
+} CPpmd7_Context;
+
+#pragma pack(pop)
+
+#define Ppmd7Context_OneState(p) (&(p)->OneState)
+
+#else
+
 typedef struct CPpmd7_Context_
 {
   UInt16 NumStats;
@@ -37,6 +69,8 @@ typedef struct CPpmd7_Context_
 
 #define Ppmd7Context_OneState(p) ((CPpmd_State *)&(p)->SummFreq)
 
+#endif
+
 typedef struct
 {
   CPpmd7_Context *MinContext, *MaxContext;
@@ -44,7 +78,7 @@ typedef struct
   unsigned OrderFall, InitEsc, PrevSuccess, MaxOrder, HiBitsFlag;
   Int32 RunLength, InitRL; /* must be 32-bit at least */
 
-  UInt32 Size;
+  CPpmd_Size Size;
   UInt32 GlueCount;
   Byte *Base, *LoUnit, *HiUnit, *Text, *UnitsStart;
   UInt32 AlignOffset;
@@ -55,14 +89,27 @@ typedef struct
   Byte NS2Indx[256], NS2BSIndx[256], HB2Flag[256];
   CPpmd_See DummySee, See[25][16];
   UInt16 BinSumm[128][64];
+  CPpmd_Stats Stats;
 } CPpmd7;
 
 void Ppmd7_Construct(CPpmd7 *p);
-Bool Ppmd7_Alloc(CPpmd7 *p, UInt32 size, IAllocPtr alloc);
+Bool Ppmd7_Alloc(CPpmd7 *p, CPpmd_Size size, IAllocPtr alloc);
 void Ppmd7_Free(CPpmd7 *p, IAllocPtr alloc);
 void Ppmd7_Init(CPpmd7 *p, unsigned maxOrder);
 #define Ppmd7_WasAllocated(p) ((p)->Base != NULL)
 
+/* Bytes of the model memory in use: text area, contexts and states, without free blocks. */
+CPpmd_Size Ppmd7_GetUsedMemory(const CPpmd7 *p);
+
+/* 7z coder properties: max order (1 byte), then memory size (32-bit little endian) */
+#define PPMD7_PROPS_SIZE 5
+/* the largest memory size the properties carry, in any build */
+#define PPMD7_PROPS_MAX_MEM_SIZE (0xFFFFFFFF - 12 * 3)
+
+void Ppmd7_WriteProps(Byte *props, unsigned maxOrder, UInt32 memSize);
+/* returns False when size is not PPMD7_PROPS_SIZE or a value is out of range */
+Bool Ppmd7_ReadProps(const Byte *props, size_t size, unsigned *maxOrder, UInt32 *memSize);
+
 
 /* ---------- Internal Functions ---------- */
 
@@ -81,14 +128,47 @@ extern const Byte PPMD7_kExpEscape[16];
 void Ppmd7_Update1(CPpmd7 *p);
 void Ppmd7_Update1_0(CPpmd7 *p);
 void Ppmd7_Update2(CPpmd7 *p);
-void Ppmd7_UpdateBin(CPpmd7 *p);
-
-#define Ppmd7_GetBinSumm(p) \
-    &p->BinSumm[(size_t)(unsigned)Ppmd7Context_OneState(p->MinContext)->Freq - 1][p->PrevSuccess + \
-    p->NS2BSIndx[(size_t)Ppmd7_GetContext(p, p->MinContext->Suffix)->NumStats - 1] + \
-    (p->HiBitsFlag = p->HB2Flag[p->FoundState->Symbol]) + \
-    2 * p->HB2Flag[(unsigned)Ppmd7Context_OneState(p->MinContext)->Symbol] + \
-    ((p->RunLength >> 26) & 0x20)]
+/* moves on to the successor of p->FoundState, extending the model if needed */
+void Ppmd7_NextContext(CPpmd7 *p);
+
+/* Binary contexts (one state) are the most common ones in predictable data
+   and code a single bit, so their path is inline in the coders.
+   HB2Flag[c] is 8 for c >= 0x40: both flags are computed instead of looked
+   up, and the suffix, the only load that may miss the cache, comes last. */
+static inline UInt16 *Ppmd7_GetBinSumm(CPpmd7 *p)
+{
+  const CPpmd_State *s = Ppmd7Context_OneState(p->MinContext);
+  unsigned hiBits = ((p->FoundState->Symbol + 0xC0) >> 5) & 8;
+  unsigned col = p->PrevSuccess + hiBits + (((s->Symbol + 0xC0) >> 4) & 0x10) +
+      ((p->RunLength >> 26) & 0x20);
+  p->HiBitsFlag = hiBits;
+  return &p->BinSumm[(size_t)s->Freq - 1][col +
+      p->NS2BSIndx[(size_t)Ppmd7_GetContext(p, p->MinContext->Suffix)->NumStats - 1]];
+}
+
+/* after a binary context coded its state p->FoundState */
+static inline void Ppmd7_UpdateBin(CPpmd7 *p)
+{
+  CPpmd_State *s = p->FoundState;
+  CPpmd7_Context *c = Ppmd7_GetContext(p, (CPpmd7_Context_Ref)Ppmd_GetSuccessor(s));
+  s->Freq = (Byte)(s->Freq + (s->Freq < 128 ? 1: 0));
+  p->PrevSuccess = 1;
+  p->RunLength++;
+  if (p->OrderFall == 0 && (Byte *)c > p->Text)
+    p->MinContext = p->MaxContext = c;
+  else
+    Ppmd7_NextContext(p);
+}
+
+/* True when the binary context is its own successor: each further copy of
+   its symbol codes the same bit 0 there, which Ppmd7_DecodeRun and
+   Ppmd7_EncodeRun do in one loop. Callers test this first, it is cheap. */
+static inline int Ppmd7_InRun(CPpmd7 *p)
+{
+  CPpmd7_Context *mc = p->MinContext;
+  return mc->NumStats == 1 && p->OrderFall == 0 &&
+      Ppmd7_GetContext(p, (CPpmd7_Context_Ref)Ppmd_GetSuccessor(Ppmd7Context_OneState(mc))) == mc;
+}
 
 CPpmd_See *Ppmd7_MakeEscFreq(CPpmd7 *p, unsigned numMasked, UInt32 *scale);
 
@@ -100,6 +180,9 @@ typedef struct
   UInt32 Range;
   UInt32 Code;
   IByteIn *Stream;
+  #ifdef PPMD_USE_RECIPROCAL
+  CPpmd_RecipCache Recip;
+  #endif
 } CPpmd7z_RangeDec;
 
 void Ppmd7z_RangeDec_CreateVTable(CPpmd7z_RangeDec *p);
@@ -108,6 +191,13 @@ Bool Ppmd7z_RangeDec_Init(CPpmd7z_RangeDec *p);
 
 int Ppmd7_DecodeSymbol(CPpmd7 *p, CPpmd7z_RangeDec *rc);
 
+/* Runs: while the context is binary and its own successor, every symbol is
+   the same bit 0 of the same context. Ppmd7_DecodeRun decodes such symbols
+   into dest (up to size) in one loop and returns their count, 0 when no run
+   is under way. It stops before an escape and before a step that would read
+   input, so it never blocks; the next symbol goes to Ppmd7_DecodeSymbol. */
+size_t Ppmd7_DecodeRun(CPpmd7 *p, CPpmd7z_RangeDec *rc, Byte *dest, size_t size);
+
 
 /* ---------- Encode ---------- */
 
@@ -118,6 +208,9 @@ typedef struct
   Byte Cache;
   UInt64 CacheSize;
   IByteOut *Stream;
+  #ifdef PPMD_USE_RECIPROCAL
+  CPpmd_RecipCache Recip;
+  #endif
 } CPpmd7z_RangeEnc;
 
 void Ppmd7z_RangeEnc_Init(CPpmd7z_RangeEnc *p);
@@ -125,4 +218,9 @@ void Ppmd7z_RangeEnc_FlushData(CPpmd7z_RangeEnc *p);
 
 void Ppmd7_EncodeSymbol(CPpmd7 *p, CPpmd7z_RangeEnc *rc, int symbol);
 
+/* Encodes the leading symbols of src that continue a run (see
+   Ppmd7_DecodeRun) and returns their count. It stops before a step that
+   would write output, so the stream is the same as from Ppmd7_EncodeSymbol. */
+size_t Ppmd7_EncodeRun(CPpmd7 *p, CPpmd7z_RangeEnc *rc, const Byte *src, size_t size);
+
 #endif
@@ -2,7 +2,16 @@
 2017-04-03 : Igor Pavlov : Public domain
 This code is based on PPMd var.H (2001): Dmitry Shkarin : Public domain */
 
+#include <string.h>
+
 #include "Ppmd7.h"
+#include "PpmdMask.h"
+#include "CpuArch.h"
+
+/* The successor of the decoded state becomes the next context when the model
+   is not extended, so it is fetched while the frequencies are updated. */
+#define PrefetchSuccessor(p, s) Ppmd_Prefetch(Ppmd7_GetContext(p, \
+    ((CPpmd_Void_Ref)Ppmd_GetSuccessor(s))))
 
 #define kTopValue (1 << 24)
 
@@ -11,6 +20,9 @@ Bool Ppmd7z_RangeDec_Init(CPpmd7z_RangeDec *p)
   unsigned i;
   p->Code = 0;
   p->Range = 0xFFFFFFFF;
+  #ifdef PPMD_USE_RECIPROCAL
+  Ppmd_RecipCache_Init(&p->Recip);
+  #endif
   if (IByteIn_Read(p->Stream) != 0)
     return False;
   for (i = 0; i < 4; i++)
@@ -18,10 +30,23 @@ Bool Ppmd7z_RangeDec_Init(CPpmd7z_RangeDec *p)
   return (p->Code < 0xFFFFFFFF);
 }
 
+#ifdef PPMD_USE_RECIPROCAL
+/* Code / Range < h  <=>  Code < h * Range, so the threshold is Code itself and
+   cumulative frequencies are scaled by Range instead. h * Range never exceeds
+   the Range before the division by total, so the products do not overflow. */
+static UInt32 Range_GetThreshold(CPpmd7z_RangeDec *p, UInt32 total)
+{
+  p->Range = Ppmd_RecipCache_Div(&p->Recip, p->Range, total);
+  return p->Code;
+}
+#define Range_Below(p, count, h) ((count) < (h) * (p)->Range)
+#else
 static UInt32 Range_GetThreshold(CPpmd7z_RangeDec *p, UInt32 total)
 {
   return p->Code / (p->Range /= total);
 }
+#define Range_Below(p, count, h) ((count) < (h))
+#endif
 
 static void Range_Normalize(CPpmd7z_RangeDec *p)
 {
@@ -63,22 +88,24 @@ static UInt32 Range_DecodeBit(CPpmd7z_RangeDec *p, UInt32 size0)
   return symbol;
 }
 
-#define MASK(sym) ((signed char *)charMask)[sym]
-
 int Ppmd7_DecodeSymbol(CPpmd7 *p, CPpmd7z_RangeDec *rc)
 {
-  size_t charMask[256 / sizeof(size_t)];
+  CPpmd_CharMask charMask;
+  /* the suffix is visited on escapes and by UpdateModel */
+  Ppmd_Prefetch(Ppmd7_GetContext(p, p->MinContext->Suffix));
   if (p->MinContext->NumStats != 1)
   {
     CPpmd_State *s = Ppmd7_GetStats(p, p->MinContext);
     unsigned i;
     UInt32 count, hiCnt;
-    if ((count = Range_GetThreshold(rc, p->MinContext->SummFreq)) < (hiCnt = s->Freq))
+    count = Range_GetThreshold(rc, p->MinContext->SummFreq);
+    if (Range_Below(rc, count, hiCnt = s->Freq))
     {
       Byte symbol;
       Range_Decode(rc, 0, s->Freq);
       p->FoundState = s;
       symbol = s->Symbol;
+      PrefetchSuccessor(p, p->FoundState);
       Ppmd7_Update1_0(p);
       return symbol;
     }
@@ -86,91 +113,124 @@ int Ppmd7_DecodeSymbol(CPpmd7 *p, CPpmd7z_RangeDec *rc)
     i = p->MinContext->NumStats - 1;
     do
     {
-      if ((hiCnt += (++s)->Freq) > count)
+      if (Range_Below(rc, count, hiCnt += (++s)->Freq))
       {
         Byte symbol;
         Range_Decode(rc, hiCnt - s->Freq, s->Freq);
         p->FoundState = s;
         symbol = s->Symbol;
+        PrefetchSuccessor(p, p->FoundState);
         Ppmd7_Update1(p);
         return symbol;
       }
     }
     while (--i);
-    if (count >= p->MinContext->SummFreq)
+    if (!Range_Below(rc, count, p->MinContext->SummFreq))
       return -2;
     p->HiBitsFlag = p->HB2Flag[p->FoundState->Symbol];
     Range_Decode(rc, hiCnt, p->MinContext->SummFreq - hiCnt);
-    PPMD_SetAllBitsIn256Bytes(charMask);
-    MASK(s->Symbol) = 0;
-    i = p->MinContext->NumStats - 1;
-    do { MASK((--s)->Symbol) = 0; } while (--i);
+    PPMD_CHARMASK_SET_ALL(&charMask);
+    Ppmd_MaskStates(Ppmd7_GetStats(p, p->MinContext), p->MinContext->NumStats, &charMask);
   }
   else
   {
+    CPpmd_State *s = Ppmd7Context_OneState(p->MinContext);
     UInt16 *prob = Ppmd7_GetBinSumm(p);
-    if (Range_DecodeBit(rc, *prob) == 0)
+    UInt32 size0 = *prob;
+    if (Range_DecodeBit(rc, size0) == 0)
     {
-      Byte symbol;
-      *prob = (UInt16)PPMD_UPDATE_PROB_0(*prob);
-      symbol = (p->FoundState = Ppmd7Context_OneState(p->MinContext))->Symbol;
+      Byte symbol = s->Symbol;
+      *prob = (UInt16)PPMD_UPDATE_PROB_0(size0);
+      p->FoundState = s;
+      PrefetchSuccessor(p, s);
       Ppmd7_UpdateBin(p);
       return symbol;
     }
-    *prob = (UInt16)PPMD_UPDATE_PROB_1(*prob);
-    p->InitEsc = PPMD7_kExpEscape[*prob >> 10];
-    PPMD_SetAllBitsIn256Bytes(charMask);
-    MASK(Ppmd7Context_OneState(p->MinContext)->Symbol) = 0;
+    *prob = (UInt16)(size0 = PPMD_UPDATE_PROB_1(size0));
+    p->InitEsc = PPMD7_kExpEscape[size0 >> 10];
+    PPMD_CHARMASK_SET_ALL(&charMask);
+    PPMD_CHARMASK_CLEAR(&charMask, s->Symbol);
     p->PrevSuccess = 0;
   }
   for (;;)
   {
-    CPpmd_State *ps[256], *s;
+    CPpmd_State *s;
     UInt32 freqSum, count, hiCnt;
     CPpmd_See *see;
-    unsigned i, num, numMasked = p->MinContext->NumStats;
+    unsigned num, numMasked = p->MinContext->NumStats;
     do
     {
       p->OrderFall++;
       if (!p->MinContext->Suffix)
         return -1;
       p->MinContext = Ppmd7_GetContext(p, p->MinContext->Suffix);
+      Ppmd_Prefetch(Ppmd7_GetContext(p, p->MinContext->Suffix));
     }
     while (p->MinContext->NumStats == numMasked);
-    hiCnt = 0;
     s = Ppmd7_GetStats(p, p->MinContext);
-    i = 0;
-    num = p->MinContext->NumStats - numMasked;
-    do
-    {
-      int k = (int)(MASK(s->Symbol));
-      hiCnt += (s->Freq & k);
-      ps[i] = s++;
-      i -= k;
-    }
-    while (i != num);
+    num = p->MinContext->NumStats;
+    hiCnt = Ppmd_MaskedFreqSum(s, num, &charMask);
     
     see = Ppmd7_MakeEscFreq(p, numMasked, &freqSum);
     freqSum += hiCnt;
     count = Range_GetThreshold(rc, freqSum);
     
-    if (count < hiCnt)
+    if (Range_Below(rc, count, hiCnt))
     {
       Byte symbol;
-      CPpmd_State **pps = ps;
-      for (hiCnt = 0; (hiCnt += (*pps)->Freq) <= count; pps++);
-      s = *pps;
+      for (hiCnt = 0; !Range_Below(rc, count, hiCnt += s->Freq & PPMD_CHARMASK_GET(&charMask, s->Symbol)); s++);
       Range_Decode(rc, hiCnt - s->Freq, s->Freq);
       Ppmd_See_Update(see);
       p->FoundState = s;
       symbol = s->Symbol;
+      PrefetchSuccessor(p, p->FoundState);
       Ppmd7_Update2(p);
       return symbol;
     }
-    if (count >= freqSum)
+    if (!Range_Below(rc, count, freqSum))
       return -2;
     Range_Decode(rc, hiCnt, freqSum - hiCnt);
     see->Summ = (UInt16)(see->Summ + freqSum);
-    do { MASK(ps[--i]->Symbol) = 0; } while (i != 0);
+    Ppmd_MaskStates(s, num, &charMask);
+  }
+}
+
+size_t Ppmd7_DecodeRun(CPpmd7 *p, CPpmd7z_RangeDec *rc, Byte *dest, size_t size)
+{
+  CPpmd7_Context *mc = p->MinContext;
+  CPpmd_State *s = Ppmd7Context_OneState(mc);
+  UInt16 *prob, *next;
+  UInt32 size0;
+  size_t n;
+  if (!Ppmd7_InRun(p))
+    return 0;
+  /* Range_DecodeBit and Ppmd7_UpdateBin for a bit 0 in a context that stays */
+  prob = Ppmd7_GetBinSumm(p);
+  size0 = *prob;
+  for (n = 0; n < size; n++)
+  {
+    UInt32 range = (rc->Range >> 14) * size0;
+    if (rc->Code >= range || range < kTopValue)
+      break;
+    rc->Range = range;
+    size0 = PPMD_UPDATE_PROB_0(size0);
+    p->FoundState = s;
+    s->Freq = (Byte)(s->Freq + (s->Freq < 128 ? 1: 0));
+    p->PrevSuccess = 1;
+    p->RunLength++;
+    /* the entry only moves while Freq grows */
+    next = Ppmd7_GetBinSumm(p);
+    if (next != prob)
+    {
+      *prob = (UInt16)size0;
+      size0 = *(prob = next);
+    }
+  }
+  *prob = (UInt16)size0;
+  if (n != 0)
+  {
+    p->MaxContext = mc;
+    memset(dest, s->Symbol, n);
   }
+  return n;
 }
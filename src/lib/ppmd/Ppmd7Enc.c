@@ -3,6 +3,7 @@
 This code is based on PPMd var.H (2001): Dmitry Shkarin : Public domain */
 
 #include "Ppmd7.h"
+#include "PpmdMask.h"
 
 #define kTopValue (1 << 24)
 
@@ -12,6 +13,9 @@ void Ppmd7z_RangeEnc_Init(CPpmd7z_RangeEnc *p)
   p->Range = 0xFFFFFFFF;
   p->Cache = 0;
   p->CacheSize = 1;
+  #ifdef PPMD_USE_RECIPROCAL
+  Ppmd_RecipCache_Init(&p->Recip);
+  #endif
 }
 
 static void RangeEnc_ShiftLow(CPpmd7z_RangeEnc *p)
@@ -31,9 +35,15 @@ static void RangeEnc_ShiftLow(CPpmd7z_RangeEnc *p)
   p->Low = (UInt32)p->Low << 8;
 }
 
+#ifdef PPMD_USE_RECIPROCAL
+#define RangeEnc_Scale(p, total) Ppmd_RecipCache_Div(&(p)->Recip, (p)->Range, total)
+#else
+#define RangeEnc_Scale(p, total) ((p)->Range / (total))
+#endif
+
 static void RangeEnc_Encode(CPpmd7z_RangeEnc *p, UInt32 start, UInt32 size, UInt32 total)
 {
-  p->Low += (unsigned long long) start * (p->Range /= total);
+  p->Low += (unsigned long long) start * (p->Range = RangeEnc_Scale(p, total));
   p->Range *= size;
   while (p->Range < kTopValue)
   {
@@ -72,11 +82,9 @@ void Ppmd7z_RangeEnc_FlushData(CPpmd7z_RangeEnc *p)
 }
 
 
-#define MASK(sym) ((signed char *)charMask)[sym]
-
 void Ppmd7_EncodeSymbol(CPpmd7 *p, CPpmd7z_RangeEnc *rc, int symbol)
 {
-  size_t charMask[256 / sizeof(size_t)];
+  CPpmd_CharMask charMask;
   if (p->MinContext->NumStats != 1)
   {
     CPpmd_State *s = Ppmd7_GetStats(p, p->MinContext);
@@ -106,31 +114,30 @@ void Ppmd7_EncodeSymbol(CPpmd7 *p, CPpmd7z_RangeEnc *rc, int symbol)
     while (--i);
     
     p->HiBitsFlag = p->HB2Flag[p->FoundState->Symbol];
-    PPMD_SetAllBitsIn256Bytes(charMask);
-    MASK(s->Symbol) = 0;
-    i = p->MinContext->NumStats - 1;
-    do { MASK((--s)->Symbol) = 0; } while (--i);
+    PPMD_CHARMASK_SET_ALL(&charMask);
+    Ppmd_MaskStates(Ppmd7_GetStats(p, p->MinContext), p->MinContext->NumStats, &charMask);
     RangeEnc_Encode(rc, sum, p->MinContext->SummFreq - sum, p->MinContext->SummFreq);
   }
   else
   {
-    UInt16 *prob = Ppmd7_GetBinSumm(p);
     CPpmd_State *s = Ppmd7Context_OneState(p->MinContext);
+    UInt16 *prob = Ppmd7_GetBinSumm(p);
+    UInt32 size0 = *prob;
     if (s->Symbol == symbol)
     {
-      RangeEnc_EncodeBit_0(rc, *prob);
-      *prob = (UInt16)PPMD_UPDATE_PROB_0(*prob);
+      RangeEnc_EncodeBit_0(rc, size0);
+      *prob = (UInt16)PPMD_UPDATE_PROB_0(size0);
       p->FoundState = s;
       Ppmd7_UpdateBin(p);
       return;
     }
     else
     {
-      RangeEnc_EncodeBit_1(rc, *prob);
-      *prob = (UInt16)PPMD_UPDATE_PROB_1(*prob);
-      p->InitEsc = PPMD7_kExpEscape[*prob >> 10];
-      PPMD_SetAllBitsIn256Bytes(charMask);
-      MASK(s->Symbol) = 0;
+      RangeEnc_EncodeBit_1(rc, size0);
+      *prob = (UInt16)(size0 = PPMD_UPDATE_PROB_1(size0));
+      p->InitEsc = PPMD7_kExpEscape[size0 >> 10];
+      PPMD_CHARMASK_SET_ALL(&charMask);
+      PPMD_CHARMASK_CLEAR(&charMask, s->Symbol);
       p->PrevSuccess = 0;
     }
   }
@@ -139,8 +146,8 @@ void Ppmd7_EncodeSymbol(CPpmd7 *p, CPpmd7z_RangeEnc *rc, int symbol)
     UInt32 escFreq;
     CPpmd_See *see;
     CPpmd_State *s;
-    UInt32 sum;
-    unsigned i, numMasked = p->MinContext->NumStats;
+    UInt32 low, sum;
+    unsigned i, num, numMasked = p->MinContext->NumStats;
     do
     {
       p->OrderFall++;
@@ -152,34 +159,56 @@ void Ppmd7_EncodeSymbol(CPpmd7 *p, CPpmd7z_RangeEnc *rc, int symbol)
     
     see = Ppmd7_MakeEscFreq(p, numMasked, &escFreq);
     s = Ppmd7_GetStats(p, p->MinContext);
-    sum = 0;
-    i = p->MinContext->NumStats;
-    do
+    num = p->MinContext->NumStats;
+    i = Ppmd_MaskedFreqScan(s, num, (unsigned)symbol, &charMask, &low, &sum);
+    if (i != num)
     {
-      int cur = s->Symbol;
-      if (cur == symbol)
-      {
-        UInt32 low = sum;
-        CPpmd_State *s1 = s;
-        do
-        {
-          sum += (s->Freq & (int)(MASK(s->Symbol)));
-          s++;
-        }
-        while (--i);
-        RangeEnc_Encode(rc, low, s1->Freq, sum + escFreq);
-        Ppmd_See_Update(see);
-        p->FoundState = s1;
-        Ppmd7_Update2(p);
-        return;
-      }
-      sum += (s->Freq & (int)(MASK(cur)));
-      MASK(cur) = 0;
-      s++;
+      RangeEnc_Encode(rc, low, s[i].Freq, sum + escFreq);
+      Ppmd_See_Update(see);
+      p->FoundState = s + i;
+      Ppmd7_Update2(p);
+      return;
     }
-    while (--i);
+    Ppmd_MaskStates(s, num, &charMask);
     
     RangeEnc_Encode(rc, sum, escFreq, sum + escFreq);
     see->Summ = (UInt16)(see->Summ + sum + escFreq);
   }
 }
+
+size_t Ppmd7_EncodeRun(CPpmd7 *p, CPpmd7z_RangeEnc *rc, const Byte *src, size_t size)
+{
+  CPpmd7_Context *mc = p->MinContext;
+  CPpmd_State *s = Ppmd7Context_OneState(mc);
+  UInt16 *prob, *next;
+  UInt32 size0;
+  size_t n;
+  if (!Ppmd7_InRun(p))
+    return 0;
+  /* RangeEnc_EncodeBit_0 and Ppmd7_UpdateBin in a context that stays */
+  prob = Ppmd7_GetBinSumm(p);
+  size0 = *prob;
+  for (n = 0; n < size && src[n] == s->Symbol; n++)
+  {
+    UInt32 range = (rc->Range >> 14) * size0;
+    if (range < kTopValue)
+      break;
+    rc->Range = range;
+    size0 = PPMD_UPDATE_PROB_0(size0);
+    p->FoundState = s;
+    s->Freq = (Byte)(s->Freq + (s->Freq < 128 ? 1: 0));
+    p->PrevSuccess = 1;
+    p->RunLength++;
+    /* the entry only moves while Freq grows */
+    next = Ppmd7_GetBinSumm(p);
+    if (next != prob)
+    {
+      *prob = (UInt16)size0;
+      size0 = *(prob = next);
+    }
+  }
+  *prob = (UInt16)size0;
+  if (n != 0)
+    p->MaxContext = mc;
+  return n;
+}
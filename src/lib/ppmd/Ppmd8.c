@@ -5,21 +5,23 @@ This code is based on PPMd var.I (2002): Dmitry Shkarin : Public domain */
 #include <string.h>
 
 #include "Ppmd8.h"
+#include "PpmdMask.h"
+#include "PpmdSort.h"
 
 const Byte PPMD8_kExpEscape[16] = { 25, 14, 9, 7, 5, 5, 4, 4, 4, 3, 3, 3, 2, 2, 2, 2 };
 static const UInt16 kInitBinEsc[] = { 0x3CDD, 0x1F3F, 0x59BF, 0x48F3, 0x64A1, 0x5ABC, 0x6632, 0x6051};
 
 #define MAX_FREQ 124
-#define UNIT_SIZE 12
+#define UNIT_SIZE PPMD_UNIT_SIZE
 
-#define U2B(nu) ((UInt32)(nu) * UNIT_SIZE)
+#define U2B(nu) ((CPpmd_Size)(nu) * UNIT_SIZE)
 #define U2I(nu) (p->Units2Indx[(size_t)(nu) - 1])
 #define I2U(indx) (p->Indx2Units[indx])
 
 #ifdef PPMD_32BIT
   #define REF(ptr) (ptr)
 #else
-  #define REF(ptr) ((UInt32)((Byte *)(ptr) - (p)->Base))
+  #define REF(ptr) ((CPpmd_Size)((Byte *)(ptr) - (p)->Base))
 #endif
 
 #define STATS_REF(ptr) ((CPpmd_State_Ref)REF(ptr))
@@ -37,17 +39,31 @@ typedef
   #ifdef PPMD_32BIT
     struct CPpmd8_Node_ *
   #else
-    UInt32
+    CPpmd_Size
   #endif
   CPpmd8_Node_Ref;
 
+#ifdef PPMD_WIDE_REF
+#pragma pack(push, 1)
+#endif
+
 typedef struct CPpmd8_Node_
 {
   UInt32 Stamp;
   CPpmd8_Node_Ref Next;
   UInt32 NU;
+  #ifdef PPMD_WIDE_REF
+  UInt32 Pad;
+  #endif
 } CPpmd8_Node;
 
+#ifdef PPMD_WIDE_REF
+#pragma pack(pop)
+#endif
+
+/* nodes are stepped over in units */
+typedef char CPpmd8_Node_Size_Check[sizeof(CPpmd8_Node) == UNIT_SIZE ? 1 : -1];
+
 #ifdef PPMD_32BIT
   #define NODE(ptr) (ptr)
 #else
@@ -91,7 +107,7 @@ void Ppmd8_Free(CPpmd8 *p, IAllocPtr alloc)
   p->Base = 0;
 }
 
-Bool Ppmd8_Alloc(CPpmd8 *p, UInt32 size, IAllocPtr alloc)
+Bool Ppmd8_Alloc(CPpmd8 *p, CPpmd_Size size, IAllocPtr alloc)
 {
   if (!p->Base || p->Size != size)
   {
@@ -138,13 +154,40 @@ static void SplitBlock(CPpmd8 *p, void *ptr, unsigned oldIndx, unsigned newIndx)
   InsertNode(p, ptr, i);
 }
 
+/* InsertNode() into a per-list copy of the free lists, see GlueFreeBlocks() */
+static void StageNode(CPpmd8 *p, CPpmd8_Node_Ref *heads, CPpmd8_Node_Ref *tails, CPpmd8_Node *node, unsigned indx)
+{
+  node->Stamp = EMPTY_NODE;
+  node->Next = heads[indx];
+  node->NU = I2U(indx);
+  if (heads[indx] == 0)
+    tails[indx] = REF(node);
+  heads[indx] = REF(node);
+  p->Stamps[indx]++;
+}
+
+/* The free lists are walked side by side, so that the cache misses of the
+   lists overlap, in three passes:
+   1) every block with NU != 0 takes in the free blocks that follow it in
+      memory. Whatever the order, the first block of every run of free blocks
+      gets the whole run, and the others are left with NU == 0;
+   2) the blocks with NU != 0 are chained, each list in its own order;
+   3) they are cut into list sizes and inserted into per-list copies of the
+      free lists, which are then spliced in list order.
+   That gives the same free lists as walking the lists one after another.
+   Only pass 3 writes into the glued blocks, when the old links are not
+   needed any more. */
 static void GlueFreeBlocks(CPpmd8 *p)
 {
-  CPpmd8_Node_Ref head = 0;
-  CPpmd8_Node_Ref *prev = &head;
-  unsigned i;
+  CPpmd8_Node_Ref next[PPMD_NUM_INDEXES], first[PPMD_NUM_INDEXES];
+  CPpmd8_Node_Ref *prev[PPMD_NUM_INDEXES];
+  CPpmd8_Node_Ref heads[PPMD_NUM_INDEXES][PPMD_NUM_INDEXES];
+  CPpmd8_Node_Ref tails[PPMD_NUM_INDEXES][PPMD_NUM_INDEXES];
+  Byte lists[PPMD_NUM_INDEXES], filled[PPMD_NUM_INDEXES];
+  unsigned i, k, numLists, numFilled;
 
   p->GlueCount = 1 << 13;
+  p->Stats.Glues++;
   memset(p->Stamps, 0, sizeof(p->Stamps));
   
   /* Order-0 context is always at top UNIT, so we don't need guard NODE at the end.
@@ -153,46 +196,108 @@ static void GlueFreeBlocks(CPpmd8 *p)
     ((CPpmd8_Node *)p->LoUnit)->Stamp = 0;
 
   /* Glue free blocks */
+  numLists = 0;
   for (i = 0; i < PPMD_NUM_INDEXES; i++)
   {
-    CPpmd8_Node_Ref next = (CPpmd8_Node_Ref)p->FreeList[i];
+    next[i] = first[i] = (CPpmd8_Node_Ref)p->FreeList[i];
     p->FreeList[i] = 0;
-    while (next != 0)
+    if (next[i] != 0)
+      lists[numLists++] = (Byte)i;
+  }
+  while (numLists != 0)
+    for (k = 0; k < numLists;)
     {
-      CPpmd8_Node *node = NODE(next);
+      CPpmd8_Node *node = NODE(next[lists[k]]);
       if (node->NU != 0)
       {
         CPpmd8_Node *node2;
-        *prev = next;
-        prev = &(node->Next);
         while ((node2 = node + node->NU)->Stamp == EMPTY_NODE)
         {
           node->NU += node2->NU;
           node2->NU = 0;
         }
       }
-      next = node->Next;
+      if ((next[lists[k]] = node->Next) != 0)
+        k++;
+      else
+        lists[k] = lists[--numLists];
     }
+
+  /* Chain the glued blocks */
+  numLists = 0;
+  for (i = 0; i < PPMD_NUM_INDEXES; i++)
+  {
+    next[i] = first[i];
+    first[i] = 0;
+    prev[i] = &first[i];
+    if (next[i] != 0)
+      lists[numLists++] = (Byte)i;
   }
-  *prev = 0;
+  while (numLists != 0)
+    for (k = 0; k < numLists;)
+    {
+      i = lists[k];
+      {
+        CPpmd8_Node *node = NODE(next[i]);
+        next[i] = node->Next;
+        if (node->NU != 0)
+        {
+          *prev[i] = REF(node);
+          prev[i] = &node->Next;
+        }
+      }
+      if (next[i] != 0)
+        k++;
+      else
+        lists[k] = lists[--numLists];
+    }
   
   /* Fill lists of free blocks */
-  while (head != 0)
+  numLists = 0;
+  for (i = 0; i < PPMD_NUM_INDEXES; i++)
+  {
+    *prev[i] = 0;
+    if (first[i] != 0)
+    {
+      memset(heads[i], 0, sizeof(heads[i]));
+      lists[numLists++] = (Byte)i;
+    }
+  }
+  memcpy(filled, lists, numLists);
+  numFilled = numLists;
+  while (numLists != 0)
+    for (k = 0; k < numLists;)
+    {
+      unsigned j = lists[k];
+      CPpmd8_Node *node = NODE(first[j]);
+      unsigned nu = node->NU;
+      first[j] = node->Next;
+      for (; nu > 128; nu -= 128, node += 128)
+        StageNode(p, heads[j], tails[j], node, PPMD_NUM_INDEXES - 1);
+      if (I2U(i = U2I(nu)) != nu)
+      {
+        unsigned k2 = I2U(--i);
+        StageNode(p, heads[j], tails[j], node + k2, nu - k2 - 1);
+      }
+      StageNode(p, heads[j], tails[j], node, i);
+      if (first[j] != 0)
+        k++;
+      else
+        lists[k] = lists[--numLists];
+    }
+  for (i = 0; i < PPMD_NUM_INDEXES; i++)
   {
-    CPpmd8_Node *node = NODE(head);
-    unsigned nu;
-    head = node->Next;
-    nu = node->NU;
-    if (nu == 0)
-      continue;
-    for (; nu > 128; nu -= 128, node += 128)
-      InsertNode(p, node, PPMD_NUM_INDEXES - 1);
-    if (I2U(i = U2I(nu)) != nu)
+    CPpmd8_Node_Ref list = 0;
+    for (k = 0; k < numFilled; k++)
     {
-      unsigned k = I2U(--i);
-      InsertNode(p, node + k, nu - k - 1);
+      unsigned j = filled[k];
+      if (heads[j][i] != 0)
+      {
+        NODE(tails[j][i])->Next = list;
+        list = heads[j][i];
+      }
     }
-    InsertNode(p, node, i);
+    p->FreeList[i] = list;
   }
 }
 
@@ -211,9 +316,9 @@ static void *AllocUnitsRare(CPpmd8 *p, unsigned indx)
   {
     if (++i == PPMD_NUM_INDEXES)
     {
-      UInt32 numBytes = U2B(I2U(indx));
+      CPpmd_Size numBytes = U2B(I2U(indx));
       p->GlueCount--;
-      return ((UInt32)(p->UnitsStart - p->Text) > numBytes) ? (p->UnitsStart -= numBytes) : (NULL);
+      return ((CPpmd_Size)(p->UnitsStart - p->Text) > numBytes) ? (p->UnitsStart -= numBytes) : (NULL);
     }
   }
   while (p->FreeList[i] == 0);
@@ -224,11 +329,11 @@ static void *AllocUnitsRare(CPpmd8 *p, unsigned indx)
 
 static void *AllocUnits(CPpmd8 *p, unsigned indx)
 {
-  UInt32 numBytes;
+  CPpmd_Size numBytes;
   if (p->FreeList[indx] != 0)
     return RemoveNode(p, indx);
   numBytes = U2B(I2U(indx));
-  if (numBytes <= (UInt32)(p->HiUnit - p->LoUnit))
+  if (numBytes <= (CPpmd_Size)(p->HiUnit - p->LoUnit))
   {
     void *retVal = p->LoUnit;
     p->LoUnit += numBytes;
@@ -237,9 +342,9 @@ static void *AllocUnits(CPpmd8 *p, unsigned indx)
   return AllocUnitsRare(p, indx);
 }
 
-#define MyMem12Cpy(dest, src, num) \
+#define MyMemUnitCpy(dest, src, num) \
   { UInt32 *d = (UInt32 *)dest; const UInt32 *z = (const UInt32 *)src; UInt32 n = num; \
-    do { d[0] = z[0]; d[1] = z[1]; d[2] = z[2]; z += 3; d += 3; } while (--n); }
+    do { unsigned k; for (k = 0; k < UNIT_SIZE / 4; k++) d[k] = z[k]; z += UNIT_SIZE / 4; d += UNIT_SIZE / 4; } while (--n); }
 
 static void *ShrinkUnits(CPpmd8 *p, void *oldPtr, unsigned oldNU, unsigned newNU)
 {
@@ -250,7 +355,7 @@ static void *ShrinkUnits(CPpmd8 *p, void *oldPtr, unsigned oldNU, unsigned newNU
   if (p->FreeList[i1] != 0)
   {
     void *ptr = RemoveNode(p, i1);
-    MyMem12Cpy(ptr, oldPtr, newNU);
+    MyMemUnitCpy(ptr, oldPtr, newNU);
     InsertNode(p, oldPtr, i0);
     return ptr;
   }
@@ -283,7 +388,7 @@ static void *MoveUnitsUp(CPpmd8 *p, void *oldPtr, unsigned nu)
   if ((Byte *)oldPtr > p->UnitsStart + 16 * 1024 || REF(oldPtr) > p->FreeList[indx])
     return oldPtr;
   ptr = RemoveNode(p, indx);
-  MyMem12Cpy(ptr, oldPtr, nu);
+  MyMemUnitCpy(ptr, oldPtr, nu);
   if ((Byte*)oldPtr != p->UnitsStart)
     InsertNode(p, oldPtr, indx);
   else
@@ -328,12 +433,12 @@ static void ExpandTextArea(CPpmd8 *p)
   }
 }
 
-#define SUCCESSOR(p) ((CPpmd_Void_Ref)((p)->SuccessorLow | ((UInt32)(p)->SuccessorHigh << 16)))
+#define SUCCESSOR(p) ((CPpmd_Void_Ref)Ppmd_GetSuccessor(p))
 
 static void SetSuccessor(CPpmd_State *p, CPpmd_Void_Ref v)
 {
-  (p)->SuccessorLow = (UInt16)((UInt32)(v) & 0xFFFF);
-  (p)->SuccessorHigh = (UInt16)(((UInt32)(v) >> 16) & 0xFFFF);
+  (p)->SuccessorLow = (CPpmd_HalfRef)(CPpmd_Size)(v);
+  (p)->SuccessorHigh = (CPpmd_HalfRef)((CPpmd_Size)(v) >> PPMD_HALF_REF_BITS);
 }
 
 #define RESET_TEXT(offs) { p->Text = p->Base + p->AlignOffset + (offs); }
@@ -344,8 +449,8 @@ static void RestartModel(CPpmd8 *p)
 
   memset(p->FreeList, 0, sizeof(p->FreeList));
   memset(p->Stamps, 0, sizeof(p->Stamps));
-  RESET_TEXT(0);
-  p->HiUnit = p->Text + p->Size;
+  RESET_TEXT(p->HistorySize);
+  p->HiUnit = p->Base + p->AlignOffset + p->Size;
   p->LoUnit = p->UnitsStart = p->HiUnit - p->Size / 8 / UNIT_SIZE * 7 * UNIT_SIZE;
   p->GlueCount = 0;
 
@@ -399,7 +504,21 @@ void Ppmd8_Init(CPpmd8 *p, unsigned maxOrder, unsigned restoreMethod)
 {
   p->MaxOrder = maxOrder;
   p->RestoreMethod = restoreMethod;
+  p->History = NULL;
+  p->HistorySize = 0;
+  p->HistoryPos = 0;
+  p->ReplayLeft = 0;
+  if (restoreMethod == PPMD8_RESTORE_METHOD_REPLAY)
+  {
+    /* a power of 2 up to 1/32 of the memory, taken from the text area */
+    UInt32 size = PPMD8_HISTORY_MAX;
+    while (size > (p->Size >> 5))
+      size >>= 1;
+    p->History = p->Base + p->AlignOffset;
+    p->HistorySize = size;
+  }
   RestartModel(p);
+  memset(&p->Stats, 0, sizeof(p->Stats));
   p->DummySee.Shift = PPMD_PERIOD_BITS;
   p->DummySee.Summ = 0; /* unused */
   p->DummySee.Count = 64; /* unused */
@@ -527,13 +646,13 @@ static CPpmd_Void_Ref RemoveBinContexts(CPpmd8 *p, CTX_PTR ctx, unsigned order)
 }
 #endif
 
-static UInt32 GetUsedMemory(const CPpmd8 *p)
+CPpmd_Size Ppmd8_GetUsedMemory(const CPpmd8 *p)
 {
-  UInt32 v = 0;
+  CPpmd_Size v = 0;
   unsigned i;
   for (i = 0; i < PPMD_NUM_INDEXES; i++)
     v += p->Stamps[i] * I2U(i);
-  return p->Size - (UInt32)(p->HiUnit - p->LoUnit) - (UInt32)(p->UnitsStart - p->Text) - U2B(v);
+  return p->Size - (CPpmd_Size)(p->HiUnit - p->LoUnit) - (CPpmd_Size)(p->UnitsStart - p->Text) - U2B(v);
 }
 
 #ifdef PPMD8_FREEZE_SUPPORT
@@ -550,6 +669,18 @@ static void RestoreModel(CPpmd8 *p, CTX_PTR c1
 {
   CTX_PTR c;
   CPpmd_State *s;
+  CPpmd_Size used = Ppmd8_GetUsedMemory(p);
+  if (p->Stats.PeakUsed < used)
+    p->Stats.PeakUsed = used;
+  if (p->RestoreMethod == PPMD8_RESTORE_METHOD_REPLAY)
+  {
+    p->Stats.Restarts++;
+    RestartModel(p);
+    /* History is NULL while replaying: see Ppmd8_Replay */
+    if (p->History)
+      p->ReplayLeft = (p->HistoryPos < p->HistorySize) ? p->HistoryPos : p->HistorySize;
+    return;
+  }
   RESET_TEXT(0);
   for (c = p->MaxContext; c != c1; c = SUFFIX(c))
     if (--(c->NumStats) == 0)
@@ -586,18 +717,22 @@ static void RestoreModel(CPpmd8 *p, CTX_PTR c1
   }
   else
   #endif
-  if (p->RestoreMethod == PPMD8_RESTORE_METHOD_RESTART || GetUsedMemory(p) < (p->Size >> 1))
+  if (p->RestoreMethod == PPMD8_RESTORE_METHOD_RESTART || Ppmd8_GetUsedMemory(p) < (p->Size >> 1))
+  {
+    p->Stats.Restarts++;
     RestartModel(p);
+  }
   else
   {
     while (p->MaxContext->Suffix)
       p->MaxContext = SUFFIX(p->MaxContext);
     do
     {
+      p->Stats.CutOffs++;
       CutOff(p, p->MaxContext, 0);
       ExpandTextArea(p);
     }
-    while (GetUsedMemory(p) > 3 * (p->Size >> 2));
+    while (Ppmd8_GetUsedMemory(p) > 3 * (p->Size >> 2));
     p->GlueCount = 0;
     p->OrderFall = p->MaxOrder;
   }
@@ -913,7 +1048,7 @@ static void UpdateModel(CPpmd8 *p)
             return;
           }
           oldPtr = STATS(c);
-          MyMem12Cpy(ptr, oldPtr, oldNU);
+          MyMemUnitCpy(ptr, oldPtr, oldNU);
           InsertNode(p, oldPtr, i);
           c->Stats = STATS_REF(ptr);
         }
@@ -965,6 +1100,7 @@ static void Rescale(CPpmd8 *p)
   unsigned i, adder, sumFreq, escFreq;
   CPpmd_State *stats = STATS(p->MinContext);
   CPpmd_State *s = p->FoundState;
+  p->Stats.Rescales++;
   {
     CPpmd_State tmp = *s;
     for (; s != stats; s--)
@@ -982,22 +1118,29 @@ static void Rescale(CPpmd8 *p)
   sumFreq = s->Freq;
   
   i = p->MinContext->NumStats;
-  do
+  if (i + 1 >= PPMD_SORT_MIN)
   {
-    escFreq -= (++s)->Freq;
-    s->Freq = (Byte)((s->Freq + adder) >> 1);
-    sumFreq += s->Freq;
-    if (s[0].Freq > s[-1].Freq)
+    escFreq -= Ppmd_HalveSortStates(stats, i + 1, adder, &sumFreq);
+    s += i;
+    i = 0;
+  }
+  else
+    do
     {
-      CPpmd_State *s1 = s;
-      CPpmd_State tmp = *s1;
-      do
-        s1[0] = s1[-1];
-      while (--s1 != stats && tmp.Freq > s1[-1].Freq);
-      *s1 = tmp;
+      escFreq -= (++s)->Freq;
+      s->Freq = (Byte)((s->Freq + adder) >> 1);
+      sumFreq += s->Freq;
+      if (s[0].Freq > s[-1].Freq)
+      {
+        CPpmd_State *s1 = s;
+        CPpmd_State tmp = *s1;
+        do
+          s1[0] = s1[-1];
+        while (--s1 != stats && tmp.Freq > s1[-1].Freq);
+        *s1 = tmp;
+      }
     }
-  }
-  while (--i);
+    while (--i);
   
   if (s->Freq == 0)
   {
@@ -1058,6 +1201,7 @@ CPpmd_See *Ppmd8_MakeEscFreq(CPpmd8 *p, unsigned numMasked1, UInt32 *escFreq)
 static void NextContext(CPpmd8 *p)
 {
   CTX_PTR c = CTX(SUCCESSOR(p->FoundState));
+  PPMD8_RECORD(p, p->FoundState->Symbol)
   if (p->OrderFall == 0 && (Byte *)c >= p->UnitsStart)
     p->MinContext = p->MaxContext = c;
   else
@@ -1067,6 +1211,11 @@ static void NextContext(CPpmd8 *p)
   }
 }
 
+void Ppmd8_NextContext(CPpmd8 *p)
+{
+  NextContext(p);
+}
+
 void Ppmd8_Update1(CPpmd8 *p)
 {
   CPpmd_State *s = p->FoundState;
@@ -1092,24 +1241,119 @@ void Ppmd8_Update1_0(CPpmd8 *p)
   NextContext(p);
 }
 
-void Ppmd8_UpdateBin(CPpmd8 *p)
-{
-  p->FoundState->Freq = (Byte)(p->FoundState->Freq + (p->FoundState->Freq < 196));
-  p->PrevSuccess = 1;
-  p->RunLength++;
-  NextContext(p);
-}
-
 void Ppmd8_Update2(CPpmd8 *p)
 {
   p->MinContext->SummFreq += 4;
   if ((p->FoundState->Freq += 4) > MAX_FREQ)
     Rescale(p);
   p->RunLength = p->InitRL;
+  PPMD8_RECORD(p, p->FoundState->Symbol)
   UpdateModel(p);
   p->MinContext = p->MaxContext;
 }
 
+/* The model updates of Ppmd8_EncodeSymbol, without the range coder */
+static void ReplaySymbol(CPpmd8 *p, unsigned symbol)
+{
+  CPpmd_CharMask charMask;
+  if (p->MinContext->NumStats != 0)
+  {
+    CPpmd_State *s = Ppmd8_GetStats(p, p->MinContext);
+    unsigned i;
+    if (s->Symbol == symbol)
+    {
+      p->FoundState = s;
+      Ppmd8_Update1_0(p);
+      return;
+    }
+    p->PrevSuccess = 0;
+    i = p->MinContext->NumStats;
+    do
+    {
+      if ((++s)->Symbol == symbol)
+      {
+        p->FoundState = s;
+        Ppmd8_Update1(p);
+        return;
+      }
+    }
+    while (--i);
+    PPMD_CHARMASK_SET_ALL(&charMask);
+    Ppmd_MaskStates(Ppmd8_GetStats(p, p->MinContext), (unsigned)p->MinContext->NumStats + 1, &charMask);
+  }
+  else
+  {
+    CPpmd_State *s = Ppmd8Context_OneState(p->MinContext);
+    UInt16 *prob = Ppmd8_GetBinSumm(p);
+    UInt32 size0 = *prob;
+    if (s->Symbol == symbol)
+    {
+      *prob = (UInt16)PPMD_UPDATE_PROB_0(size0);
+      p->FoundState = s;
+      Ppmd8_UpdateBin(p);
+      return;
+    }
+    *prob = (UInt16)(size0 = PPMD_UPDATE_PROB_1(size0));
+    p->InitEsc = PPMD8_kExpEscape[size0 >> 10];
+    PPMD_CHARMASK_SET_ALL(&charMask);
+    PPMD_CHARMASK_CLEAR(&charMask, s->Symbol);
+    p->PrevSuccess = 0;
+  }
+  for (;;)
+  {
+    UInt32 escFreq;
+    CPpmd_See *see;
+    CPpmd_State *s;
+    UInt32 low, sum;
+    unsigned i, num, numMasked = p->MinContext->NumStats;
+    do
+    {
+      p->OrderFall++;
+      if (!p->MinContext->Suffix)
+        return;
+      p->MinContext = Ppmd8_GetContext(p, p->MinContext->Suffix);
+    }
+    while (p->MinContext->NumStats == numMasked);
+
+    see = Ppmd8_MakeEscFreq(p, numMasked, &escFreq);
+    s = Ppmd8_GetStats(p, p->MinContext);
+    num = (unsigned)p->MinContext->NumStats + 1;
+    i = Ppmd_MaskedFreqScan(s, num, symbol, &charMask, &low, &sum);
+    if (i != num)
+    {
+      Ppmd_See_Update(see);
+      p->FoundState = s + i;
+      Ppmd8_Update2(p);
+      return;
+    }
+    Ppmd_MaskStates(s, num, &charMask);
+    see->Summ = (UInt16)(see->Summ + sum + escFreq);
+  }
+}
+
+void Ppmd8_Replay(CPpmd8 *p)
+{
+  Byte *history = p->History;
+  UInt32 restarts = p->Stats.Restarts;
+  UInt32 num = (p->ReplayLeft < PPMD8_REPLAY_STEP) ? p->ReplayLeft : PPMD8_REPLAY_STEP;
+  UInt32 pos = p->HistoryPos - p->ReplayLeft;
+
+  /* the replayed symbols are in the ring already */
+  p->History = NULL;
+  p->ReplayLeft -= num;
+  for (; num != 0; num--)
+  {
+    ReplaySymbol(p, history[pos++ & (p->HistorySize - 1)]);
+    /* a restart drops the rest of the replay */
+    if (p->Stats.Restarts != restarts)
+    {
+      p->ReplayLeft = 0;
+      break;
+    }
+  }
+  p->History = history;
+}
+
 /* H->I changes:
   NS2Indx
   GlewCount, and Glue method
@@ -8,22 +8,50 @@ This code is based on:
 #define __PPMD8_H
 
 #include "Ppmd.h"
+#include "PpmdDiv.h"
 
 #define PPMD8_MIN_ORDER 2
 #define PPMD8_MAX_ORDER 16
 
+#define PPMD8_HISTORY_MAX ((UInt32)1 << 15)
+
 struct CPpmd8_Context_;
 
 typedef
   #ifdef PPMD_32BIT
     struct CPpmd8_Context_ *
   #else
-    UInt32
+    CPpmd_Size
   #endif
   CPpmd8_Context_Ref;
 
 #pragma pack(push, 1)
 
+#ifdef PPMD_WIDE_REF
+
+/* the state of a binary context is a union member instead of a cast */
+typedef struct CPpmd8_Context_
+{
+  Byte NumStats;
+  Byte Flags;
+  union
+  {
+    struct
+    {
+      UInt16 SummFreq;
+      CPpmd_State_Ref Stats;
+    };
+    CPpmd_State OneState;
+  };
+  CPpmd8_Context_Ref Suffix;
+} CPpmd8_Context;
+
+#pragma pack(pop)
+
+#define Ppmd8Context_OneState(p) (&(p)->OneState)
+
+#else
+
 typedef struct CPpmd8_Context_
 {
   Byte NumStats;
@@ -37,6 +65,8 @@ typedef struct CPpmd8_Context_
 
 #define Ppmd8Context_OneState(p) ((CPpmd_State *)&(p)->SummFreq)
 
+#endif
+
 /* The BUG in Shkarin's code for FREEZE mode was fixed, but that fixed
    code is not compatible with original code for some files compressed
    in FREEZE mode. So we disable FREEZE mode support. */
@@ -50,6 +80,19 @@ enum
   #endif
 };
 
+/* Not a 7-Zip method: 2 is FREEZE and 3 the state FREEZE moves to once the
+   model is frozen. REPLAY restarts the model when memory runs out, like
+   RESTART, and then feeds the latest input (up to PPMD8_HISTORY_MAX symbols)
+   back into the fresh model, PPMD8_REPLAY_STEP of them before each of the
+   next symbols. Those symbols are coded with the order-0 context until the
+   model has caught up. */
+#define PPMD8_RESTORE_METHOD_REPLAY 4
+#define PPMD8_REPLAY_STEP 64
+
+#ifdef PPMD8_FREEZE_SUPPORT
+  #error "the FREEZE code treats every restore method above FREEZE as frozen, REPLAY included"
+#endif
+
 typedef struct
 {
   CPpmd8_Context *MinContext, *MaxContext;
@@ -57,7 +100,7 @@ typedef struct
   unsigned OrderFall, InitEsc, PrevSuccess, MaxOrder;
   Int32 RunLength, InitRL; /* must be 32-bit at least */
 
-  UInt32 Size;
+  CPpmd_Size Size;
   UInt32 GlueCount;
   Byte *Base, *LoUnit, *HiUnit, *Text, *UnitsStart;
   UInt32 AlignOffset;
@@ -81,14 +124,28 @@ typedef struct
   Byte NS2BSIndx[256], NS2Indx[260];
   CPpmd_See DummySee, See[24][32];
   UInt16 BinSumm[25][64];
+  CPpmd_Stats Stats;
+
+  /* PPMD8_RESTORE_METHOD_REPLAY: the latest input symbols, in a ring at the
+     start of the arena ahead of the text area. The last ReplayLeft of them
+     are not in the model yet. */
+  Byte *History; /* NULL in other modes and while replaying */
+  UInt32 HistorySize, HistoryPos, ReplayLeft;
+
+  #ifdef PPMD_USE_RECIPROCAL
+  CPpmd_RecipCache Recip;
+  #endif
 } CPpmd8;
 
 void Ppmd8_Construct(CPpmd8 *p);
-Bool Ppmd8_Alloc(CPpmd8 *p, UInt32 size, IAllocPtr alloc);
+Bool Ppmd8_Alloc(CPpmd8 *p, CPpmd_Size size, IAllocPtr alloc);
 void Ppmd8_Free(CPpmd8 *p, IAllocPtr alloc);
 void Ppmd8_Init(CPpmd8 *p, unsigned maxOrder, unsigned restoreMethod);
 #define Ppmd8_WasAllocated(p) ((p)->Base != NULL)
 
+/* Bytes of the model memory in use: text area, contexts and states, without free blocks. */
+CPpmd_Size Ppmd8_GetUsedMemory(const CPpmd8 *p);
+
 
 /* ---------- Internal Functions ---------- */
 
@@ -107,21 +164,72 @@ extern const Byte PPMD8_kExpEscape[16];
 void Ppmd8_Update1(CPpmd8 *p);
 void Ppmd8_Update1_0(CPpmd8 *p);
 void Ppmd8_Update2(CPpmd8 *p);
-void Ppmd8_UpdateBin(CPpmd8 *p);
-
-#define Ppmd8_GetBinSumm(p) \
-    &p->BinSumm[p->NS2Indx[(size_t)Ppmd8Context_OneState(p->MinContext)->Freq - 1]][ \
-    p->NS2BSIndx[Ppmd8_GetContext(p, p->MinContext->Suffix)->NumStats] + \
-    p->PrevSuccess + p->MinContext->Flags + ((p->RunLength >> 26) & 0x20)]
+/* moves on to the successor of p->FoundState, extending the model if needed */
+void Ppmd8_NextContext(CPpmd8 *p);
 
 CPpmd_See *Ppmd8_MakeEscFreq(CPpmd8 *p, unsigned numMasked, UInt32 *scale);
 
+/* Feeds up to PPMD8_REPLAY_STEP of the p->ReplayLeft pending history symbols
+   to the model, without coding them. Called at the start of a symbol when
+   p->ReplayLeft != 0; if symbols are still pending afterwards, the coder
+   codes the symbol with Ppmd8_GetRoot and queues it with PPMD8_QUEUE. */
+void Ppmd8_Replay(CPpmd8 *p);
+
+/* the order-0 context, which stays at the top of the arena */
+#define Ppmd8_GetRoot(p) ((CPpmd8_Context *)((p)->Base + (p)->AlignOffset + (p)->Size - PPMD_UNIT_SIZE))
+
+/* Symbols coded while the replay is pending: 0x100 is the end marker. */
+#define PPMD8_ROOT_ESCAPE_TOTAL 0x101
+
+#define PPMD8_QUEUE(p, sym) \
+    { (p)->History[(p)->HistoryPos++ & ((p)->HistorySize - 1)] = (Byte)(sym); (p)->ReplayLeft++; }
+
+#define PPMD8_RECORD(p, sym) \
+    { if ((p)->History) (p)->History[(p)->HistoryPos++ & ((p)->HistorySize - 1)] = (Byte)(sym); }
+
+/* Binary contexts (one state) are inline in the coders, as in Ppmd7.h.
+   The suffix, the only load that may miss the cache, comes last. */
+static inline UInt16 *Ppmd8_GetBinSumm(CPpmd8 *p)
+{
+  const CPpmd_State *s = Ppmd8Context_OneState(p->MinContext);
+  unsigned col = p->PrevSuccess + p->MinContext->Flags + ((p->RunLength >> 26) & 0x20);
+  return &p->BinSumm[p->NS2Indx[(size_t)s->Freq - 1]][col +
+      p->NS2BSIndx[Ppmd8_GetContext(p, p->MinContext->Suffix)->NumStats]];
+}
+
+/* after a binary context coded its state p->FoundState */
+static inline void Ppmd8_UpdateBin(CPpmd8 *p)
+{
+  CPpmd_State *s = p->FoundState;
+  CPpmd8_Context *c = Ppmd8_GetContext(p, (CPpmd8_Context_Ref)Ppmd_GetSuccessor(s));
+  s->Freq = (Byte)(s->Freq + (s->Freq < 196));
+  p->PrevSuccess = 1;
+  p->RunLength++;
+  if (p->OrderFall == 0 && (Byte *)c >= p->UnitsStart)
+  {
+    PPMD8_RECORD(p, s->Symbol)
+    p->MinContext = p->MaxContext = c;
+  }
+  else
+    Ppmd8_NextContext(p);
+}
+
+/* the same test as Ppmd7_InRun, outside of a replay */
+static inline int Ppmd8_InRun(CPpmd8 *p)
+{
+  CPpmd8_Context *mc = p->MinContext;
+  return mc->NumStats == 0 && p->OrderFall == 0 && p->ReplayLeft == 0 &&
+      Ppmd8_GetContext(p, (CPpmd8_Context_Ref)Ppmd_GetSuccessor(Ppmd8Context_OneState(mc))) == mc;
+}
+
 
 /* ---------- Decode ---------- */
 
 Bool Ppmd8_RangeDec_Init(CPpmd8 *p);
 #define Ppmd8_RangeDec_IsFinishedOK(p) ((p)->Code == 0)
 int Ppmd8_DecodeSymbol(CPpmd8 *p); /* returns: -1 as EndMarker, -2 as DataError */
+/* symbols of a run in one loop, without reading input, see Ppmd7_DecodeRun */
+size_t Ppmd8_DecodeRun(CPpmd8 *p, Byte *dest, size_t size);
 
 
 /* ---------- Encode ---------- */
@@ -129,5 +237,7 @@ int Ppmd8_DecodeSymbol(CPpmd8 *p); /* returns: -1 as EndMarker, -2 as DataError
 void Ppmd8_RangeEnc_Init(CPpmd8 *p);
 void Ppmd8_RangeEnc_FlushData(CPpmd8 *p);
 void Ppmd8_EncodeSymbol(CPpmd8 *p, int symbol); /* symbol = -1 means EndMarker */
+/* leading run symbols of src, without writing output, see Ppmd7_EncodeRun */
+size_t Ppmd8_EncodeRun(CPpmd8 *p, const Byte *src, size_t size);
 
 #endif
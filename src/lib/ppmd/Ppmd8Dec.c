@@ -4,7 +4,16 @@ This code is based on:
   PPMd var.I (2002): Dmitry Shkarin : Public domain
   Carryless rangecoder (1999): Dmitry Subbotin : Public domain */
 
+#include <string.h>
+
 #include "Ppmd8.h"
+#include "PpmdMask.h"
+#include "CpuArch.h"
+
+/* The successor of the decoded state becomes the next context when the model
+   is not extended, so it is fetched while the frequencies are updated. */
+#define PrefetchSuccessor(p, s) Ppmd_Prefetch(Ppmd8_GetContext(p, \
+    ((CPpmd_Void_Ref)Ppmd_GetSuccessor(s))))
 
 #define kTop (1 << 24)
 #define kBot (1 << 15)
@@ -15,15 +24,67 @@ Bool Ppmd8_RangeDec_Init(CPpmd8 *p)
   p->Low = 0;
   p->Range = 0xFFFFFFFF;
   p->Code = 0;
+  #ifdef PPMD_USE_RECIPROCAL
+  Ppmd_RecipCache_Init(&p->Recip);
+  #endif
   for (i = 0; i < 4; i++)
     p->Code = (p->Code << 8) | IByteIn_Read(p->Stream.In);
   return (p->Code < 0xFFFFFFFF);
 }
 
+#ifdef PPMD_USE_RECIPROCAL
+/* Code / Range < h  <=>  Code < h * Range, so the threshold is Code itself and
+   cumulative frequencies are scaled by Range instead. h * Range never exceeds
+   the Range before the division by total, so the products do not overflow. */
+static UInt32 RangeDec_GetThreshold(CPpmd8 *p, UInt32 total)
+{
+  p->Range = Ppmd_RecipCache_Div(&p->Recip, p->Range, total);
+  return p->Code;
+}
+#define RangeDec_Below(p, count, h) ((count) < (h) * (p)->Range)
+#define RangeDec_BinThreshold(p) ((p)->Code)
+#else
 static UInt32 RangeDec_GetThreshold(CPpmd8 *p, UInt32 total)
 {
   return p->Code / (p->Range /= total);
 }
+#define RangeDec_Below(p, count, h) ((count) < (h))
+#define RangeDec_BinThreshold(p) ((p)->Code / (p)->Range)
+#endif
+
+/* Same steps as the carry-less loop
+     while ((Low ^ (Low + Range)) < kTop || (Range < kBot && (Range = (0 - Low) & (kBot - 1), 1)))
+       shift in one byte;
+   but all leading bytes shared by Low and Low + Range are shifted in at once. */
+static void RangeDec_Normalize(CPpmd8 *p)
+{
+  for (;;)
+  {
+    UInt32 x = p->Low ^ (p->Low + p->Range);
+    unsigned n;
+    if (x < kTop)
+    {
+      n = (x == 0) ? 3 : Ppmd_Clz32(x) >> 3;
+      p->Code = (p->Code << 8) | IByteIn_Read(p->Stream.In);
+      if (n > 1)
+      {
+        p->Code = (p->Code << 8) | IByteIn_Read(p->Stream.In);
+        if (n > 2)
+          p->Code = (p->Code << 8) | IByteIn_Read(p->Stream.In);
+      }
+    }
+    else if (p->Range < kBot)
+    {
+      p->Range = (0 - p->Low) & (kBot - 1);
+      p->Code = (p->Code << 8) | IByteIn_Read(p->Stream.In);
+      n = 1;
+    }
+    else
+      return;
+    p->Range <<= 8 * n;
+    p->Low <<= 8 * n;
+  }
+}
 
 static void RangeDec_Decode(CPpmd8 *p, UInt32 start, UInt32 size)
 {
@@ -31,32 +92,72 @@ static void RangeDec_Decode(CPpmd8 *p, UInt32 start, UInt32 size)
   p->Low += start;
   p->Code -= start;
   p->Range *= size;
+  RangeDec_Normalize(p);
+}
 
-  while ((p->Low ^ (p->Low + p->Range)) < kTop ||
-      (p->Range < kBot && ((p->Range = (0 - p->Low) & (kBot - 1)), 1)))
+/* see EncodeRoot in Ppmd8Enc.c */
+static int DecodeRoot(CPpmd8 *p)
+{
+  const CPpmd8_Context *mc = Ppmd8_GetRoot(p);
+  UInt32 count;
+  if (mc->NumStats != 0)
   {
-    p->Code = (p->Code << 8) | IByteIn_Read(p->Stream.In);
-    p->Range <<= 8;
-    p->Low <<= 8;
+    const CPpmd_State *s = Ppmd8_GetStats(p, mc);
+    UInt32 hiCnt = 0;
+    unsigned i = (unsigned)mc->NumStats + 1;
+    count = RangeDec_GetThreshold(p, mc->SummFreq);
+    do
+    {
+      if (RangeDec_Below(p, count, hiCnt += s->Freq))
+      {
+        RangeDec_Decode(p, hiCnt - s->Freq, s->Freq);
+        return s->Symbol;
+      }
+      s++;
+    }
+    while (--i);
+    if (!RangeDec_Below(p, count, mc->SummFreq))
+      return -2;
+    RangeDec_Decode(p, hiCnt, mc->SummFreq - hiCnt);
   }
+  RangeDec_GetThreshold(p, PPMD8_ROOT_ESCAPE_TOTAL);
+  /* Range is divided by the total either way */
+  count = p->Code / p->Range;
+  if (count >= PPMD8_ROOT_ESCAPE_TOTAL)
+    return -2;
+  RangeDec_Decode(p, count, 1);
+  return (count == 0x100) ? -1 : (int)count;
 }
 
-#define MASK(sym) ((signed char *)charMask)[sym]
-
 int Ppmd8_DecodeSymbol(CPpmd8 *p)
 {
-  size_t charMask[256 / sizeof(size_t)];
+  CPpmd_CharMask charMask;
+  if (p->ReplayLeft != 0)
+  {
+    Ppmd8_Replay(p);
+    if (p->ReplayLeft != 0)
+    {
+      int symbol = DecodeRoot(p);
+      if (symbol >= 0)
+        PPMD8_QUEUE(p, symbol)
+      return symbol;
+    }
+  }
+  /* the suffix is visited on escapes and by UpdateModel */
+  Ppmd_Prefetch(Ppmd8_GetContext(p, p->MinContext->Suffix));
   if (p->MinContext->NumStats != 0)
   {
     CPpmd_State *s = Ppmd8_GetStats(p, p->MinContext);
     unsigned i;
     UInt32 count, hiCnt;
-    if ((count = RangeDec_GetThreshold(p, p->MinContext->SummFreq)) < (hiCnt = s->Freq))
+    count = RangeDec_GetThreshold(p, p->MinContext->SummFreq);
+    if (RangeDec_Below(p, count, hiCnt = s->Freq))
     {
       Byte symbol;
       RangeDec_Decode(p, 0, s->Freq);
       p->FoundState = s;
       symbol = s->Symbol;
+      PrefetchSuccessor(p, p->FoundState);
       Ppmd8_Update1_0(p);
       return symbol;
     }
@@ -64,92 +165,128 @@ int Ppmd8_DecodeSymbol(CPpmd8 *p)
     i = p->MinContext->NumStats;
     do
     {
-      if ((hiCnt += (++s)->Freq) > count)
+      if (RangeDec_Below(p, count, hiCnt += (++s)->Freq))
       {
         Byte symbol;
         RangeDec_Decode(p, hiCnt - s->Freq, s->Freq);
         p->FoundState = s;
         symbol = s->Symbol;
+        PrefetchSuccessor(p, p->FoundState);
         Ppmd8_Update1(p);
         return symbol;
       }
     }
     while (--i);
-    if (count >= p->MinContext->SummFreq)
+    if (!RangeDec_Below(p, count, p->MinContext->SummFreq))
       return -2;
     RangeDec_Decode(p, hiCnt, p->MinContext->SummFreq - hiCnt);
-    PPMD_SetAllBitsIn256Bytes(charMask);
-    MASK(s->Symbol) = 0;
-    i = p->MinContext->NumStats;
-    do { MASK((--s)->Symbol) = 0; } while (--i);
+    PPMD_CHARMASK_SET_ALL(&charMask);
+    Ppmd_MaskStates(Ppmd8_GetStats(p, p->MinContext), (unsigned)p->MinContext->NumStats + 1, &charMask);
   }
   else
   {
+    CPpmd_State *s = Ppmd8Context_OneState(p->MinContext);
     UInt16 *prob = Ppmd8_GetBinSumm(p);
-    if (((p->Code / (p->Range >>= 14)) < *prob))
+    UInt32 size0 = *prob;
+    p->Range >>= 14;
+    if (RangeDec_Below(p, RangeDec_BinThreshold(p), size0))
     {
-      Byte symbol;
-      RangeDec_Decode(p, 0, *prob);
-      *prob = (UInt16)PPMD_UPDATE_PROB_0(*prob);
-      symbol = (p->FoundState = Ppmd8Context_OneState(p->MinContext))->Symbol;
+      Byte symbol = s->Symbol;
+      RangeDec_Decode(p, 0, size0);
+      *prob = (UInt16)PPMD_UPDATE_PROB_0(size0);
+      p->FoundState = s;
+      PrefetchSuccessor(p, s);
       Ppmd8_UpdateBin(p);
       return symbol;
     }
-    RangeDec_Decode(p, *prob, (1 << 14) - *prob);
-    *prob = (UInt16)PPMD_UPDATE_PROB_1(*prob);
-    p->InitEsc = PPMD8_kExpEscape[*prob >> 10];
-    PPMD_SetAllBitsIn256Bytes(charMask);
-    MASK(Ppmd8Context_OneState(p->MinContext)->Symbol) = 0;
+    RangeDec_Decode(p, size0, (1 << 14) - size0);
+    *prob = (UInt16)(size0 = PPMD_UPDATE_PROB_1(size0));
+    p->InitEsc = PPMD8_kExpEscape[size0 >> 10];
+    PPMD_CHARMASK_SET_ALL(&charMask);
+    PPMD_CHARMASK_CLEAR(&charMask, s->Symbol);
     p->PrevSuccess = 0;
   }
   for (;;)
   {
-    CPpmd_State *ps[256], *s;
+    CPpmd_State *s;
     UInt32 freqSum, count, hiCnt;
     CPpmd_See *see;
-    unsigned i, num, numMasked = p->MinContext->NumStats;
+    unsigned num, numMasked = p->MinContext->NumStats;
     do
     {
       p->OrderFall++;
       if (!p->MinContext->Suffix)
         return -1;
       p->MinContext = Ppmd8_GetContext(p, p->MinContext->Suffix);
+      Ppmd_Prefetch(Ppmd8_GetContext(p, p->MinContext->Suffix));
     }
     while (p->MinContext->NumStats == numMasked);
-    hiCnt = 0;
     s = Ppmd8_GetStats(p, p->MinContext);
-    i = 0;
-    num = p->MinContext->NumStats - numMasked;
-    do
-    {
-      int k = (int)(MASK(s->Symbol));
-      hiCnt += (s->Freq & k);
-      ps[i] = s++;
-      i -= k;
-    }
-    while (i != num);
+    num = (unsigned)p->MinContext->NumStats + 1;
+    hiCnt = Ppmd_MaskedFreqSum(s, num, &charMask);
     
     see = Ppmd8_MakeEscFreq(p, numMasked, &freqSum);
     freqSum += hiCnt;
     count = RangeDec_GetThreshold(p, freqSum);
     
-    if (count < hiCnt)
+    if (RangeDec_Below(p, count, hiCnt))
     {
       Byte symbol;
-      CPpmd_State **pps = ps;
-      for (hiCnt = 0; (hiCnt += (*pps)->Freq) <= count; pps++);
-      s = *pps;
+      for (hiCnt = 0; !RangeDec_Below(p, count, hiCnt += s->Freq & PPMD_CHARMASK_GET(&charMask, s->Symbol)); s++);
       RangeDec_Decode(p, hiCnt - s->Freq, s->Freq);
       Ppmd_See_Update(see);
       p->FoundState = s;
       symbol = s->Symbol;
+      PrefetchSuccessor(p, p->FoundState);
       Ppmd8_Update2(p);
       return symbol;
     }
-    if (count >= freqSum)
+    if (!RangeDec_Below(p, count, freqSum))
       return -2;
     RangeDec_Decode(p, hiCnt, freqSum - hiCnt);
     see->Summ = (UInt16)(see->Summ + freqSum);
-    do { MASK(ps[--i]->Symbol) = 0; } while (i != 0);
+    Ppmd_MaskStates(s, num, &charMask);
+  }
+}
+
+size_t Ppmd8_DecodeRun(CPpmd8 *p, Byte *dest, size_t size)
+{
+  CPpmd8_Context *mc = p->MinContext;
+  CPpmd_State *s = Ppmd8Context_OneState(mc);
+  UInt16 *prob, *next;
+  UInt32 size0;
+  size_t n;
+  if (!Ppmd8_InRun(p))
+    return 0;
+  /* the binary path and Ppmd8_UpdateBin for a bit 0 in a context that stays,
+     as long as RangeDec_Normalize has nothing to do */
+  prob = Ppmd8_GetBinSumm(p);
+  size0 = *prob;
+  for (n = 0; n < size; n++)
+  {
+    UInt32 range = (p->Range >> 14) * size0;
+    if (p->Code >= range || (p->Low ^ (p->Low + range)) < kTop || range < kBot)
+      break;
+    p->Range = range;
+    size0 = PPMD_UPDATE_PROB_0(size0);
+    p->FoundState = s;
+    s->Freq = (Byte)(s->Freq + (s->Freq < 196));
+    p->PrevSuccess = 1;
+    p->RunLength++;
+    PPMD8_RECORD(p, s->Symbol)
+    /* the entry only moves while Freq grows */
+    next = Ppmd8_GetBinSumm(p);
+    if (next != prob)
+    {
+      *prob = (UInt16)size0;
+      size0 = *(prob = next);
+    }
+  }
+  *prob = (UInt16)size0;
+  if (n != 0)
+  {
+    p->MaxContext = mc;
+    memset(dest, s->Symbol, n);
   }
+  return n;
 }
@@ -5,6 +5,8 @@ This code is based on:
   Carryless rangecoder (1999): Dmitry Subbotin : Public domain */
 
 #include "Ppmd8.h"
+#include "PpmdMask.h"
+#include "CpuArch.h"
 
 #define kTop (1 << 24)
 #define kBot (1 << 15)
@@ -13,6 +15,9 @@ void Ppmd8_RangeEnc_Init(CPpmd8 *p)
 {
     p->Low = 0;
     p->Range = 0xFFFFFFFF;
+    #ifdef PPMD_USE_RECIPROCAL
+    Ppmd_RecipCache_Init(&p->Recip);
+    #endif
 }
 
 void Ppmd8_RangeEnc_FlushData(CPpmd8 *p)
@@ -22,20 +27,49 @@ void Ppmd8_RangeEnc_FlushData(CPpmd8 *p)
     IByteOut_Write(p->Stream.Out, (Byte)(p->Low >> 24));
 }
 
+/* Same steps as the carry-less loop
+     while ((Low ^ (Low + Range)) < kTop || (Range < kBot && (Range = (0 - Low) & (kBot - 1), 1)))
+       shift out one byte;
+   but all leading bytes shared by Low and Low + Range are shifted out at once. */
 static void RangeEnc_Normalize(CPpmd8 *p)
 {
-  while ((p->Low ^ (p->Low + p->Range)) < kTop ||
-      (p->Range < kBot && ((p->Range = (0 - p->Low) & (kBot - 1)), 1)))
+  for (;;)
   {
-    IByteOut_Write(p->Stream.Out, (Byte)(p->Low >> 24));
-    p->Range <<= 8;
-    p->Low <<= 8;
+    UInt32 x = p->Low ^ (p->Low + p->Range);
+    unsigned n;
+    if (x < kTop)
+    {
+      n = (x == 0) ? 3 : Ppmd_Clz32(x) >> 3;
+      IByteOut_Write(p->Stream.Out, (Byte)(p->Low >> 24));
+      if (n > 1)
+      {
+        IByteOut_Write(p->Stream.Out, (Byte)(p->Low >> 16));
+        if (n > 2)
+          IByteOut_Write(p->Stream.Out, (Byte)(p->Low >> 8));
+      }
+    }
+    else if (p->Range < kBot)
+    {
+      p->Range = (0 - p->Low) & (kBot - 1);
+      IByteOut_Write(p->Stream.Out, (Byte)(p->Low >> 24));
+      n = 1;
+    }
+    else
+      return;
+    p->Range <<= 8 * n;
+    p->Low <<= 8 * n;
   }
 }
 
+#ifdef PPMD_USE_RECIPROCAL
+#define RangeEnc_Scale(p, total) Ppmd_RecipCache_Div(&(p)->Recip, (p)->Range, total)
+#else
+#define RangeEnc_Scale(p, total) ((p)->Range / (total))
+#endif
+
 static void RangeEnc_Encode(CPpmd8 *p, UInt32 start, UInt32 size, UInt32 total)
 {
-  p->Low += start * (p->Range /= total);
+  p->Low += start * (p->Range = RangeEnc_Scale(p, total));
   p->Range *= size;
   RangeEnc_Normalize(p);
 }
@@ -54,12 +88,45 @@ static void RangeEnc_EncodeBit_1(CPpmd8 *p, UInt32 size0)
   RangeEnc_Normalize(p);
 }
 
-
-#define MASK(sym) ((signed char *)charMask)[sym]
+/* A symbol while the replay is pending: the order-0 context as the model has
+   it now, then an escape to PPMD8_ROOT_ESCAPE_TOTAL equal values. */
+static void EncodeRoot(CPpmd8 *p, int symbol)
+{
+  const CPpmd8_Context *mc = Ppmd8_GetRoot(p);
+  if (mc->NumStats != 0)
+  {
+    const CPpmd_State *s = Ppmd8_GetStats(p, mc);
+    UInt32 sum = 0;
+    unsigned i = (unsigned)mc->NumStats + 1;
+    do
+    {
+      if (s->Symbol == symbol)
+      {
+        RangeEnc_Encode(p, sum, s->Freq, mc->SummFreq);
+        return;
+      }
+      sum += (s++)->Freq;
+    }
+    while (--i);
+    RangeEnc_Encode(p, sum, mc->SummFreq - sum, mc->SummFreq);
+  }
+  RangeEnc_Encode(p, (symbol < 0) ? 0x100 : (UInt32)symbol, 1, PPMD8_ROOT_ESCAPE_TOTAL);
+}
 
 void Ppmd8_EncodeSymbol(CPpmd8 *p, int symbol)
 {
-  size_t charMask[256 / sizeof(size_t)];
+  CPpmd_CharMask charMask;
+  if (p->ReplayLeft != 0)
+  {
+    Ppmd8_Replay(p);
+    if (p->ReplayLeft != 0)
+    {
+      EncodeRoot(p, symbol);
+      if (symbol >= 0)
+        PPMD8_QUEUE(p, symbol)
+      return;
+    }
+  }
   if (p->MinContext->NumStats != 0)
   {
     CPpmd_State *s = Ppmd8_GetStats(p, p->MinContext);
@@ -88,31 +155,30 @@ void Ppmd8_EncodeSymbol(CPpmd8 *p, int symbol)
     }
     while (--i);
     
-    PPMD_SetAllBitsIn256Bytes(charMask);
-    MASK(s->Symbol) = 0;
-    i = p->MinContext->NumStats;
-    do { MASK((--s)->Symbol) = 0; } while (--i);
+    PPMD_CHARMASK_SET_ALL(&charMask);
+    Ppmd_MaskStates(Ppmd8_GetStats(p, p->MinContext), (unsigned)p->MinContext->NumStats + 1, &charMask);
     RangeEnc_Encode(p, sum, p->MinContext->SummFreq - sum, p->MinContext->SummFreq);
   }
   else
   {
-    UInt16 *prob = Ppmd8_GetBinSumm(p);
     CPpmd_State *s = Ppmd8Context_OneState(p->MinContext);
+    UInt16 *prob = Ppmd8_GetBinSumm(p);
+    UInt32 size0 = *prob;
     if (s->Symbol == symbol)
     {
-      RangeEnc_EncodeBit_0(p, *prob);
-      *prob = (UInt16)PPMD_UPDATE_PROB_0(*prob);
+      RangeEnc_EncodeBit_0(p, size0);
+      *prob = (UInt16)PPMD_UPDATE_PROB_0(size0);
       p->FoundState = s;
       Ppmd8_UpdateBin(p);
       return;
     }
     else
     {
-      RangeEnc_EncodeBit_1(p, *prob);
-      *prob = (UInt16)PPMD_UPDATE_PROB_1(*prob);
-      p->InitEsc = PPMD8_kExpEscape[*prob >> 10];
-      PPMD_SetAllBitsIn256Bytes(charMask);
-      MASK(s->Symbol) = 0;
+      RangeEnc_EncodeBit_1(p, size0);
+      *prob = (UInt16)(size0 = PPMD_UPDATE_PROB_1(size0));
+      p->InitEsc = PPMD8_kExpEscape[size0 >> 10];
+      PPMD_CHARMASK_SET_ALL(&charMask);
+      PPMD_CHARMASK_CLEAR(&charMask, s->Symbol);
       p->PrevSuccess = 0;
     }
   }
@@ -121,8 +187,8 @@ void Ppmd8_EncodeSymbol(CPpmd8 *p, int symbol)
     UInt32 escFreq;
     CPpmd_See *see;
     CPpmd_State *s;
-    UInt32 sum;
-    unsigned i, numMasked = p->MinContext->NumStats;
+    UInt32 low, sum;
+    unsigned i, num, numMasked = p->MinContext->NumStats;
     do
     {
       p->OrderFall++;
@@ -134,34 +200,57 @@ void Ppmd8_EncodeSymbol(CPpmd8 *p, int symbol)
     
     see = Ppmd8_MakeEscFreq(p, numMasked, &escFreq);
     s = Ppmd8_GetStats(p, p->MinContext);
-    sum = 0;
-    i = p->MinContext->NumStats + 1;
-    do
+    num = (unsigned)p->MinContext->NumStats + 1;
+    i = Ppmd_MaskedFreqScan(s, num, (unsigned)symbol, &charMask, &low, &sum);
+    if (i != num)
     {
-      int cur = s->Symbol;
-      if (cur == symbol)
-      {
-        UInt32 low = sum;
-        CPpmd_State *s1 = s;
-        do
-        {
-          sum += (s->Freq & (int)(MASK(s->Symbol)));
-          s++;
-        }
-        while (--i);
-        RangeEnc_Encode(p, low, s1->Freq, sum + escFreq);
-        Ppmd_See_Update(see);
-        p->FoundState = s1;
-        Ppmd8_Update2(p);
-        return;
-      }
-      sum += (s->Freq & (int)(MASK(cur)));
-      MASK(cur) = 0;
-      s++;
+      RangeEnc_Encode(p, low, s[i].Freq, sum + escFreq);
+      Ppmd_See_Update(see);
+      p->FoundState = s + i;
+      Ppmd8_Update2(p);
+      return;
     }
-    while (--i);
+    Ppmd_MaskStates(s, num, &charMask);
     
     RangeEnc_Encode(p, sum, escFreq, sum + escFreq);
     see->Summ = (UInt16)(see->Summ + sum + escFreq);
   }
 }
+
+size_t Ppmd8_EncodeRun(CPpmd8 *p, const Byte *src, size_t size)
+{
+  CPpmd8_Context *mc = p->MinContext;
+  CPpmd_State *s = Ppmd8Context_OneState(mc);
+  UInt16 *prob, *next;
+  UInt32 size0;
+  size_t n;
+  if (!Ppmd8_InRun(p))
+    return 0;
+  /* RangeEnc_EncodeBit_0 and Ppmd8_UpdateBin in a context that stays */
+  prob = Ppmd8_GetBinSumm(p);
+  size0 = *prob;
+  for (n = 0; n < size && src[n] == s->Symbol; n++)
+  {
+    UInt32 range = (p->Range >> 14) * size0;
+    if ((p->Low ^ (p->Low + range)) < kTop || range < kBot)
+      break;
+    p->Range = range;
+    size0 = PPMD_UPDATE_PROB_0(size0);
+    p->FoundState = s;
+    s->Freq = (Byte)(s->Freq + (s->Freq < 196));
+    p->PrevSuccess = 1;
+    p->RunLength++;
+    PPMD8_RECORD(p, s->Symbol)
+    /* the entry only moves while Freq grows */
+    next = Ppmd8_GetBinSumm(p);
+    if (next != prob)
+    {
+      *prob = (UInt16)size0;
+      size0 = *(prob = next);
+    }
+  }
+  *prob = (UInt16)size0;
+  if (n != 0)
+    p->MaxContext = mc;
+  return n;
+}
@@ -0,0 +1,68 @@
+//
+// PpmdDiv.h -- division by recurring frequency totals without a divide instruction
+//
+
+#ifndef PPMD_DIV_H
+#define PPMD_DIV_H
+
+#include "Ppmd.h"
+#include "CpuArch.h"
+
+/*
+  n / d for 32-bit n and 1 <= d < 2^32 is computed as
+
+    t = (m * n) >> 32;  q = (t + ((n - t) >> s1)) >> s2
+
+  with l = ceil(log2(d)), m = 2^32 * (2^l - d) / d + 1, s1 = min(l, 1) and
+  s2 = max(l - 1, 0) (Granlund and Montgomery, "Division by Invariant
+  Integers using Multiplication", 1994, figure 4.1). The quotient is exact
+  for every n and d, so coded streams do not change.
+
+  Computing m takes a 64-bit division itself, so reciprocals are kept in a
+  direct mapped cache indexed by the low bits of the divisor. Frequency
+  totals stay small, and with 1024 entries nearly all lookups hit; much
+  smaller caches miss too often, as SummFreq moves with every update.
+*/
+typedef struct
+{
+  UInt32 Div;
+  UInt32 Mul;
+  Byte Shift1;
+  Byte Shift2;
+} CPpmd_Recip;
+
+#define PPMD_RECIP_CACHE_BITS 10
+#define PPMD_RECIP_CACHE_SIZE (1 << PPMD_RECIP_CACHE_BITS)
+
+typedef struct
+{
+  CPpmd_Recip Entry[PPMD_RECIP_CACHE_SIZE];
+} CPpmd_RecipCache;
+
+static inline void Ppmd_RecipCache_Init(CPpmd_RecipCache *c)
+{
+  unsigned i;
+  for (i = 0; i < PPMD_RECIP_CACHE_SIZE; i++)
+    c->Entry[i].Div = 0;
+}
+
+static inline void Ppmd_Recip_Set(CPpmd_Recip *r, UInt32 d)
+{
+  unsigned l = (d == 1) ? 0 : 32 - Ppmd_Clz32(d - 1);
+  r->Div = d;
+  r->Mul = (UInt32)((((UInt64)1 << l) - d) * ((UInt64)1 << 32) / d + 1);
+  r->Shift1 = (Byte)(l != 0);
+  r->Shift2 = (Byte)(l != 0 ? l - 1 : 0);
+}
+
+static inline UInt32 Ppmd_RecipCache_Div(CPpmd_RecipCache *c, UInt32 n, UInt32 d)
+{
+  CPpmd_Recip *r = &c->Entry[d & (PPMD_RECIP_CACHE_SIZE - 1)];
+  UInt32 t;
+  if (r->Div != d)
+    Ppmd_Recip_Set(r, d);
+  t = (UInt32)(((UInt64)r->Mul * n) >> 32);
+  return (t + ((n - t) >> r->Shift1)) >> r->Shift2;
+}
+
+#endif // PPMD_DIV_H
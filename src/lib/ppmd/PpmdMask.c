@@ -0,0 +1,388 @@
+//
+// PpmdMask.c -- masked frequency sums for the PPMd escape paths
+//
+
+#include "PpmdMask.h"
+#include "CpuArch.h"
+
+#include <string.h>
+
+#ifdef PPMD_SIMD_X86
+#include <immintrin.h>
+#endif
+#ifdef PPMD_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+static UInt32 MaskedFreqSum_Scalar(const CPpmd_State *s, unsigned num, const CPpmd_CharMask *mask)
+{
+  UInt32 sum = 0;
+  for (; num != 0; num--, s++)
+    sum += s->Freq & PPMD_CHARMASK_GET(mask, s->Symbol);
+  return sum;
+}
+
+static unsigned MaskedFreqScan_Scalar(const CPpmd_State *s, unsigned num, unsigned symbol,
+    const CPpmd_CharMask *mask, UInt32 *low, UInt32 *total)
+{
+  unsigned i;
+  for (i = 0; i != num && s[i].Symbol != symbol; i++);
+  *low = MaskedFreqSum_Scalar(s, i, mask);
+  *total = *low + MaskedFreqSum_Scalar(s + i, num - i, mask);
+  return i;
+}
+
+#ifdef PPMD_SIMD_X86
+
+/*
+  Eight 6-byte states span 48 bytes, i.e. three 16-byte loads. The shuffles
+  gather the (Symbol, Freq) pair of every state into one 16-bit lane, so
+  sixteen states are processed per step. The 256-bit mask is looked up
+  with PSHUFB on its two 16-byte halves (byte index = Symbol >> 3) and the
+  selected bit is tested against a (1 << (Symbol & 7)) table.
+*/
+
+PPMD_TARGET("ssse3")
+static __m128i LoadStatePairs(const Byte *p)
+{
+  const __m128i sh0 = _mm_setr_epi8(0, 1, 6, 7, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i sh1 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 3, 8, 9, 14, 15, -1, -1, -1, -1);
+  const __m128i sh2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 5, 10, 11);
+  __m128i v0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)p), sh0);
+  __m128i v1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)(p + 16)), sh1);
+  __m128i v2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)(p + 32)), sh2);
+  return _mm_or_si128(_mm_or_si128(v0, v1), v2);
+}
+
+/* splits 16 states into their Symbol and Freq bytes */
+PPMD_TARGET("ssse3")
+static void LoadStates16(const CPpmd_State *s, __m128i *sym, __m128i *freq)
+{
+  const __m128i low8 = _mm_set1_epi16(0xFF);
+  __m128i a = LoadStatePairs((const Byte *)s);
+  __m128i b = LoadStatePairs((const Byte *)(s + 8));
+  *sym = _mm_packus_epi16(_mm_and_si128(a, low8), _mm_and_si128(b, low8));
+  *freq = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+}
+
+/* 0xFF for every unmasked symbol */
+PPMD_TARGET("ssse3")
+static __m128i UnmaskedSymbols(__m128i sym, __m128i maskLo, __m128i maskHi)
+{
+  const __m128i bitTable = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+  __m128i idx = _mm_and_si128(_mm_srli_epi16(sym, 3), _mm_set1_epi8(0x1F));
+  __m128i hi = _mm_cmpgt_epi8(idx, _mm_set1_epi8(15));
+  __m128i bits = _mm_or_si128(
+      _mm_and_si128(hi, _mm_shuffle_epi8(maskHi, idx)),
+      _mm_andnot_si128(hi, _mm_shuffle_epi8(maskLo, idx)));
+  __m128i bit = _mm_shuffle_epi8(bitTable, _mm_and_si128(sym, _mm_set1_epi8(7)));
+  return _mm_cmpeq_epi8(_mm_and_si128(bits, bit), bit);
+}
+
+PPMD_TARGET("ssse3")
+static UInt32 HorizontalSum(__m128i acc)
+{
+  return (UInt32)_mm_cvtsi128_si32(acc) + (UInt32)_mm_cvtsi128_si32(_mm_unpackhi_epi64(acc, acc));
+}
+
+PPMD_TARGET("ssse3")
+static UInt32 MaskedFreqSum_SSSE3(const CPpmd_State *s, unsigned num, const CPpmd_CharMask *mask)
+{
+  const __m128i maskLo = _mm_loadu_si128((const __m128i *)(const void *)mask->Bits);
+  const __m128i maskHi = _mm_loadu_si128((const __m128i *)(const void *)(mask->Bits + 16));
+  __m128i acc = _mm_setzero_si128();
+  for (; num >= 16; num -= 16, s += 16)
+  {
+    __m128i sym, freq;
+    LoadStates16(s, &sym, &freq);
+    freq = _mm_and_si128(freq, UnmaskedSymbols(sym, maskLo, maskHi));
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(freq, _mm_setzero_si128()));
+  }
+  return HorizontalSum(acc) + MaskedFreqSum_Scalar(s, num, mask);
+}
+
+/* index of symbol in s[0 .. num), or num; the x86 kernels share it */
+PPMD_TARGET("ssse3")
+static unsigned FindSymbol_SSSE3(const CPpmd_State *s, unsigned num, unsigned symbol)
+{
+  const __m128i key = _mm_set1_epi8((char)symbol);
+  unsigned i;
+  if (symbol > 0xFF)
+    return num; /* end marker */
+  for (i = 0; i + 16 <= num; i += 16)
+  {
+    __m128i sym, freq;
+    UInt32 bits;
+    LoadStates16(s + i, &sym, &freq);
+    bits = (UInt32)_mm_movemask_epi8(_mm_cmpeq_epi8(sym, key));
+    if (bits != 0)
+      return i + Ppmd_Ctz32(bits);
+  }
+  for (; i != num && s[i].Symbol != symbol; i++);
+  return i;
+}
+
+static unsigned MaskedFreqScan_SSSE3(const CPpmd_State *s, unsigned num, unsigned symbol,
+    const CPpmd_CharMask *mask, UInt32 *low, UInt32 *total)
+{
+  unsigned i = FindSymbol_SSSE3(s, num, symbol);
+  *low = MaskedFreqSum_SSSE3(s, i, mask);
+  *total = *low + MaskedFreqSum_SSSE3(s + i, num - i, mask);
+  return i;
+}
+
+/*
+  The AVX2 and AVX-512 kernels gather 32 and 64 states with the SSSE3
+  shuffles above and test and sum them in one step; the rest of a context
+  goes to the next narrower kernel. PSHUFB looks up within 16-byte blocks
+  only, so both halves of the mask are broadcast to every block and the
+  half is picked per symbol.
+*/
+
+PPMD_TARGET("avx2")
+static __m256i UnmaskedSymbols_AVX2(__m256i sym, __m256i maskLo, __m256i maskHi)
+{
+  const __m256i bitTable = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128));
+  __m256i idx = _mm256_and_si256(_mm256_srli_epi16(sym, 3), _mm256_set1_epi8(0x1F));
+  __m256i bits = _mm256_blendv_epi8(_mm256_shuffle_epi8(maskLo, idx), _mm256_shuffle_epi8(maskHi, idx),
+      _mm256_cmpgt_epi8(idx, _mm256_set1_epi8(15)));
+  __m256i bit = _mm256_shuffle_epi8(bitTable, _mm256_and_si256(sym, _mm256_set1_epi8(7)));
+  return _mm256_cmpeq_epi8(_mm256_and_si256(bits, bit), bit);
+}
+
+/* splits 32 states into their Symbol and Freq bytes */
+PPMD_TARGET("avx2")
+static void LoadStates32(const CPpmd_State *s, __m256i *sym, __m256i *freq)
+{
+  __m128i sym0, freq0, sym1, freq1;
+  LoadStates16(s, &sym0, &freq0);
+  LoadStates16(s + 16, &sym1, &freq1);
+  *sym = _mm256_inserti128_si256(_mm256_castsi128_si256(sym0), sym1, 1);
+  *freq = _mm256_inserti128_si256(_mm256_castsi128_si256(freq0), freq1, 1);
+}
+
+PPMD_TARGET("avx2")
+static UInt32 MaskedFreqSum_AVX2(const CPpmd_State *s, unsigned num, const CPpmd_CharMask *mask)
+{
+  const __m256i maskLo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(const void *)mask->Bits));
+  const __m256i maskHi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(const void *)(mask->Bits + 16)));
+  __m256i acc = _mm256_setzero_si256();
+  for (; num >= 32; num -= 32, s += 32)
+  {
+    __m256i sym, freq;
+    LoadStates32(s, &sym, &freq);
+    freq = _mm256_and_si256(freq, UnmaskedSymbols_AVX2(sym, maskLo, maskHi));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(freq, _mm256_setzero_si256()));
+  }
+  return HorizontalSum(_mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1)))
+      + MaskedFreqSum_SSSE3(s, num, mask);
+}
+
+static unsigned MaskedFreqScan_AVX2(const CPpmd_State *s, unsigned num, unsigned symbol,
+    const CPpmd_CharMask *mask, UInt32 *low, UInt32 *total)
+{
+  unsigned i = FindSymbol_SSSE3(s, num, symbol);
+  *low = MaskedFreqSum_AVX2(s, i, mask);
+  *total = *low + MaskedFreqSum_AVX2(s + i, num - i, mask);
+  return i;
+}
+
+#ifndef PPMD_NO_AVX512
+
+PPMD_TARGET("avx512f,avx512bw")
+static UInt32 MaskedFreqSum_AVX512(const CPpmd_State *s, unsigned num, const CPpmd_CharMask *mask)
+{
+  const __m512i maskLo = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(const void *)mask->Bits));
+  const __m512i maskHi = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(const void *)(mask->Bits + 16)));
+  const __m512i bitTable = _mm512_broadcast_i32x4(
+      _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128));
+  __m512i acc = _mm512_setzero_si512();
+  for (; num >= 64; num -= 64, s += 64)
+  {
+    __m256i sym0, freq0, sym1, freq1;
+    LoadStates32(s, &sym0, &freq0);
+    LoadStates32(s + 32, &sym1, &freq1);
+    {
+      __m512i sym = _mm512_inserti64x4(_mm512_castsi256_si512(sym0), sym1, 1);
+      __m512i freq = _mm512_inserti64x4(_mm512_castsi256_si512(freq0), freq1, 1);
+      __m512i idx = _mm512_and_si512(_mm512_srli_epi16(sym, 3), _mm512_set1_epi8(0x1F));
+      __mmask64 hi = _mm512_cmpgt_epi8_mask(idx, _mm512_set1_epi8(15));
+      __m512i bits = _mm512_mask_shuffle_epi8(_mm512_shuffle_epi8(maskLo, idx), hi, maskHi, idx);
+      __m512i bit = _mm512_shuffle_epi8(bitTable, _mm512_and_si512(sym, _mm512_set1_epi8(7)));
+      __mmask64 keep = _mm512_test_epi8_mask(bits, bit);
+      acc = _mm512_add_epi64(acc, _mm512_sad_epu8(_mm512_maskz_mov_epi8(keep, freq), _mm512_setzero_si512()));
+    }
+  }
+  return (UInt32)_mm512_reduce_add_epi64(acc) + MaskedFreqSum_AVX2(s, num, mask);
+}
+
+static unsigned MaskedFreqScan_AVX512(const CPpmd_State *s, unsigned num, unsigned symbol,
+    const CPpmd_CharMask *mask, UInt32 *low, UInt32 *total)
+{
+  unsigned i = FindSymbol_SSSE3(s, num, symbol);
+  *low = MaskedFreqSum_AVX512(s, i, mask);
+  *total = *low + MaskedFreqSum_AVX512(s + i, num - i, mask);
+  return i;
+}
+
+#endif // PPMD_NO_AVX512
+
+#endif // PPMD_SIMD_X86
+
+#ifdef PPMD_SIMD_NEON
+
+/*
+  VLD3 on 16-bit elements splits eight 6-byte states into (Symbol, Freq),
+  SuccessorLow and SuccessorHigh; narrowing the first one gives the Symbol
+  and Freq bytes. TBL looks the mask bytes up in all 32 bytes at once.
+*/
+
+/* splits 16 states into their Symbol and Freq bytes */
+static void LoadStates16_NEON(const CPpmd_State *s, uint8x16_t *sym, uint8x16_t *freq)
+{
+  uint16x8x3_t a = vld3q_u16((const uint16_t *)(const void *)s);
+  uint16x8x3_t b = vld3q_u16((const uint16_t *)(const void *)(s + 8));
+  *sym = vcombine_u8(vmovn_u16(a.val[0]), vmovn_u16(b.val[0]));
+  *freq = vcombine_u8(vshrn_n_u16(a.val[0], 8), vshrn_n_u16(b.val[0], 8));
+}
+
+static UInt32 MaskedFreqSum_NEON(const CPpmd_State *s, unsigned num, const CPpmd_CharMask *mask)
+{
+  uint8x16x2_t table;
+  uint16x8_t acc = vdupq_n_u16(0);
+  table.val[0] = vld1q_u8(mask->Bits);
+  table.val[1] = vld1q_u8(mask->Bits + 16);
+  for (; num >= 16; num -= 16, s += 16)
+  {
+    uint8x16_t sym, freq, bits, bit;
+    LoadStates16_NEON(s, &sym, &freq);
+    bits = vqtbl2q_u8(table, vshrq_n_u8(sym, 3));
+    bit = vshlq_u8(vdupq_n_u8(1), vreinterpretq_s8_u8(vandq_u8(sym, vdupq_n_u8(7))));
+    /* at most 16 steps of 2 * 255 per 16-bit lane */
+    acc = vpadalq_u8(acc, vandq_u8(freq, vtstq_u8(bits, bit)));
+  }
+  return vaddlvq_u16(acc) + MaskedFreqSum_Scalar(s, num, mask);
+}
+
+static unsigned FindSymbol_NEON(const CPpmd_State *s, unsigned num, unsigned symbol)
+{
+  const uint8x16_t key = vdupq_n_u8((uint8_t)symbol);
+  unsigned i;
+  if (symbol > 0xFF)
+    return num; /* end marker */
+  for (i = 0; i + 16 <= num; i += 16)
+  {
+    uint8x16_t sym, freq;
+    UInt64 bits;
+    LoadStates16_NEON(s + i, &sym, &freq);
+    /* four bits per lane */
+    bits = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vceqq_u8(sym, key)), 4)), 0);
+    if (bits != 0)
+      return i + ((((UInt32)bits != 0) ? Ppmd_Ctz32((UInt32)bits) : 32 + Ppmd_Ctz32((UInt32)(bits >> 32))) >> 2);
+  }
+  for (; i != num && s[i].Symbol != symbol; i++);
+  return i;
+}
+
+static unsigned MaskedFreqScan_NEON(const CPpmd_State *s, unsigned num, unsigned symbol,
+    const CPpmd_CharMask *mask, UInt32 *low, UInt32 *total)
+{
+  unsigned i = FindSymbol_NEON(s, num, symbol);
+  *low = MaskedFreqSum_NEON(s, i, mask);
+  *total = *low + MaskedFreqSum_NEON(s + i, num - i, mask);
+  return i;
+}
+
+#endif // PPMD_SIMD_NEON
+
+static const char *g_KernelName = NULL;
+
+void Ppmd_SelectKernels(UInt32 features)
+{
+  Ppmd_MaskedFreqSum_Func sum = MaskedFreqSum_Scalar;
+  Ppmd_MaskedFreqScan_Func scan = MaskedFreqScan_Scalar;
+  const char *name = "scalar";
+  (void)features; /* unused without SIMD kernels */
+#ifdef PPMD_SIMD_X86
+  if (features & PPMD_CPU_SSSE3)
+  {
+    sum = MaskedFreqSum_SSSE3;
+    scan = MaskedFreqScan_SSSE3;
+    name = "ssse3";
+  }
+  /* the wider kernels still gather the states with SSSE3 */
+  if ((features & (PPMD_CPU_SSSE3 | PPMD_CPU_AVX2)) == (PPMD_CPU_SSSE3 | PPMD_CPU_AVX2))
+  {
+    sum = MaskedFreqSum_AVX2;
+    scan = MaskedFreqScan_AVX2;
+    name = "avx2";
+    #ifndef PPMD_NO_AVX512
+    if (features & PPMD_CPU_AVX512BW)
+    {
+      sum = MaskedFreqSum_AVX512;
+      scan = MaskedFreqScan_AVX512;
+      name = "avx512bw";
+    }
+    #endif
+  }
+#endif
+#ifdef PPMD_SIMD_NEON
+  if (features & PPMD_CPU_NEON)
+  {
+    sum = MaskedFreqSum_NEON;
+    scan = MaskedFreqScan_NEON;
+    name = "neon";
+  }
+#endif
+  /* every thread selects the same kernels, so racing stores are harmless */
+  Ppmd_MaskedFreqSum_Vec = sum;
+  Ppmd_MaskedFreqScan_Vec = scan;
+  g_KernelName = name;
+}
+
+const char *Ppmd_KernelName(void)
+{
+  if (g_KernelName == NULL)
+    Ppmd_SelectKernels(Ppmd_GetCpuFeatures());
+  return g_KernelName;
+}
+
+UInt32 Ppmd_KernelFeatures(const char *name)
+{
+  if (name == NULL || *name == 0)
+    return ~(UInt32)0;
+  if (strcmp(name, "scalar") == 0)
+    return 0;
+  if (strcmp(name, "ssse3") == 0)
+    return PPMD_CPU_SSSE3;
+  if (strcmp(name, "avx2") == 0)
+    return PPMD_CPU_SSSE3 | PPMD_CPU_AVX2;
+  if (strcmp(name, "avx512bw") == 0)
+    return PPMD_CPU_SSSE3 | PPMD_CPU_AVX2 | PPMD_CPU_AVX512BW;
+  if (strcmp(name, "neon") == 0)
+    return PPMD_CPU_NEON;
+  return ~(UInt32)0;
+}
+
+static UInt32 MaskedFreqSum_Init(const CPpmd_State *s, unsigned num, const CPpmd_CharMask *mask)
+{
+  Ppmd_SelectKernels(Ppmd_GetCpuFeatures());
+  return Ppmd_MaskedFreqSum_Vec(s, num, mask);
+}
+
+static unsigned MaskedFreqScan_Init(const CPpmd_State *s, unsigned num, unsigned symbol,
+    const CPpmd_CharMask *mask, UInt32 *low, UInt32 *total)
+{
+  Ppmd_SelectKernels(Ppmd_GetCpuFeatures());
+  return Ppmd_MaskedFreqScan_Vec(s, num, symbol, mask, low, total);
+}
+
+Ppmd_MaskedFreqSum_Func Ppmd_MaskedFreqSum_Vec = MaskedFreqSum_Init;
+Ppmd_MaskedFreqScan_Func Ppmd_MaskedFreqScan_Vec = MaskedFreqScan_Init;
+
+void Ppmd_MaskStates(const CPpmd_State *s, unsigned num, CPpmd_CharMask *mask)
+{
+  for (; num != 0; num--, s++)
+    PPMD_CHARMASK_CLEAR(mask, s->Symbol);
+}
@@ -0,0 +1,77 @@
+//
+// PpmdMask.h -- symbol exclusion mask used by the PPMd escape paths
+//
+
+#ifndef PPMD_MASK_H
+#define PPMD_MASK_H
+
+#include "Ppmd.h"
+
+/* One bit per symbol. A set bit means the symbol was not seen in a
+   higher order context yet and still takes part in frequency sums. */
+typedef struct
+{
+  Byte Bits[32];
+} CPpmd_CharMask;
+
+#define PPMD_CHARMASK_SET_ALL(m) \
+  { unsigned z; for (z = 0; z < 32; z += 4) { \
+  (m)->Bits[z+3] = (m)->Bits[z+2] = (m)->Bits[z+1] = (m)->Bits[z+0] = 0xFF; }}
+
+#define PPMD_CHARMASK_CLEAR(m, sym) ((m)->Bits[(unsigned)(sym) >> 3] &= (Byte)~(1 << ((sym) & 7)))
+
+/* 0 for a masked symbol, 0xFFFFFFFF for an unmasked one */
+#define PPMD_CHARMASK_GET(m, sym) ((UInt32)0 - (((m)->Bits[(unsigned)(sym) >> 3] >> ((sym) & 7)) & 1))
+
+/* Vector kernels only pay off for larger contexts */
+#define PPMD_MASK_VEC_MIN 16
+
+typedef UInt32 (*Ppmd_MaskedFreqSum_Func)(const CPpmd_State *s, unsigned num, const CPpmd_CharMask *mask);
+typedef unsigned (*Ppmd_MaskedFreqScan_Func)(const CPpmd_State *s, unsigned num, unsigned symbol,
+    const CPpmd_CharMask *mask, UInt32 *low, UInt32 *total);
+
+/* Selected for the running CPU on first use, or by Ppmd_SelectKernels */
+extern Ppmd_MaskedFreqSum_Func Ppmd_MaskedFreqSum_Vec;
+extern Ppmd_MaskedFreqScan_Func Ppmd_MaskedFreqScan_Vec;
+
+/* Selects the widest kernels the PPMD_CPU_* features allow. Bindings call it
+   once when they are loaded; it must not race with running coders. */
+void Ppmd_SelectKernels(UInt32 features);
+/* "scalar", "ssse3", "avx2", "avx512bw" or "neon" */
+const char *Ppmd_KernelName(void);
+/* Features a kernel name stands for, all of them for NULL or an unknown name;
+   Ppmd_SelectKernels(Ppmd_GetCpuFeatures() & Ppmd_KernelFeatures(name)) caps
+   the selection at that kernel. */
+UInt32 Ppmd_KernelFeatures(const char *name);
+
+/* Returns the sum of Freq of the states s[0 .. num) whose symbols are not masked. */
+static inline UInt32 Ppmd_MaskedFreqSum(const CPpmd_State *s, unsigned num, const CPpmd_CharMask *mask)
+{
+  UInt32 sum = 0;
+  if (num >= PPMD_MASK_VEC_MIN)
+    return Ppmd_MaskedFreqSum_Vec(s, num, mask);
+  for (; num != 0; num--, s++)
+    sum += s->Freq & PPMD_CHARMASK_GET(mask, s->Symbol);
+  return sum;
+}
+
+/* Returns the index of symbol in s[0 .. num), or num when it is absent
+   (including the end marker, which is passed as (unsigned)-1).
+   *total receives the masked sum of all states, and *low the masked sum
+   of the states in front of the symbol. */
+static inline unsigned Ppmd_MaskedFreqScan(const CPpmd_State *s, unsigned num, unsigned symbol,
+    const CPpmd_CharMask *mask, UInt32 *low, UInt32 *total)
+{
+  unsigned i;
+  if (num >= PPMD_MASK_VEC_MIN)
+    return Ppmd_MaskedFreqScan_Vec(s, num, symbol, mask, low, total);
+  for (i = 0; i != num && s[i].Symbol != symbol; i++);
+  *low = Ppmd_MaskedFreqSum(s, i, mask);
+  *total = *low + Ppmd_MaskedFreqSum(s + i, num - i, mask);
+  return i;
+}
+
+/* Masks the symbols of the states s[0 .. num). */
+void Ppmd_MaskStates(const CPpmd_State *s, unsigned num, CPpmd_CharMask *mask);
+
+#endif // PPMD_MASK_H
@@ -0,0 +1,58 @@
+//
+// PpmdSort.h -- halving and sorting of the states of a context in Rescale
+//
+
+#ifndef PPMD_SORT_H
+#define PPMD_SORT_H
+
+#include <string.h>
+
+#include "Ppmd.h"
+
+/*
+  Rescale halves every Freq of a context and sorts the states by Freq,
+  descending, with an insertion sort. The model moves a state only one step
+  up at a time, so large contexts are far from sorted and the insertion sort
+  is quadratic there. It is also stable, so a counting sort over the halved
+  frequencies gives the same order in two passes over the states. Below
+  PPMD_SORT_MIN states the insertion sort is faster (see utils/bench_rescale.py).
+*/
+#define PPMD_SORT_MIN 32
+
+/* Sets Freq = (Freq + adder) >> 1 for s[1 .. num), num >= 2, where s[0] was
+   halved by the caller, and sorts s[0 .. num) as the insertion sort does.
+   Returns the sum of s[1 .. num).Freq before halving; *sumFreq receives the
+   sum of all the halved frequencies. */
+static inline unsigned Ppmd_HalveSortStates(CPpmd_State *s, unsigned num, unsigned adder, unsigned *sumFreq)
+{
+  UInt16 start[256];
+  CPpmd_State sorted[256];
+  unsigned i, f, pos, oldSum = 0, newSum = s[0].Freq, maxFreq = s[0].Freq;
+  memset(start, 0, sizeof(start));
+  start[s[0].Freq]++;
+  for (i = 1; i < num; i++)
+  {
+    f = s[i].Freq;
+    oldSum += f;
+    f = (f + adder) >> 1;
+    s[i].Freq = (Byte)f;
+    newSum += f;
+    start[f]++;
+    if (maxFreq < f)
+      maxFreq = f;
+  }
+  /* start[f]: the number of states with a higher Freq */
+  for (pos = 0, f = maxFreq + 1; f-- != 0;)
+  {
+    unsigned c = start[f];
+    start[f] = (UInt16)pos;
+    pos += c;
+  }
+  for (i = 0; i < num; i++)
+    sorted[start[s[i].Freq]++] = s[i];
+  memcpy(s, sorted, num * sizeof(CPpmd_State));
+  *sumFreq = newSum;
+  return oldSum;
+}
+
+#endif // PPMD_SORT_H
@@ -1,4 +1,10 @@
-from typing import Union
+import itertools
+import os
+import struct
+import time
+import zlib
+from concurrent.futures import ThreadPoolExecutor
+from typing import List, NamedTuple, Optional, Sequence, Union
 
 try:
     from importlib.metadata import PackageNotFoundError, version
@@ -7,24 +13,42 @@ except ImportError:
 
 try:
     from .c.c_ppmd import (  # noqa
+        PPMD8_FILTER_DELTA,
+        PPMD8_FILTER_NONE,
+        PPMD8_FILTER_TRANSPOSE,
+        PPMD8_FILTER_X86,
         PPMD8_RESTORE_METHOD_CUT_OFF,
+        PPMD8_RESTORE_METHOD_REPLAY,
         PPMD8_RESTORE_METHOD_RESTART,
         Ppmd7Decoder,
         Ppmd7Encoder,
         Ppmd8Decoder,
         Ppmd8Encoder,
         PpmdError,
+        cpu_features,
+        decompress_many,
+        parse_ppmd7_props,
+        ppmd7_props,
     )
 except ImportError:
     try:
         from .cffi.cffi_ppmd import (  # noqa
+            PPMD8_FILTER_DELTA,
+            PPMD8_FILTER_NONE,
+            PPMD8_FILTER_TRANSPOSE,
+            PPMD8_FILTER_X86,
             PPMD8_RESTORE_METHOD_CUT_OFF,
+            PPMD8_RESTORE_METHOD_REPLAY,
             PPMD8_RESTORE_METHOD_RESTART,
             Ppmd7Decoder,
             Ppmd7Encoder,
             Ppmd8Decoder,
             Ppmd8Encoder,
             PpmdError,
+            cpu_features,
+            decompress_many,
+            parse_ppmd7_props,
+            ppmd7_props,
         )
     except ImportError:
         msg = "pyppmd module: Neither C implementation nor CFFI " "implementation can be imported."
@@ -33,8 +57,23 @@ except ImportError:
 __all__ = (
     "compress",
     "decompress",
+    "compress_frame",
+    "decompress_frame",
+    "frame_info",
+    "FrameInfo",
+    "tune",
+    "TuneResult",
+    "decompress_many",
+    "cpu_features",
+    "ppmd7_props",
+    "parse_ppmd7_props",
     "PPMD8_RESTORE_METHOD_RESTART",
     "PPMD8_RESTORE_METHOD_CUT_OFF",
+    "PPMD8_RESTORE_METHOD_REPLAY",
+    "PPMD8_FILTER_NONE",
+    "PPMD8_FILTER_DELTA",
+    "PPMD8_FILTER_X86",
+    "PPMD8_FILTER_TRANSPOSE",
     "Ppmd7Encoder",
     "Ppmd7Decoder",
     "Ppmd8Encoder",
@@ -219,6 +258,267 @@ def _decompress8(data: Union[bytes, bytearray, memoryview], max_order: int, mem_
     return res
 
 
+# Frame format, all integers little endian:
+#   magic "PPMF", version, flags, variant (7 or 8), max order, restore method,
+#   a reserved zero byte and the memory size (32 bit): 14 bytes,
+#   the content size (64 bit) when FRAME_CONTENT_SIZE is set,
+#   the PPMd stream, with an end mark when FRAME_ENDMARK is set,
+#   the CRC32 of the content (32 bit) when FRAME_CHECKSUM is set.
+FRAME_MAGIC = b"PPMF"
+FRAME_VERSION = 1
+FRAME_CONTENT_SIZE = 0x01
+FRAME_CHECKSUM = 0x02
+FRAME_ENDMARK = 0x04
+_frame_header = struct.Struct("<4sBBBBBBI")
+_frame_size = struct.Struct("<Q")
+_frame_checksum = struct.Struct("<I")
+# Even a run of one byte costs about 1/2700 byte of stream, so a content size beyond
+# this many times the stream size is corrupt and must not size the output.
+FRAME_MAX_RATIO = 4096
+
+
+class FrameInfo(NamedTuple):
+    """Parameters stored in the header of a PPMd frame."""
+
+    variant: str
+    max_order: int
+    mem_size: int
+    restore_method: int
+    content_size: Optional[int]
+    checksum: bool
+    header_size: int
+
+
+def compress_frame(
+    data_or_str: Union[bytes, bytearray, memoryview, str],
+    *,
+    max_order: int = 6,
+    mem_size: int = 16 << 20,
+    variant: str = "I",
+    restore_method: int = PPMD8_RESTORE_METHOD_RESTART,
+    content_size: bool = True,
+    checksum: bool = True,
+) -> bytes:
+    """Compress a block of data into a self-describing PPMd frame, return a bytes object.
+
+    Arguments
+    data_or_str:    A bytes-like object or string data to be compressed.
+    max_order:      An integer object represent compression level.
+    mem_size:       An integer object represent memory size to use.
+    variant:        A variant name of PPMd compression algorithms, accept only "H" or "I"
+    restore_method: a PPMD8_RESTORE_METHOD_* constant, variant "I" only
+    content_size:   Store the uncompressed size; otherwise the stream ends with an end mark.
+                    Variant "H" frames always store it.
+    checksum:       Append the CRC32 of the uncompressed data.
+    """
+    if variant not in ["H", "I", "h", "i"]:
+        raise ValueError("Unsupported PPMd variant")
+    if type(data_or_str) == str:
+        data = data_or_str.encode("UTF-8")
+    elif _is_bytelike(data_or_str):
+        data = data_or_str
+    else:
+        raise ValueError("Argument data_or_str is neither bytes-like object nor str.")
+    if variant in ["I", "i"]:
+        comp = Ppmd8Encoder(max_order, mem_size, restore_method)
+        variant_id = 8
+    else:
+        if not content_size:
+            raise ValueError("Variant H frames need the content size.")
+        comp = Ppmd7Encoder(max_order, mem_size)
+        variant_id = 7
+        restore_method = 0
+    flags = (FRAME_CONTENT_SIZE if content_size else FRAME_ENDMARK) | (FRAME_CHECKSUM if checksum else 0)
+    result = [_frame_header.pack(FRAME_MAGIC, FRAME_VERSION, flags, variant_id, max_order, restore_method, 0, mem_size)]
+    if content_size:
+        result.append(_frame_size.pack(len(data)))
+    result.append(comp.encode(data))
+    result.append(comp.flush(endmark=not content_size))
+    if checksum:
+        result.append(_frame_checksum.pack(zlib.crc32(data)))
+    return b"".join(result)
+
+
+def frame_info(data: Union[bytes, bytearray, memoryview]) -> FrameInfo:
+    """Parse the header of a PPMd frame, return a FrameInfo.
+
+    Arguments
+    data: A bytes-like object starting with a PPMd frame.
+    """
+    if not _is_bytelike(data):
+        raise ValueError("Argument data should be bytes-like object.")
+    if len(data) < _frame_header.size:
+        raise PpmdError("Data is too short for a PPMd frame header.")
+    magic, version, flags, variant_id, max_order, restore_method, reserved, mem_size = _frame_header.unpack_from(data)
+    if magic != FRAME_MAGIC:
+        raise PpmdError("Not a PPMd frame.")
+    if version != FRAME_VERSION or flags & ~(FRAME_CONTENT_SIZE | FRAME_CHECKSUM | FRAME_ENDMARK) or reserved != 0:
+        raise PpmdError("Unsupported PPMd frame version or flags.")
+    if variant_id == 8:
+        variant = "I"
+    elif variant_id == 7 and flags & FRAME_CONTENT_SIZE:
+        variant = "H"
+    else:
+        raise PpmdError("Unsupported PPMd variant in frame header.")
+    if not flags & (FRAME_CONTENT_SIZE | FRAME_ENDMARK):
+        raise PpmdError("PPMd frame has neither a content size nor an end mark.")
+    header_size = _frame_header.size
+    size = None
+    if flags & FRAME_CONTENT_SIZE:
+        if len(data) < header_size + _frame_size.size:
+            raise PpmdError("Data is too short for a PPMd frame header.")
+        (size,) = _frame_size.unpack_from(data, header_size)
+        header_size += _frame_size.size
+    return FrameInfo(variant, max_order, mem_size, restore_method, size, bool(flags & FRAME_CHECKSUM), header_size)
+
+
+def decompress_frame(data: Union[bytes, bytearray, memoryview]) -> bytes:
+    """Decompress a PPMd frame, return a bytes object.
+
+    The parameters are read from the frame header. When the frame stores the content size,
+    the output is decoded to exactly that length.
+
+    Arguments
+    data: A bytes-like object holding one PPMd frame.
+    """
+    info = frame_info(data)
+    end = len(data)
+    if info.checksum:
+        end -= _frame_checksum.size
+        if end < info.header_size:
+            raise PpmdError("PPMd frame is truncated.")
+    payload = memoryview(data)[info.header_size : end]
+    if info.content_size is not None and info.content_size > len(payload) * FRAME_MAX_RATIO:
+        raise PpmdError("PPMd frame content size does not fit its stream.")
+    if info.content_size == 0:
+        res = b""
+    elif info.variant == "I":
+        decomp = Ppmd8Decoder(info.max_order, info.mem_size, restore_method=info.restore_method)
+        if info.content_size is None:
+            res = decomp.decode(payload)
+        else:
+            res = decomp.decode(payload, info.content_size, exact=True)
+    else:
+        decomp = Ppmd7Decoder(info.max_order, info.mem_size)
+        res = decomp.decode(payload, info.content_size, exact=True)
+    if len(res) != info.content_size if info.content_size is not None else not decomp.eof:
+        raise PpmdError("PPMd frame is truncated.")
+    if info.checksum and _frame_checksum.unpack_from(data, end)[0] != zlib.crc32(res):
+        raise PpmdError("PPMd frame checksum mismatch.")
+    return res
+
+
+class TuneResult(NamedTuple):
+    """Outcome of one trial compression of tune()."""
+
+    variant: str
+    max_order: int
+    mem_size: int
+    restore_method: int
+    ratio: float
+    speed: float
+    compressed_size: int
+    restarts: int
+    cutoffs: int
+    peak_memory: int
+
+
+def _tune_chain(data, variant, max_order, restore_method, mem_sizes, deadline, done):
+    results = []
+    for mem_size in mem_sizes:
+        # the first trial always runs, so there is a result whatever the budget
+        if done and deadline is not None and time.monotonic() >= deadline:
+            break
+        if variant == "I":
+            comp = Ppmd8Encoder(max_order, mem_size, restore_method)
+        else:
+            comp = Ppmd7Encoder(max_order, mem_size)
+        start = time.perf_counter()
+        size = len(comp.encode(data))
+        size += len(comp.flush())
+        elapsed = max(time.perf_counter() - start, 1e-9)
+        stats = comp.stats()
+        result = TuneResult(
+            variant,
+            max_order,
+            mem_size,
+            restore_method,
+            len(data) / max(size, 1),
+            len(data) / elapsed / 1e6,
+            size,
+            stats["restarts"],
+            stats["cutoffs"],
+            stats["peak_memory"],
+        )
+        results.append(result)
+        done.append(result)
+        # the memory never ran out, so a larger mem_size builds the same model
+        if result.restarts == 0 and result.cutoffs == 0:
+            break
+    return results
+
+
+def _pareto(results):
+    frontier = []
+    for r in sorted(results, key=lambda r: (r.compressed_size, -r.speed, r.mem_size)):
+        # sorted by size, so a result is dominated unless it is faster than all kept so far
+        if not frontier or r.speed > frontier[-1].speed:
+            frontier.append(r)
+    return frontier
+
+
+def tune(
+    sample: Union[bytes, bytearray, memoryview, str],
+    *,
+    time_budget: Optional[float] = 5.0,
+    variants: Sequence[str] = ("H", "I"),
+    orders: Sequence[int] = (3, 4, 6, 8, 12, 16),
+    mem_sizes: Sequence[int] = (1 << 20, 4 << 20, 16 << 20, 64 << 20, 256 << 20),
+    restore_methods: Sequence[int] = (PPMD8_RESTORE_METHOD_RESTART, PPMD8_RESTORE_METHOD_CUT_OFF),
+    workers: Optional[int] = None,
+) -> List[TuneResult]:
+    """Trial compress a sample under several parameter sets, return the Pareto frontier
+    of ratio against speed as a list of TuneResult, best ratio first.
+
+    Arguments
+    sample:          A bytes-like object or string data typical of the input.
+    time_budget:     Seconds after which no new trial starts, or None to run them all.
+    variants:        PPMd variant names to try, "H" and/or "I".
+    orders:          Max orders to try.
+    mem_sizes:       Memory sizes to try. Larger sizes are skipped once a smaller one
+                     ran without restarts or cut-offs, as they build the same model.
+    restore_methods: Restore methods to try with variant "I".
+    workers:         Number of threads, default the number of CPUs.
+    """
+    if type(sample) == str:
+        data = sample.encode("UTF-8")
+    elif _is_bytelike(sample):
+        data = sample
+    else:
+        raise ValueError("Argument sample is neither bytes-like object nor str.")
+    chains = []
+    for variant in variants:
+        if variant not in ["H", "I", "h", "i"]:
+            raise ValueError("Unsupported PPMd variant")
+        variant = variant.upper()
+        methods = restore_methods if variant == "I" else (PPMD8_RESTORE_METHOD_RESTART,)
+        chains.extend((variant, order, method) for order, method in itertools.product(orders, methods))
+    if not chains or not mem_sizes:
+        raise ValueError("Nothing to tune: no variant, order, memory size or restore method given.")
+    # cheap models first, so a short budget still covers every chain at least once
+    chains.sort(key=lambda c: c[1])
+    mem_sizes = sorted(mem_sizes)
+    deadline = None if time_budget is None else time.monotonic() + time_budget
+    done: List[TuneResult] = []
+    with ThreadPoolExecutor(max_workers=workers or os.cpu_count() or 1) as executor:
+        futures = [
+            executor.submit(_tune_chain, data, variant, order, method, mem_sizes, deadline, done)
+            for variant, order, method in chains
+        ]
+        results = [r for future in futures for r in future.result()]
+    return _pareto(results)
+
+
 def _is_bytelike(data):
     if isinstance(data, bytes) or isinstance(data, bytearray) or isinstance(data, memoryview):
         return True
@@ -1,20 +1,38 @@
 from ._ppmd import (
+    PPMD8_FILTER_DELTA,
+    PPMD8_FILTER_NONE,
+    PPMD8_FILTER_TRANSPOSE,
+    PPMD8_FILTER_X86,
     PPMD8_RESTORE_METHOD_CUT_OFF,
+    PPMD8_RESTORE_METHOD_REPLAY,
     PPMD8_RESTORE_METHOD_RESTART,
     Ppmd7Decoder,
     Ppmd7Encoder,
     Ppmd8Decoder,
     Ppmd8Encoder,
+    cpu_features,
+    decompress_many,
+    parse_ppmd7_props,
+    ppmd7_props,
 )
 
 __all__ = (
     "PPMD8_RESTORE_METHOD_CUT_OFF",
+    "PPMD8_RESTORE_METHOD_REPLAY",
     "PPMD8_RESTORE_METHOD_RESTART",
+    "PPMD8_FILTER_NONE",
+    "PPMD8_FILTER_DELTA",
+    "PPMD8_FILTER_X86",
+    "PPMD8_FILTER_TRANSPOSE",
     "Ppmd7Encoder",
     "Ppmd7Decoder",
     "Ppmd8Encoder",
     "Ppmd8Decoder",
     "PpmdError",
+    "decompress_many",
+    "cpu_features",
+    "ppmd7_props",
+    "parse_ppmd7_props",
 )
 
 
@@ -1,3 +1,5 @@
+import os
+import struct
 import sys
 from threading import Lock
 from typing import Union
@@ -10,13 +12,27 @@ __all__ = (
     "Ppmd8Encoder",
     "Ppmd8Decoder",
     "PpmdError",
+    "decompress_many",
+    "cpu_features",
+    "ppmd7_props",
+    "parse_ppmd7_props",
     "PPMD8_RESTORE_METHOD_RESTART",
     "PPMD8_RESTORE_METHOD_CUT_OFF",
+    "PPMD8_RESTORE_METHOD_REPLAY",
+    "PPMD8_FILTER_NONE",
+    "PPMD8_FILTER_DELTA",
+    "PPMD8_FILTER_X86",
+    "PPMD8_FILTER_TRANSPOSE",
 )
 
 PPMD8_RESTORE_METHOD_RESTART = 0
 PPMD8_RESTORE_METHOD_CUT_OFF = 1
+PPMD8_RESTORE_METHOD_REPLAY = 4
 # PPMD8_RESTORE_METHOD_FREEZE = 2
+PPMD8_FILTER_NONE = 0
+PPMD8_FILTER_DELTA = 1
+PPMD8_FILTER_X86 = 2
+PPMD8_FILTER_TRANSPOSE = 3
 
 _PPMD7_MIN_ORDER = 2
 _PPMD7_MAX_ORDER = 64
@@ -25,6 +41,12 @@ _PPMD7_MIN_MEM_SIZE = 1 << 11
 _PPMD7_MAX_MEM_SIZE = 0xFFFFFFFF - 12 * 3
 
 _BLOCK_SIZE = 16384
+
+# select the kernels once, before any coder can run
+_kernel = os.environ.get("PYPPMD_KERNEL")
+lib.Ppmd_SelectKernels(
+    lib.Ppmd_GetCpuFeatures() & lib.Ppmd_KernelFeatures(ffi.NULL if _kernel is None else _kernel.encode("ascii"))
+)
 _allocated = []
 
 CFFI_PYPPMD = True
@@ -75,6 +97,16 @@ class _BlocksOutputBuffer:
         256 * MB,
     )
     MEM_ERR_MSG = "Unable to allocate output buffer."
+    # Largest output allocated as one block when the caller states its exact length
+    EXACT_LIMIT = 1024 * MB
+    # Expansion assumed until a decoder has seen output, PPMd on text is 3-6x
+    DEFAULT_RATIO = 4.0
+
+    @classmethod
+    def estimate(cls, in_size, in_total, out_total):
+        # Expected output for in_size bytes of input, with a quarter of headroom
+        ratio = out_total / in_total if in_total > 0 else cls.DEFAULT_RATIO
+        return min(int(in_size * ratio * 1.25), cls.BUFFER_BLOCK_SIZE[-1])
 
     def initAndGrow(self, out, max_length):
         # Set & check max_length
@@ -98,6 +130,40 @@ class _BlocksOutputBuffer:
         out.size = block_size
         out.pos = 0
 
+    def initExact(self, out, max_length):
+        # One block of exactly max_length, returned without joining blocks;
+        # only for a max_length that is the output size, not a bound
+        if max_length < 0 or max_length > self.EXACT_LIMIT:
+            return self.initAndGrow(out, max_length)
+        block = _new_nonzero("char[]", max_length)
+        if block == ffi.NULL:
+            raise MemoryError(self.MEM_ERR_MSG)
+        self.list = [block]
+        self.max_length = max_length
+        self.allocated = max_length
+        out.dst = block
+        out.size = max_length
+        out.pos = 0
+
+    def initEstimate(self, out, max_length, estimate, exact=False):
+        # An exact length is allocated in one block, otherwise the first block is the
+        # estimate up to max_length
+        if exact and 0 <= max_length <= self.EXACT_LIMIT:
+            return self.initExact(out, max_length)
+        if estimate <= self.BUFFER_BLOCK_SIZE[0]:
+            return self.initAndGrow(out, max_length)
+        if 0 <= max_length < estimate:
+            estimate = max_length
+        block = _new_nonzero("char[]", estimate)
+        if block == ffi.NULL:
+            raise MemoryError(self.MEM_ERR_MSG)
+        self.list = [block]
+        self.max_length = max_length
+        self.allocated = estimate
+        out.dst = block
+        out.size = estimate
+        out.pos = 0
+
     #    def initWithSize(self, out, init_size):
     #        # The first block
     #        block = _new_nonzero("char[]", init_size)
@@ -118,10 +184,16 @@ class _BlocksOutputBuffer:
         # Ensure no gaps in the data
         assert out.pos == out.size
 
-        # Get block size
-        list_len = len(self.list)
-        if list_len < len(self.BUFFER_BLOCK_SIZE):
-            block_size = self.BUFFER_BLOCK_SIZE[list_len]
+        # Get block size, going on from the allocated size when the first
+        # block was larger than the schedule
+        index = 0
+        scheduled = 0
+        while index < len(self.BUFFER_BLOCK_SIZE) and scheduled < self.allocated:
+            scheduled += self.BUFFER_BLOCK_SIZE[index]
+            index += 1
+        index = max(index, len(self.list))
+        if index < len(self.BUFFER_BLOCK_SIZE):
+            block_size = self.BUFFER_BLOCK_SIZE[index]
         else:
             block_size = self.BUFFER_BLOCK_SIZE[-1]
 
@@ -157,6 +229,9 @@ class _BlocksOutputBuffer:
         # Fast path for single block
         if (len(self.list) == 1 and out.pos == out.size) or (len(self.list) == 2 and out.pos == 0):
             return bytes(ffi.buffer(self.list[0]))
+        # Single block filled in part
+        if len(self.list) == 1:
+            return bytes(ffi.buffer(self.list[0], out.pos))
 
         # Final bytes object
         data_size = self.allocated - (out.size - out.pos)
@@ -175,6 +250,14 @@ class _BlocksOutputBuffer:
 
         return bytes(ffi.buffer(final))
 
+    def finishChunks(self, out):
+        # The blocks as a list of buffers, which keep their blocks alive, without copying;
+        # the last one trimmed to the data or dropped when empty
+        chunks = [ffi.buffer(block) for block in self.list[:-1]]
+        if out.pos > 0:
+            chunks.append(ffi.buffer(self.list[-1], out.pos))
+        return chunks
+
 
 class PpmdBaseEncoder:
     def __init__(self):
@@ -247,6 +330,9 @@ class PpmdBaseDecoder:
         self._in_end = 0
         self.closed = False
         self.inited = False
+        # Input consumed and output produced so far, to size the output
+        self._in_total = 0
+        self._out_total = 0
 
     def _release(self):
         ffi.release(self._in_buf)
@@ -322,17 +408,24 @@ class PpmdBaseDecoder:
         # Now in_buf.pos == 0
         return in_buf, use_input_buffer
 
-    def _setup_outBuffer(self):
+    def _setup_outBuffer(self, length=-1, in_size=0, exact=False):
         # Output buffer
         out_buf = _new_nonzero("OutBuffer *")
         if out_buf == ffi.NULL:
             raise MemoryError
         out = _BlocksOutputBuffer()
 
-        # Initialize output buffer
-        out.initAndGrow(out_buf, -1)
+        # Initialize output buffer, in one block when the length is exact
+        out.initEstimate(out_buf, length, out.estimate(in_size, self._in_total, self._out_total), exact)
         return out, out_buf
 
+    def _finish_outBuffer(self, out, out_buf, in_buf, as_chunks=False):
+        self._in_total += in_buf.pos
+        self._out_total += out.allocated - (out_buf.size - out_buf.pos)
+        if as_chunks:
+            return out.finishChunks(out_buf)
+        return out.finish(out_buf)
+
     def _unconsumed_in(self, in_buf, use_input_buffer):
         # Unconsumed input data
         if in_buf.pos == in_buf.size:
@@ -364,6 +457,59 @@ class PpmdBaseDecoder:
             raise PpmdError("Wrong status: input buffer overrun.")
 
 
+_PPMD7_PROPS_MSG = "PPMd7 properties should be 5 bytes: max order 2..64, then memory size."
+
+
+def ppmd7_props(max_order: int, mem_size: int) -> bytes:
+    """Return the 5 byte PPMd coder properties 7z stores for a folder."""
+    if not (_PPMD7_MIN_ORDER <= max_order <= _PPMD7_MAX_ORDER and _PPMD7_MIN_MEM_SIZE <= mem_size <= _PPMD7_MAX_MEM_SIZE):
+        raise ValueError(_PPMD7_PROPS_MSG)
+    return struct.pack("<BI", max_order, mem_size)
+
+
+def parse_ppmd7_props(props) -> tuple:
+    """Return (max_order, mem_size) from 5 byte PPMd coder properties of a 7z folder."""
+    if len(props) != 5:
+        raise ValueError(_PPMD7_PROPS_MSG)
+    max_order, mem_size = struct.unpack("<BI", props)
+    if not (_PPMD7_MIN_ORDER <= max_order <= _PPMD7_MAX_ORDER and _PPMD7_MIN_MEM_SIZE <= mem_size <= _PPMD7_MAX_MEM_SIZE):
+        raise ValueError(_PPMD7_PROPS_MSG)
+    return max_order, mem_size
+
+
+def _check_restore_method(restore_method: int):
+    if restore_method not in (PPMD8_RESTORE_METHOD_RESTART, PPMD8_RESTORE_METHOD_CUT_OFF, PPMD8_RESTORE_METHOD_REPLAY):
+        raise ValueError("restore_method should be one of the PPMD8_RESTORE_METHOD_* constants.")
+
+
+def _new_filter(kind: int, param: int, allocator):
+    if kind == PPMD8_FILTER_NONE:
+        return None
+    f = ffi.new("PpmdFilter *")
+    if not lib.PpmdFilter_Init(f, kind, param, allocator):
+        raise ValueError(
+            "Unknown filter, or filter_param out of range: a distance of 1 to 256 for PPMD8_FILTER_DELTA, "
+            "a record width of 2 to 4096 for PPMD8_FILTER_TRANSPOSE and 0 for PPMD8_FILTER_X86."
+        )
+    if f.buf == ffi.NULL:
+        lib.PpmdFilter_Free(f, allocator)
+        raise MemoryError
+    return f
+
+
+def _model_stats(ppmd, used: int) -> dict:
+    stats = ppmd.Stats
+    return {
+        "mem_size": ppmd.Size,
+        "used_memory": used,
+        "peak_memory": max(stats.PeakUsed, used),
+        "restarts": stats.Restarts,
+        "cutoffs": stats.CutOffs,
+        "glues": stats.Glues,
+        "rescales": stats.Rescales,
+    }
+
+
 class Ppmd7Encoder(PpmdBaseEncoder):
     def __init__(self, max_order: int, mem_size: int):
         if mem_size > sys.maxsize:
@@ -372,6 +518,7 @@ class Ppmd7Encoder(PpmdBaseEncoder):
             _PPMD7_MIN_MEM_SIZE > mem_size or mem_size > _PPMD7_MAX_MEM_SIZE
         ):
             raise ValueError("PPMd wrong parameters.")
+        self._props = struct.pack("<BI", max_order, mem_size)
         self._init_common()
         self.ppmd = ffi.new("CPpmd7 *")
         self.rc = ffi.new("CPpmd7z_RangeEnc *")
@@ -399,6 +546,7 @@ class Ppmd7Encoder(PpmdBaseEncoder):
         out, out_buf = self._setup_outBuffer()
         lib.ppmd7_compress_flush(self.ppmd, self.rc, endmark)
         res = out.finish(out_buf)
+        self._stats = _model_stats(self.ppmd, lib.Ppmd7_GetUsedMemory(self.ppmd))
         lib.ppmd7_state_close(self.ppmd, self._allocator)
         ffi.release(self.ppmd)
         self._release()
@@ -406,6 +554,17 @@ class Ppmd7Encoder(PpmdBaseEncoder):
         self.lock.release()
         return res
 
+    @property
+    def props(self) -> bytes:
+        return self._props
+
+    def stats(self) -> dict:
+        """Return a dict of model memory telemetry: sizes in bytes and event counts."""
+        with self.lock:
+            if self.flushed:
+                return dict(self._stats)
+            return _model_stats(self.ppmd, lib.Ppmd7_GetUsedMemory(self.ppmd))
+
     def __enter__(self):
         return self
 
@@ -419,6 +578,7 @@ class Ppmd7Decoder(PpmdBaseDecoder):
         if mem_size > sys.maxsize:
             raise ValueError("Mem_size exceed to platform limit.")
         if _PPMD7_MIN_ORDER <= max_order <= _PPMD7_MAX_ORDER and _PPMD7_MIN_MEM_SIZE <= mem_size <= _PPMD7_MAX_MEM_SIZE:
+            self._props = struct.pack("<BI", max_order, mem_size)
             self.lock = Lock()
             self._init_common()
             self.ppmd = ffi.new("CPpmd7 *")
@@ -431,7 +591,9 @@ class Ppmd7Decoder(PpmdBaseDecoder):
         else:
             raise ValueError("PPMd wrong parameters.")
 
-    def decode(self, data: Union[bytes, bytearray, memoryview], length: int) -> bytes:
+    def decode(
+        self, data: Union[bytes, bytearray, memoryview], length: int, as_chunks: bool = False, exact: bool = False
+    ):
         if not isinstance(length, int) or length < 0:
             raise PpmdError("Wrong length argument is specified. It should be positive integer.")
         self.lock.acquire()
@@ -439,7 +601,7 @@ class Ppmd7Decoder(PpmdBaseDecoder):
         if not self.inited:
             lib.ppmd7_decompress_init(self.rc, self.reader, self.threadInfo, self._allocator)
             self.inited = True
-        out, out_buf = self._setup_outBuffer()
+        out, out_buf = self._setup_outBuffer(length, in_buf.size, exact)
         remaining: int = length
         out_size = 0
         while remaining > 0:
@@ -457,14 +619,30 @@ class Ppmd7Decoder(PpmdBaseDecoder):
             if out_size == 0:
                 self._needs_input = True
                 break
-            if out_buf.pos == out_buf.size:
-                out.grow(out_buf)
             remaining = remaining - out_size
+            if remaining > 0 and out_buf.pos == out_buf.size:
+                out.grow(out_buf)
+        res = self._finish_outBuffer(out, out_buf, in_buf, as_chunks)
         self._unconsumed_in(in_buf, use_input_buffer)
-        res = out.finish(out_buf)
         self.lock.release()
         return res
 
+    @classmethod
+    def from_props(cls, props):
+        """Create a decoder from the 5 byte PPMd coder properties of a 7z folder."""
+        return cls(*parse_ppmd7_props(props))
+
+    @property
+    def props(self) -> bytes:
+        return self._props
+
+    def stats(self) -> dict:
+        """Return a dict of model memory telemetry: sizes in bytes and event counts."""
+        with self.lock:
+            if self._finished:
+                return dict(self._stats)
+            return _model_stats(self.ppmd, lib.Ppmd7_GetUsedMemory(self.ppmd))
+
     @property
     def needs_input(self):
         return self._needs_input
@@ -480,6 +658,7 @@ class Ppmd7Decoder(PpmdBaseDecoder):
         if self._finished:
             return
         self._finished = True
+        self._stats = _model_stats(self.ppmd, lib.Ppmd7_GetUsedMemory(self.ppmd))
         lib.Ppmd7T_Free(self.ppmd, self.threadInfo, self._allocator)
         ffi.release(self.ppmd)
         ffi.release(self.rc)
@@ -489,11 +668,20 @@ class Ppmd7Decoder(PpmdBaseDecoder):
 
 
 class Ppmd8Encoder(PpmdBaseEncoder):
-    def __init__(self, max_order, mem_size, restore_method=PPMD8_RESTORE_METHOD_RESTART):
+    def __init__(
+        self,
+        max_order,
+        mem_size,
+        restore_method=PPMD8_RESTORE_METHOD_RESTART,
+        filter=PPMD8_FILTER_NONE,
+        filter_param=0,
+    ):
         self.lock = Lock()
+        _check_restore_method(restore_method)
         if mem_size > sys.maxsize:
             raise ValueError("Mem_size exceed to platform limit.")
         self._init_common()
+        self._filter = _new_filter(filter, filter_param, self._allocator)
         self.ppmd = ffi.new("CPpmd8 *")
         lib.ppmd8_compress_init(self.ppmd, self.writer)
         lib.Ppmd8_Construct(self.ppmd)
@@ -505,8 +693,12 @@ class Ppmd8Encoder(PpmdBaseEncoder):
         self.lock.acquire()
         in_buf = self._setup_inBuffer(data)
         out, out_buf = self._setup_outBuffer()
-        while lib.ppmd8_compress(self.ppmd, out_buf, in_buf) > 0:
-            if out_buf.pos == out_buf.size:
+        if self._filter is None:
+            while lib.ppmd8_compress(self.ppmd, out_buf, in_buf) > 0:
+                if out_buf.pos == out_buf.size:
+                    out.grow(out_buf)
+        else:
+            while lib.ppmd8_compress_filtered(self.ppmd, self._filter, out_buf, in_buf) > 0:
                 out.grow(out_buf)
         self.lock.release()
         return out.finish(out_buf)
@@ -516,18 +708,35 @@ class Ppmd8Encoder(PpmdBaseEncoder):
         if self.flushed:
             self.lock.release()
             return
+        # the decoder finds the last block by the end mark
+        if self._filter is not None and self._filter.kind == PPMD8_FILTER_TRANSPOSE and not endmark:
+            self.lock.release()
+            raise ValueError("PPMD8_FILTER_TRANSPOSE needs the end mark.")
         self.flushed = True
         out, out_buf = self._setup_outBuffer()
+        if self._filter is not None:
+            lib.PpmdFilter_EncodeEnd(self._filter)
+            while lib.ppmd8_compress_filtered(self.ppmd, self._filter, out_buf, self._setup_inBuffer(b"")) > 0:
+                out.grow(out_buf)
+            lib.PpmdFilter_Free(self._filter, self._allocator)
         if endmark:
             lib.Ppmd8_EncodeSymbol(self.ppmd, -1)
         lib.Ppmd8_RangeEnc_FlushData(self.ppmd)
         res = out.finish(out_buf)
+        self._stats = _model_stats(self.ppmd, lib.Ppmd8_GetUsedMemory(self.ppmd))
         lib.Ppmd8_Free(self.ppmd, self._allocator)
         ffi.release(self.ppmd)
         self._release()
         self.lock.release()
         return res
 
+    def stats(self) -> dict:
+        """Return a dict of model memory telemetry: sizes in bytes and event counts."""
+        with self.lock:
+            if self.flushed:
+                return dict(self._stats)
+            return _model_stats(self.ppmd, lib.Ppmd8_GetUsedMemory(self.ppmd))
+
     def __enter__(self):
         return self
 
@@ -537,8 +746,20 @@ class Ppmd8Encoder(PpmdBaseEncoder):
 
 
 class Ppmd8Decoder(PpmdBaseDecoder):
-    def __init__(self, max_order: int, mem_size: int, restore_method=PPMD8_RESTORE_METHOD_RESTART):
+    def __init__(
+        self,
+        max_order: int,
+        mem_size: int,
+        restore_method=PPMD8_RESTORE_METHOD_RESTART,
+        filter=PPMD8_FILTER_NONE,
+        filter_param=0,
+    ):
+        _check_restore_method(restore_method)
         self._init_common()
+        self._filter = _new_filter(filter, filter_param, self._allocator)
+        # the coder decodes to the filter, whose output may outlast the end mark
+        self._stage = ffi.new("OutBuffer *")
+        self._filter_state = ffi.new("int *")
         self.ppmd = ffi.new("CPpmd8 *")
         self.threadInfo = ffi.new("ppmd_info *")
         lib.Ppmd8_Construct(self.ppmd)
@@ -553,7 +774,9 @@ class Ppmd8Decoder(PpmdBaseDecoder):
         lib.ppmd8_decompress_init(self.ppmd, self.reader, self.threadInfo, self._allocator)
         lib.Ppmd8_RangeDec_Init(self.ppmd)
 
-    def decode(self, data: Union[bytes, bytearray, memoryview], length: int = -1):
+    def decode(
+        self, data: Union[bytes, bytearray, memoryview], length: int = -1, as_chunks: bool = False, exact: bool = False
+    ):
         if not isinstance(length, int):
             raise PpmdError("Wrong length argument is specified.")
         self.lock.acquire()
@@ -561,31 +784,49 @@ class Ppmd8Decoder(PpmdBaseDecoder):
         # should be no-ops and return empty bytes without touching freed/native state.
         if getattr(self, "_eof", False):
             self.lock.release()
-            return b""
+            return [] if as_chunks else b""
         in_buf, use_input_buffer = self._setup_inBuffer(data)
-        out, out_buf = self._setup_outBuffer()
+        out, out_buf = self._setup_outBuffer(length, in_buf.size, exact)
         self.threadInfo.out = out_buf
         if not self._inited:
             self._inited = True
             self._init2()
-        if length < 0:
-            length = 0x7FFFFFFF
-        while True:
-            if out_buf.pos == length:
+        # the decoder counts down the symbols still wanted, across output blocks
+        remains = length if length >= 0 else 0x7FFFFFFF
+        while self._filter is not None and remains > 0:
+            if out_buf.pos == out_buf.size:
+                out.grow(out_buf)
+            self.lock.release()
+            size = lib.ppmd8_decompress_filtered(
+                self.ppmd, self._filter, self._stage, self._filter_state, out_buf, in_buf, remains, self.threadInfo
+            )
+            self.lock.acquire()
+            if size == -1:
+                self._eof = True
+                self._needs_input = False
+                res = self._finish_outBuffer(out, out_buf, in_buf, as_chunks)
+                self.lock.release()
+                return res
+            elif size == -2:
+                raise ValueError("Corrupted archive data.")
+            elif size == 0:
                 break
+            remains -= size
+        while self._filter is None and remains > 0:
             if out_buf.pos == out_buf.size:
                 out.grow(out_buf)
             self.lock.release()
-            size = lib.ppmd8_decompress(self.ppmd, out_buf, in_buf, length, self.threadInfo)
+            size = lib.ppmd8_decompress(self.ppmd, out_buf, in_buf, remains, self.threadInfo)
             self.lock.acquire()
             if size == -1:
                 self._eof = True
                 self._needs_input = False
-                res = out.finish(out_buf)
+                res = self._finish_outBuffer(out, out_buf, in_buf, as_chunks)
                 self.lock.release()
                 return res
             elif size == -2:
                 raise ValueError("Corrupted archive data.")
+            remains -= size
             if in_buf.pos == in_buf.size:
                 break
         self._unconsumed_in(in_buf, use_input_buffer)
@@ -595,7 +836,7 @@ class Ppmd8Decoder(PpmdBaseDecoder):
             self._needs_input = True
         else:
             self._needs_input = False
-        res = out.finish(out_buf)
+        res = self._finish_outBuffer(out, out_buf, in_buf, as_chunks)
         self.lock.release()
         return res
 
@@ -603,10 +844,20 @@ class Ppmd8Decoder(PpmdBaseDecoder):
         if self._finished:
             return
         self._finished = True
+        self._stats = _model_stats(self.ppmd, lib.Ppmd8_GetUsedMemory(self.ppmd))
         lib.Ppmd8T_Free(self.ppmd, self.threadInfo, self._allocator)
+        if self._filter is not None:
+            lib.PpmdFilter_Free(self._filter, self._allocator)
         ffi.release(self.ppmd)
         self._release()
 
+    def stats(self) -> dict:
+        """Return a dict of model memory telemetry: sizes in bytes and event counts."""
+        with self.lock:
+            if self._finished:
+                return dict(self._stats)
+            return _model_stats(self.ppmd, lib.Ppmd8_GetUsedMemory(self.ppmd))
+
     @property
     def needs_input(self):
         return self._needs_input
@@ -620,3 +871,87 @@ class Ppmd8Decoder(PpmdBaseDecoder):
 
     def __exit__(self, exc_type, exc_val, exc_tb):
         self._free()
+
+
+def decompress_many(
+    datas,
+    lengths=None,
+    max_order: int = 6,
+    mem_size: int = 16 << 20,
+    restore_method=PPMD8_RESTORE_METHOD_RESTART,
+    width: int = 1,
+):
+    """Decompress a sequence of independent PPMd variant I streams and return a list of bytes.
+    With width > 1, up to width streams are decoded together, one symbol of each in turn."""
+    if not 1 <= width <= lib.PPMD_BATCH_MAX_WIDTH:
+        raise ValueError("width should be in range 1 to {}.".format(lib.PPMD_BATCH_MAX_WIDTH))
+    _check_restore_method(restore_method)
+    if lengths is not None and len(lengths) != len(datas):
+        raise ValueError("lengths should have the same size as datas.")
+    width = min(width, len(datas))
+    allocator = ffi.new("IAlloc *")
+    allocator.Alloc = lib.raw_alloc
+    allocator.Free = lib.raw_free
+    models = ffi.new("CPpmd8[]", max(width, 1))
+    streams = ffi.new("Ppmd8BatchStream[]", max(width, 1))
+    allocated = 0
+    results = []
+    try:
+        for allocated in range(width):
+            lib.Ppmd8_Construct(models + allocated)
+            if not lib.Ppmd8_Alloc(models + allocated, mem_size, allocator):
+                raise MemoryError
+        allocated = width
+        for base in range(0, len(datas), width):
+            group = datas[base : base + width]
+            sources = []
+            outs = []
+            for i, data in enumerate(group):
+                length = -1
+                if lengths is not None:
+                    length = lengths[base + i]
+                    if length < 0:
+                        raise ValueError("lengths should not be negative.")
+                lib.Ppmd8_Init(models + i, max_order, restore_method)
+                sources.append(ffi.from_buffer(data))
+                if not lib.Ppmd8Batch_Init(streams + i, models + i, sources[i], len(data)):
+                    raise ValueError("Corrupted input data.")
+                out = _BlocksOutputBuffer()
+                out.initEstimate(streams[i].out, length, out.estimate(len(data), 0, 0), True)
+                if length == 0:
+                    streams[i].result = lib.PPMD_RESULT_LIMIT
+                outs.append(out)
+            pending = True
+            while pending:
+                lib.Ppmd8Batch_Decode(streams, len(group))
+                pending = False
+                for i, out in enumerate(outs):
+                    if streams[i].result != 0:
+                        continue
+                    if out.reachedMaxLength(streams[i].out):
+                        streams[i].result = lib.PPMD_RESULT_LIMIT
+                        continue
+                    out.grow(streams[i].out)
+                    pending = True
+            for i, out in enumerate(outs):
+                if streams[i].result == lib.PPMD_RESULT_ERROR:
+                    raise ValueError("Corrupted input data.")
+                results.append(out.finish(streams[i].out))
+    finally:
+        for i in range(allocated):
+            lib.Ppmd8_Free(models + i, allocator)
+    return results
+
+
+def cpu_features():
+    """Return a dict of the SIMD extensions detected on the running CPU and the name
+    of the kernels selected for the escape path frequency scans under 'kernel'.
+    The PYPPMD_KERNEL environment variable caps the selection at import time."""
+    features = lib.Ppmd_GetCpuFeatures()
+    return {
+        "ssse3": bool(features & lib.PPMD_CPU_SSSE3),
+        "avx2": bool(features & lib.PPMD_CPU_AVX2),
+        "avx512bw": bool(features & lib.PPMD_CPU_AVX512BW),
+        "neon": bool(features & lib.PPMD_CPU_NEON),
+        "kernel": ffi.string(lib.Ppmd_KernelName()).decode("ascii"),
+    }
@@ -1,6 +1,8 @@
+import hashlib
 import io
 import os
 import pathlib
+import random
 
 import pytest
 
@@ -74,3 +76,152 @@ def test_benchmark_text_decompress(tmp_path, benchmark, name, var, max_order, me
 
     benchmark.extra_info["data_size"] = src_size
     benchmark(decode, var, max_order, mem_size)
+
+
+# pseudo-random bytes keep most contexts large, which is where the state scan kernels matter
+binary_data = b"".join(hashlib.sha256(i.to_bytes(4, "little")).digest() for i in range(1 << 15))
+BINARY_BLOCKSIZE = 16384
+binary_targets = [("PPMd H binary", 7, 6, 16 << 20), ("PPMd I binary", 8, 8, 8 << 20)]
+
+
+def encode_binary(var, max_order, mem_size):
+    if var == 7:
+        encoder = pyppmd.Ppmd7Encoder(max_order=max_order, mem_size=mem_size)
+    else:
+        encoder = pyppmd.Ppmd8Encoder(max_order=max_order, mem_size=mem_size)
+    result = b""
+    for i in range(0, len(binary_data), BINARY_BLOCKSIZE):
+        result += encoder.encode(binary_data[i : i + BINARY_BLOCKSIZE])
+    return result + encoder.flush()
+
+
+@pytest.mark.benchmark(group="compress")
+@pytest.mark.parametrize("name, var, max_order, mem_size", binary_targets)
+def test_benchmark_binary_compress(benchmark, name, var, max_order, mem_size):
+    cpuinfo = pytest.importorskip("cpuinfo")
+    benchmark.extra_info["data_size"] = len(binary_data)
+    benchmark(encode_binary, var, max_order, mem_size)
+
+
+@pytest.mark.benchmark(group="decompress")
+@pytest.mark.parametrize("name, var, max_order, mem_size", binary_targets)
+def test_benchmark_binary_decompress(benchmark, name, var, max_order, mem_size):
+    cpuinfo = pytest.importorskip("cpuinfo")
+    compressed = encode_binary(var, max_order, mem_size)
+
+    def decode(var, max_order, mem_size):
+        if var == 7:
+            decoder = pyppmd.Ppmd7Decoder(max_order=max_order, mem_size=mem_size)
+        else:
+            decoder = pyppmd.Ppmd8Decoder(max_order=max_order, mem_size=mem_size)
+        result = decoder.decode(compressed, len(binary_data))
+        assert len(result) == len(binary_data)
+
+    benchmark.extra_info["data_size"] = len(binary_data)
+    benchmark(decode, var, max_order, mem_size)
+
+
+# width 0 decodes the streams one Ppmd8Decoder after the other, for comparison
+many_targets = [("Ppmd8Decoder loop", 0), ("sequential", 1), ("2 interleaved", 2), ("4 interleaved", 4)]
+
+
+@pytest.mark.benchmark(group="decompress_many")
+@pytest.mark.parametrize("name, width", many_targets)
+def test_benchmark_decompress_many(benchmark, name, width):
+    cpuinfo = pytest.importorskip("cpuinfo")
+    # sixteen independent streams, each with its own 16MB model
+    text = testdata.read_bytes()
+    step = len(text) // 16
+    sources = [text[i * step : (i + 1) * step] for i in range(16)]
+    datas = [pyppmd.compress(s, max_order=8, mem_size=16 << 20) for s in sources]
+    lengths = [len(s) for s in sources]
+
+    def decode():
+        if width == 0:
+            result = [pyppmd.Ppmd8Decoder(8, 16 << 20).decode(d, n) for d, n in zip(datas, lengths)]
+        else:
+            result = pyppmd.decompress_many(datas, lengths, max_order=8, mem_size=16 << 20, width=width)
+        assert result == sources
+
+    benchmark.extra_info["data_size"] = sum(lengths)
+    benchmark(decode)
+
+
+# order 2 keeps the model small, so the time goes mostly to the range coder
+rangecoder_targets = [("PPMd H order 2", 7, 2, 1 << 20), ("PPMd I order 2", 8, 2, 1 << 20)]
+
+
+@pytest.mark.benchmark(group="rangecoder")
+@pytest.mark.parametrize("name, var, max_order, mem_size", rangecoder_targets)
+def test_benchmark_rangecoder(benchmark, name, var, max_order, mem_size):
+    cpuinfo = pytest.importorskip("cpuinfo")
+    text = testdata.read_bytes()
+
+    def roundtrip():
+        if var == 7:
+            encoder = pyppmd.Ppmd7Encoder(max_order=max_order, mem_size=mem_size)
+            decoder = pyppmd.Ppmd7Decoder(max_order=max_order, mem_size=mem_size)
+        else:
+            encoder = pyppmd.Ppmd8Encoder(max_order=max_order, mem_size=mem_size)
+            decoder = pyppmd.Ppmd8Decoder(max_order=max_order, mem_size=mem_size)
+        compressed = b"".join(encoder.encode(text[i : i + READ_BLOCKSIZE]) for i in range(0, len(text), READ_BLOCKSIZE))
+        compressed += encoder.flush()
+        assert decoder.decode(compressed, len(text)) == text
+
+    benchmark.extra_info["data_size"] = src_size
+    benchmark(roundtrip)
+
+
+def make_log_data(size):
+    rng = random.Random(7)
+    hosts = ["web-%02d" % i for i in range(12)]
+    paths = ["/api/v1/users", "/api/v1/orders", "/static/app.js", "/healthz", "/login"]
+    levels = ["INFO"] * 8 + ["WARN", "DEBUG", "ERROR"]
+    lines = []
+    total = 0
+    t = 0
+    while total < size:
+        t += rng.randint(0, 3)
+        line = (
+            "2023-11-14T%02d:%02d:%02dZ %s %-5s GET %s status=%d bytes=%d\n"
+            % (
+                (t // 3600) % 24,
+                (t // 60) % 60,
+                t % 60,
+                rng.choice(hosts),
+                rng.choice(levels),
+                rng.choice(paths),
+                rng.choice([200] * 9 + [404, 500]),
+                rng.randint(100, 9000),
+            )
+        )
+        lines.append(line)
+        total += len(line)
+    return "".join(lines).encode()
+
+
+# repetitive log lines code most symbols in contexts with a single state
+log_targets = [("PPMd H logs", 7, 6, 16 << 20), ("PPMd I logs", 8, 6, 16 << 20)]
+
+
+@pytest.mark.benchmark(group="binary_context")
+@pytest.mark.parametrize("name, var, max_order, mem_size", log_targets)
+def test_benchmark_logs_roundtrip(benchmark, name, var, max_order, mem_size):
+    cpuinfo = pytest.importorskip("cpuinfo")
+    log_data = make_log_data(1 << 21)
+
+    def roundtrip():
+        if var == 7:
+            encoder = pyppmd.Ppmd7Encoder(max_order=max_order, mem_size=mem_size)
+            decoder = pyppmd.Ppmd7Decoder(max_order=max_order, mem_size=mem_size)
+        else:
+            encoder = pyppmd.Ppmd8Encoder(max_order=max_order, mem_size=mem_size)
+            decoder = pyppmd.Ppmd8Decoder(max_order=max_order, mem_size=mem_size)
+        compressed = b"".join(
+            encoder.encode(log_data[i : i + READ_BLOCKSIZE]) for i in range(0, len(log_data), READ_BLOCKSIZE)
+        )
+        compressed += encoder.flush()
+        assert decoder.decode(compressed, len(log_data)) == log_data
+
+    benchmark.extra_info["data_size"] = len(log_data)
+    benchmark(roundtrip)
@@ -1,3 +1,10 @@
+import os
+import pathlib
+import subprocess
+import sys
+
+import pytest
+
 import pyppmd
 
 source = "This file is located in a folder.This file is located in the root.\n"
@@ -6,6 +13,7 @@ encoded = (
     b"\x13\xb6\xce\xb2\xe7\x6a\xb9\xf6\xe8\x66\xf5\x08\xc3\x0a\x09\x36\x12\xeb\xda\xda\xba"
 )
 READ_BLOCKSIZE = 16384
+testdata_path = pathlib.Path(os.path.dirname(__file__)).joinpath("data")
 
 
 # Test one-shot functions
@@ -23,3 +31,101 @@ def test_decompress_str():
 
 def test_decompress():
     assert pyppmd.decompress(encoded, max_order=6, mem_size=8 << 20) == source.encode("UTF-8")
+
+
+def test_decompress_many():
+    sources = [source.encode("UTF-8") * (i + 1) + bytes(range(i * 16)) for i in range(7)]
+    datas = [pyppmd.compress(s, max_order=6, mem_size=8 << 20) for s in sources]
+    for width in (1, 2, 4):
+        assert pyppmd.decompress_many(datas, max_order=6, mem_size=8 << 20, width=width) == sources
+    lengths = [len(s) // 2 for s in sources]
+    expected = [s[: len(s) // 2] for s in sources]
+    assert pyppmd.decompress_many(datas, lengths, max_order=6, mem_size=8 << 20) == expected
+    with pytest.raises(ValueError):
+        pyppmd.decompress_many(datas, restore_method=2)
+
+
+@pytest.mark.parametrize(
+    "variant, content_size, checksum",
+    [("I", True, True), ("I", True, False), ("I", False, True), ("I", False, False), ("H", True, True), ("H", True, False)],
+)
+def test_frame(variant, content_size, checksum):
+    # larger than the first output block of the decoders
+    data = testdata_path.joinpath("10000SalesRecords.csv").read_bytes()[:100000]
+    frame = pyppmd.compress_frame(
+        data, max_order=8, mem_size=4 << 20, variant=variant, content_size=content_size, checksum=checksum
+    )
+    assert frame[:4] == b"PPMF"
+    info = pyppmd.frame_info(frame)
+    assert (info.variant, info.max_order, info.mem_size) == (variant, 8, 4 << 20)
+    assert info.content_size == (len(data) if content_size else None)
+    assert info.checksum == checksum
+    assert pyppmd.decompress_frame(frame) == data
+    for short in (b"", b"a"):
+        assert pyppmd.decompress_frame(pyppmd.compress_frame(short, variant=variant, content_size=content_size)) == short
+
+
+def test_frame_errors():
+    data = source.encode("UTF-8") * 100
+    frame = pyppmd.compress_frame(data)
+    with pytest.raises(pyppmd.PpmdError):
+        pyppmd.decompress_frame(frame[:10])
+    with pytest.raises(pyppmd.PpmdError):
+        pyppmd.decompress_frame(b"PPMB" + frame[4:])
+    with pytest.raises(pyppmd.PpmdError):
+        pyppmd.decompress_frame(frame[:-1] + bytes([frame[-1] ^ 1]))
+    with pytest.raises(pyppmd.PpmdError):
+        pyppmd.decompress_frame(frame[: len(frame) // 2])
+    # a content size far beyond what the stream can hold is rejected before decoding
+    info = pyppmd.frame_info(frame)
+    oversized = frame[: info.header_size - 8] + (1 << 30).to_bytes(8, "little") + frame[info.header_size :]
+    with pytest.raises(pyppmd.PpmdError, match="content size"):
+        pyppmd.decompress_frame(oversized)
+    with pytest.raises(ValueError):
+        pyppmd.compress_frame(data, variant="H", content_size=False)
+
+
+def test_tune():
+    sample = testdata_path.joinpath("10000SalesRecords.csv").read_bytes()[: 1 << 16]
+    frontier = pyppmd.tune(sample, time_budget=None, orders=(2, 6), mem_sizes=(1 << 14, 1 << 22), workers=2)
+    assert frontier
+    # best ratio first, and every step down in ratio buys speed
+    for better, faster in zip(frontier, frontier[1:]):
+        assert better.compressed_size < faster.compressed_size and better.speed < faster.speed
+    for r in frontier:
+        assert r.variant in ("H", "I") and r.max_order in (2, 6) and r.ratio == len(sample) / r.compressed_size
+        # the larger model is only tried when the smaller one ran out of memory
+        assert r.mem_size == 1 << 14 or r.restarts == r.cutoffs == 0
+        if r.variant == "I":
+            encoder = pyppmd.Ppmd8Encoder(r.max_order, r.mem_size, r.restore_method)
+        else:
+            encoder = pyppmd.Ppmd7Encoder(r.max_order, r.mem_size)
+        assert len(encoder.encode(sample) + encoder.flush()) == r.compressed_size
+    # a spent budget still leaves the first trial
+    assert pyppmd.tune(sample, time_budget=0, orders=(2,), mem_sizes=(1 << 20,))
+    with pytest.raises(ValueError):
+        pyppmd.tune(sample, variants=("J",))
+
+
+def test_cpu_features():
+    features = pyppmd.cpu_features()
+    assert set(features) == {"ssse3", "avx2", "avx512bw", "neon", "kernel"}
+    assert features["kernel"] in ("scalar", "ssse3", "avx2", "avx512bw", "neon")
+    if features["kernel"] != "scalar":
+        assert features[features["kernel"]]
+
+
+def test_kernels_agree():
+    script = (
+        "import hashlib, sys, pyppmd\n"
+        "data = b''.join(hashlib.sha256(i.to_bytes(4, 'little')).digest() for i in range(2048))\n"
+        "encoder = pyppmd.Ppmd8Encoder(6, 8 << 20)\n"
+        "encoded = b''.join(encoder.encode(data[i : i + 16384]) for i in range(0, len(data), 16384))\n"
+        "sys.stdout.write(hashlib.sha256(encoded + encoder.flush()).hexdigest())\n"
+    )
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join(sys.path))
+    digests = set()
+    for kernel in ("scalar", "ssse3", "avx2", "avx512bw", "neon"):
+        env["PYPPMD_KERNEL"] = kernel
+        digests.add(subprocess.run([sys.executable, "-c", script], env=env, check=True, capture_output=True).stdout)
+    assert len(digests) == 1
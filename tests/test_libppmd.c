@@ -0,0 +1,143 @@
+//
+// test_libppmd.c -- round trips through the libppmd streaming API
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libppmd.h"
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                       \
+        }                                                                  \
+    } while (0)
+
+typedef struct {
+    unsigned char *data;
+    size_t size;
+} bytes;
+
+static bytes encode(const ppmd_params *params, const bytes *src, size_t in_step, size_t out_step)
+{
+    ppmd_stream *enc = ppmd_encoder_create(params);
+    size_t capacity = src->size + src->size / 2 + 1024;
+    bytes dst = {malloc(capacity), 0};
+    ppmd_buffer in = {src->data, 0, 0};
+    int ret;
+    CHECK(enc != NULL && dst.data != NULL);
+    while (in.size < src->size) {
+        in.size = in.size + in_step < src->size ? in.size + in_step : src->size;
+        while (in.pos < in.size) {
+            ppmd_buffer out = {dst.data + dst.size, out_step, 0};
+            CHECK(dst.size + out_step <= capacity);
+            CHECK(ppmd_encode_chunk(enc, &in, &out) == PPMD_OK);
+            dst.size += out.pos;
+        }
+    }
+    do {
+        ppmd_buffer out = {dst.data + dst.size, out_step, 0};
+        CHECK(dst.size + out_step <= capacity);
+        ret = ppmd_flush(enc, &out);
+        CHECK(ret == PPMD_OK || ret == PPMD_MORE_OUTPUT);
+        dst.size += out.pos;
+    } while (ret == PPMD_MORE_OUTPUT);
+    /* nothing can follow the flush */
+    CHECK(ppmd_encode_chunk(enc, &in, &(ppmd_buffer){dst.data, 0, 0}) == PPMD_ERROR_PARAM);
+    ppmd_free(enc);
+    return dst;
+}
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/* Decodes up to length bytes, feeding the input in_step and taking the output out_step bytes at a time. */
+static int decode(const ppmd_params *params, const bytes *src, bytes *dst, size_t length, size_t in_step, size_t out_step)
+{
+    ppmd_stream *dec = ppmd_decoder_create(params);
+    ppmd_buffer in = {src->data, 0, 0};
+    int ret = PPMD_OK;
+    CHECK(dec != NULL);
+    dst->size = 0;
+    while (ret == PPMD_OK && dst->size < length) {
+        ppmd_buffer out = {dst->data + dst->size, MIN(out_step, length - dst->size), 0};
+        int last;
+        if (in.pos == in.size)
+            in.size = MIN(in.size + in_step, src->size);
+        last = (in.size == src->size);
+        ret = ppmd_decode_chunk(dec, &in, &out, last);
+        dst->size += out.pos;
+        CHECK(!(last && ret == PPMD_OK && out.pos == 0));
+    }
+    ppmd_free(dec);
+    return ret;
+}
+
+static void round_trip(const ppmd_params *params, const bytes *src)
+{
+    bytes ref = encode(params, src, src->size, src->size + 1024);
+    bytes small = encode(params, src, 1000, 7);
+    bytes out = {malloc(src->size + 1), 0};
+    bytes truncated = {ref.data, ref.size - 16};
+    /* with an end marker the decoder stops by itself, otherwise at the known length */
+    size_t length = src->size + (params->endmark ? 1 : 0);
+    int expected = params->endmark ? PPMD_STREAM_END : PPMD_OK;
+
+    CHECK(out.data != NULL);
+    CHECK(small.size == ref.size && memcmp(small.data, ref.data, ref.size) == 0);
+
+    CHECK(decode(params, &ref, &out, length, ref.size, length) == expected);
+    CHECK(out.size == src->size && memcmp(out.data, src->data, src->size) == 0);
+
+    CHECK(decode(params, &ref, &out, length, 1, 3) == expected);
+    CHECK(out.size == src->size && memcmp(out.data, src->data, src->size) == 0);
+
+    CHECK(decode(params, &truncated, &out, length, truncated.size, length) == PPMD_ERROR_DATA);
+
+    free(ref.data);
+    free(small.data);
+    free(out.data);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct {
+        int variant;
+        unsigned restore_method;
+        int endmark;
+    } cases[] = {
+        {PPMD_VARIANT_H, PPMD_RESTORE_METHOD_RESTART, 0},
+        {PPMD_VARIANT_H, PPMD_RESTORE_METHOD_RESTART, 1},
+        {PPMD_VARIANT_I, PPMD_RESTORE_METHOD_RESTART, 1},
+        {PPMD_VARIANT_I, PPMD_RESTORE_METHOD_CUTOFF, 1},
+        {PPMD_VARIANT_I, PPMD_RESTORE_METHOD_REPLAY, 1},
+    };
+    bytes src;
+    FILE *f;
+    size_t i;
+
+    CHECK(argc == 2);
+    f = fopen(argv[1], "rb");
+    CHECK(f != NULL);
+    src.data = malloc(1 << 18);
+    CHECK(src.data != NULL);
+    src.size = fread(src.data, 1, 1 << 18, f);
+    fclose(f);
+    CHECK(src.size > 0);
+
+    CHECK(ppmd_encoder_create(&(ppmd_params){0, 6, 16 << 20, 0, 0}) == NULL);
+    CHECK(ppmd_decoder_create(&(ppmd_params){PPMD_VARIANT_I, 6, 16 << 20, 2, 1}) == NULL);
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        ppmd_params params;
+        ppmd_params_default(&params, cases[i].variant);
+        params.mem_size = 1 << 20;
+        params.restore_method = cases[i].restore_method;
+        params.endmark = cases[i].endmark;
+        round_trip(&params, &src);
+        printf("variant %d restore %u endmark %d: ok\n", params.variant, params.restore_method, params.endmark);
+    }
+    free(src.data);
+    return 0;
+}
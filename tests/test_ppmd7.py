@@ -1,3 +1,4 @@
+import gc
 import hashlib
 import os
 import pathlib
@@ -164,3 +165,76 @@ def test_ppmd7_decode_chunks():
                 remaining -= len(out)
                 result += out
             assert len(result) == chunk_sizes[i]
+
+
+def test_ppmd7_encode_decode_binary():
+    # high entropy input escapes to the lower orders on almost every symbol
+    data = b"".join(hashlib.sha256(i.to_bytes(4, "little")).digest() for i in range(1024))
+    encoder = pyppmd.Ppmd7Encoder(6, 16 << 20)
+    result = b"".join(encoder.encode(data[i : i + READ_BLOCKSIZE]) for i in range(0, len(data), READ_BLOCKSIZE))
+    result += encoder.flush()
+    assert hashlib.sha256(result).hexdigest() == "b0711d972f4086030a45be9c39c4b89cf98909dc0ba958b035687b5a6ca4f888"
+    decoder = pyppmd.Ppmd7Decoder(6, 16 << 20)
+    assert decoder.decode(result, len(data)) == data
+
+
+def test_ppmd7_props():
+    props = pyppmd.ppmd7_props(6, 16 << 20)
+    assert props == b"\x06\x00\x00\x00\x01"
+    assert pyppmd.parse_ppmd7_props(props) == (6, 16 << 20)
+    encoder = pyppmd.Ppmd7Encoder(6, 16 << 20)
+    assert encoder.props == props
+    result = encoder.encode(data)
+    result += encoder.flush()
+    decoder = pyppmd.Ppmd7Decoder.from_props(encoder.props)
+    assert decoder.props == props
+    assert decoder.decode(result, len(data)) == data
+
+
+@pytest.mark.parametrize(
+    "props",
+    [b"\x06\x00\x00\x00", b"\x06\x00\x00\x00\x01\x00", b"\x01\x00\x00\x00\x01", b"\x41\x00\x00\x00\x01", b"\x06\x00\x04\x00\x00"],
+)
+def test_ppmd7_props_invalid(props):
+    with pytest.raises(ValueError):
+        pyppmd.parse_ppmd7_props(props)
+    with pytest.raises(ValueError):
+        pyppmd.Ppmd7Decoder.from_props(props)
+
+
+def test_ppmd7_decode_as_chunks():
+    decoder = pyppmd.Ppmd7Decoder(6, 16 << 20)
+    chunks = decoder.decode(encoded, len(data), as_chunks=True)
+    # the chunks outlive the decoder
+    del decoder
+    gc.collect()
+    assert b"".join(chunks) == data
+
+
+def test_ppmd7_stats():
+    data = testdata_path.joinpath("10000SalesRecords.csv").read_bytes()
+    encoder = pyppmd.Ppmd7Encoder(6, 1 << 20)
+    assert encoder.stats()["restarts"] == 0
+    encoded = encoder.encode(data) + encoder.flush()
+    stats = encoder.stats()
+    assert stats["mem_size"] == 1 << 20
+    assert stats["used_memory"] <= stats["peak_memory"] <= stats["mem_size"]
+    assert stats["restarts"] > 0 and stats["glues"] > 0 and stats["rescales"] > 0
+    assert stats["cutoffs"] == 0
+    decoder = pyppmd.Ppmd7Decoder(6, 1 << 20)
+    assert decoder.decode(encoded, len(data)) == data
+    assert decoder.stats() == stats
+
+
+def test_ppmd7_encode_decode_runs():
+    # long runs of one byte between random bytes, split across encode() and decode() calls
+    data = b"".join(
+        bytes([i % 3]) * (i * 997 % 20000) + hashlib.sha256(i.to_bytes(4, "little")).digest() for i in range(64)
+    )
+    encoder = pyppmd.Ppmd7Encoder(6, 16 << 20)
+    result = b"".join(encoder.encode(data[i : i + 1000]) for i in range(0, len(data), 1000))
+    result += encoder.flush()
+    assert hashlib.sha256(result).hexdigest() == "ad9884fc64c8986492a15e83378a0b5b4ba0b8d4906d7590ba1af846e5eec434"
+    decoder = pyppmd.Ppmd7Decoder(6, 16 << 20)
+    out = b"".join(decoder.decode(result if i == 0 else b"", min(777, len(data) - i)) for i in range(0, len(data), 777))
+    assert out == data
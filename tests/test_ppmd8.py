@@ -1,6 +1,7 @@
 import hashlib
 import os
 import pathlib
+import tracemalloc
 
 import pytest
 
@@ -56,6 +57,7 @@ def test_ppmd8_decoder2():
         (8 << 20, pyppmd.PPMD8_RESTORE_METHOD_CUT_OFF),
         (1 << 20, pyppmd.PPMD8_RESTORE_METHOD_RESTART),
         (1 << 20, pyppmd.PPMD8_RESTORE_METHOD_CUT_OFF),
+        (1 << 20, pyppmd.PPMD8_RESTORE_METHOD_REPLAY),
     ],
 )
 @pytest.mark.timeout(20)
@@ -107,6 +109,115 @@ def test_ppmd8_encode_decode_shortage():
     assert obj == res
 
 
+def test_ppmd8_decode_exact_length():
+    data = testdata_path.joinpath("10000SalesRecords.csv").read_bytes()
+    encoder = pyppmd.Ppmd8Encoder(6, 8 << 20)
+    result = b"".join(encoder.encode(data[i : i + READ_BLOCKSIZE]) for i in range(0, len(data), READ_BLOCKSIZE))
+    result += encoder.flush()
+    decoder = pyppmd.Ppmd8Decoder(6, 8 << 20)
+    tracemalloc.start()
+    try:
+        assert decoder.decode(result, len(data), exact=True) == data
+        # one output block of the declared size, not grown blocks joined into a copy
+        assert tracemalloc.get_traced_memory()[1] < len(data) * 3 // 2
+    finally:
+        tracemalloc.stop()
+    # a declared length beyond the end mark is trimmed
+    decoder = pyppmd.Ppmd8Decoder(6, 8 << 20)
+    assert decoder.decode(result, len(data) + 1000, exact=True) == data
+    assert decoder.eof
+
+
+def test_ppmd8_decode_length_is_a_bound():
+    data = b"short data " * 10
+    encoded = pyppmd.compress(data)
+    decoder = pyppmd.Ppmd8Decoder(6, 16 << 20)
+    tracemalloc.start()
+    try:
+        assert decoder.decode(encoded, 1 << 30) == data
+        # a large max length is not allocated up front
+        assert tracemalloc.get_traced_memory()[1] < 1 << 20
+    finally:
+        tracemalloc.stop()
+
+
+def test_ppmd8_decode_unknown_length():
+    data = testdata_path.joinpath("10000SalesRecords.csv").read_bytes()
+    encoded = pyppmd.compress(data)
+    decoder = pyppmd.Ppmd8Decoder(6, 16 << 20)
+    tracemalloc.start()
+    try:
+        assert decoder.decode(encoded) == data
+        # the first block is sized from the input, so the output is not joined from blocks
+        assert tracemalloc.get_traced_memory()[1] < len(data) * 3 // 2
+    finally:
+        tracemalloc.stop()
+    # repeated data expands far beyond the estimate and grows past the first block
+    data = data * 3
+    encoded = pyppmd.compress(data)
+    decoder = pyppmd.Ppmd8Decoder(6, 16 << 20)
+    result = b"".join(decoder.decode(encoded[i : i + READ_BLOCKSIZE]) for i in range(0, len(encoded), READ_BLOCKSIZE))
+    assert result == data
+
+
+def test_ppmd8_decode_as_chunks(tmp_path):
+    data = testdata_path.joinpath("10000SalesRecords.csv").read_bytes() * 3
+    encoded = pyppmd.compress(data)
+    decoder = pyppmd.Ppmd8Decoder(6, 16 << 20)
+    chunks = decoder.decode(encoded, as_chunks=True)
+    assert len(chunks) > 1 and all(memoryview(chunk).nbytes > 0 for chunk in chunks)
+    with tmp_path.joinpath("out").open("wb") as f:
+        f.writelines(chunks)
+    assert tmp_path.joinpath("out").read_bytes() == data
+    assert decoder.eof
+    assert decoder.decode(b"", as_chunks=True) == []
+    assert decoder.decode(b"") == b""
+
+
+@pytest.mark.parametrize(
+    "restore_method",
+    [pyppmd.PPMD8_RESTORE_METHOD_RESTART, pyppmd.PPMD8_RESTORE_METHOD_CUT_OFF, pyppmd.PPMD8_RESTORE_METHOD_REPLAY],
+)
+def test_ppmd8_stats(restore_method):
+    data = testdata_path.joinpath("10000SalesRecords.csv").read_bytes()
+    encoder = pyppmd.Ppmd8Encoder(6, 1 << 20, restore_method=restore_method)
+    fresh = encoder.stats()
+    assert fresh["mem_size"] == 1 << 20
+    assert fresh["used_memory"] == fresh["peak_memory"] > 0
+    assert fresh["restarts"] == fresh["cutoffs"] == fresh["glues"] == fresh["rescales"] == 0
+    encoded = encoder.encode(data) + encoder.flush()
+    stats = encoder.stats()
+    assert stats["used_memory"] <= stats["peak_memory"] <= stats["mem_size"]
+    assert stats["glues"] > 0 and stats["rescales"] > 0
+    if restore_method != pyppmd.PPMD8_RESTORE_METHOD_CUT_OFF:
+        assert stats["restarts"] > 0 and stats["cutoffs"] == 0
+    else:
+        assert stats["cutoffs"] > 0
+    # the decoder rebuilds the same model, so it sees the same events
+    decoder = pyppmd.Ppmd8Decoder(6, 1 << 20, restore_method=restore_method)
+    assert decoder.decode(encoded, len(data)) == data
+    assert decoder.stats() == stats
+
+
+def test_ppmd8_replay():
+    data = testdata_path.joinpath("10000SalesRecords.csv").read_bytes()
+    sizes = {}
+    for restore_method in (pyppmd.PPMD8_RESTORE_METHOD_RESTART, pyppmd.PPMD8_RESTORE_METHOD_REPLAY):
+        encoder = pyppmd.Ppmd8Encoder(6, 1 << 20, restore_method=restore_method)
+        sizes[restore_method] = len(encoder.encode(data) + encoder.flush())
+    # the model picks up again from the latest input instead of from nothing
+    assert sizes[pyppmd.PPMD8_RESTORE_METHOD_REPLAY] < sizes[pyppmd.PPMD8_RESTORE_METHOD_RESTART]
+
+
+@pytest.mark.parametrize("restore_method", [-1, 2, 3, 5])
+def test_ppmd8_restore_method_unknown(restore_method):
+    # 2 and 3 are 7-Zip's FREEZE, which is not supported
+    with pytest.raises(ValueError):
+        pyppmd.Ppmd8Encoder(6, 1 << 20, restore_method=restore_method)
+    with pytest.raises(ValueError):
+        pyppmd.Ppmd8Decoder(6, 1 << 20, restore_method=restore_method)
+
+
 def test_ppmdcompress():
     compressor = pyppmd.PpmdCompressor(6, 8 << 20, restore_method=pyppmd.PPMD8_RESTORE_METHOD_RESTART, variant="I")
     result = compressor.compress(source)
@@ -118,3 +229,97 @@ def test_ppmddecompress():
     decomp = pyppmd.PpmdDecompressor(6, 8 << 20, restore_method=pyppmd.PPMD8_RESTORE_METHOD_RESTART, variant="I")
     result = decomp.decompress(encoded)
     assert result == source
+
+
+def test_ppmd8_encode_decode_binary():
+    # high entropy input escapes to the lower orders on almost every symbol
+    data = b"".join(hashlib.sha256(i.to_bytes(4, "little")).digest() for i in range(1024))
+    encoder = pyppmd.Ppmd8Encoder(6, 16 << 20, pyppmd.PPMD8_RESTORE_METHOD_RESTART)
+    result = b"".join(encoder.encode(data[i : i + READ_BLOCKSIZE]) for i in range(0, len(data), READ_BLOCKSIZE))
+    result += encoder.flush()
+    assert hashlib.sha256(result).hexdigest() == "dabd8e418c6c171de8854927e132851f78f10b02befebd8d9e1912a7b93c6487"
+    decoder = pyppmd.Ppmd8Decoder(6, 16 << 20, pyppmd.PPMD8_RESTORE_METHOD_RESTART)
+    assert decoder.decode(result, len(data)) == data
+
+
+def test_ppmd8_encode_decode_runs():
+    # long runs of one byte between random bytes, split across encode() and decode() calls
+    data = b"".join(
+        bytes([i % 3]) * (i * 997 % 20000) + hashlib.sha256(i.to_bytes(4, "little")).digest() for i in range(64)
+    )
+    encoder = pyppmd.Ppmd8Encoder(6, 16 << 20, pyppmd.PPMD8_RESTORE_METHOD_RESTART)
+    result = b"".join(encoder.encode(data[i : i + 1000]) for i in range(0, len(data), 1000))
+    result += encoder.flush()
+    assert hashlib.sha256(result).hexdigest() == "458ccb3a248ed0d7bfa94a3375f4e3b41704f0932590b503bc5ec15102a917db"
+    decoder = pyppmd.Ppmd8Decoder(6, 16 << 20, pyppmd.PPMD8_RESTORE_METHOD_RESTART)
+    out = b"".join(decoder.decode(result if i == 0 else b"", min(777, len(data) - i)) for i in range(0, len(data), 777))
+    assert out == data
+
+
+def _records(count):
+    # fixed width records of slowly changing little endian fields
+    return b"".join(
+        i.to_bytes(4, "little") + (i * 3 % 97).to_bytes(4, "little") + (1000 + i // 7).to_bytes(4, "little")
+        for i in range(count)
+    )
+
+
+def _calls(count):
+    # E8/E9 opcodes with operands, some of them across the 64 KiB filter chunks
+    code = bytearray()
+    for i in range(count):
+        code += hashlib.sha256(i.to_bytes(4, "little")).digest()[: i % 11]
+        code += bytes([0xE8 | (i & 1)]) + ((i * 7919 % 4096) - len(code) - 5).to_bytes(4, "little", signed=True)
+    return bytes(code)
+
+
+@pytest.mark.parametrize(
+    "filter, filter_param, data",
+    [
+        (pyppmd.PPMD8_FILTER_DELTA, 4, b"".join((i * i // 64).to_bytes(4, "little") for i in range(100000))),
+        (pyppmd.PPMD8_FILTER_DELTA, 24, _records(30000)[3:]),
+        (pyppmd.PPMD8_FILTER_X86, 0, _calls(40000)),
+        (pyppmd.PPMD8_FILTER_TRANSPOSE, 12, _records(100001) + b"tail"),
+    ],
+    ids=["delta", "delta_wide", "x86", "transpose"],
+)
+def test_ppmd8_filter(filter, filter_param, data):
+    encoder = pyppmd.Ppmd8Encoder(6, 16 << 20, filter=filter, filter_param=filter_param)
+    result = b"".join(encoder.encode(data[i : i + 50000]) for i in range(0, len(data), 50000))
+    result += encoder.flush()
+    plain = pyppmd.Ppmd8Encoder(6, 16 << 20)
+    assert len(result) < len(plain.encode(data) + plain.flush())
+    decoder = pyppmd.Ppmd8Decoder(6, 16 << 20, filter=filter, filter_param=filter_param)
+    assert decoder.decode(result) == data
+    assert decoder.eof
+    # again with small pieces of input and output
+    decoder = pyppmd.Ppmd8Decoder(6, 16 << 20, filter=filter, filter_param=filter_param)
+    out = [decoder.decode(result[i : i + 4096], 30000) for i in range(0, len(result), 4096)]
+    while not decoder.eof:
+        out.append(decoder.decode(b"", 30000))
+    assert b"".join(out) == data
+
+
+@pytest.mark.parametrize(
+    "filter, filter_param",
+    [
+        (pyppmd.PPMD8_FILTER_DELTA, 0),
+        (pyppmd.PPMD8_FILTER_DELTA, 257),
+        (pyppmd.PPMD8_FILTER_X86, 1),
+        (pyppmd.PPMD8_FILTER_TRANSPOSE, 1),
+        (pyppmd.PPMD8_FILTER_TRANSPOSE, 4097),
+        (42, 0),
+    ],
+)
+def test_ppmd8_filter_invalid(filter, filter_param):
+    with pytest.raises(ValueError):
+        pyppmd.Ppmd8Encoder(6, 8 << 20, filter=filter, filter_param=filter_param)
+    with pytest.raises(ValueError):
+        pyppmd.Ppmd8Decoder(6, 8 << 20, filter=filter, filter_param=filter_param)
+
+
+def test_ppmd8_filter_transpose_endmark():
+    encoder = pyppmd.Ppmd8Encoder(6, 8 << 20, filter=pyppmd.PPMD8_FILTER_TRANSPOSE, filter_param=8)
+    encoder.encode(source)
+    with pytest.raises(ValueError):
+        encoder.flush(endmark=False)
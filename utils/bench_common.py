@@ -0,0 +1,65 @@
+# Shared by the scripts in utils that compare builds: build the extension with
+# some setup.py options into a scratch directory, and time a round trip in a
+# child interpreter that imports that build.
+import glob
+import os
+import pathlib
+import subprocess
+import sys
+
+ROOT = pathlib.Path(__file__).resolve().parent.parent
+
+# Runs inside a child interpreter so that each build is imported in isolation.
+TIMING_SCRIPT = """
+import hashlib, sys, time
+import pyppmd
+
+var, max_order, mem_size, rounds = (int(a) for a in sys.argv[1:5])
+path = sys.argv[5]
+if path == "-":
+    data = b"".join(hashlib.sha256(i.to_bytes(4, "little")).digest() for i in range(1 << 15))
+else:
+    with open(path, "rb") as f:
+        data = f.read()
+Encoder = pyppmd.Ppmd7Encoder if var == 7 else pyppmd.Ppmd8Encoder
+Decoder = pyppmd.Ppmd7Decoder if var == 7 else pyppmd.Ppmd8Decoder
+best_enc = best_dec = float("inf")
+for _ in range(rounds):
+    start = time.perf_counter()
+    encoder = Encoder(max_order=max_order, mem_size=mem_size)
+    compressed = b"".join(encoder.encode(data[i : i + 16384]) for i in range(0, len(data), 16384))
+    compressed += encoder.flush()
+    best_enc = min(best_enc, time.perf_counter() - start)
+    start = time.perf_counter()
+    decoder = Decoder(max_order=max_order, mem_size=mem_size)
+    assert decoder.decode(compressed, len(data)) == data
+    best_dec = min(best_dec, time.perf_counter() - start)
+print(len(data), hashlib.sha256(compressed).hexdigest(), best_enc, best_dec)
+"""
+
+# The largest max_order each variant accepts; larger ones are clamped.
+MAX_ORDER = {7: 64, 8: 16}
+
+
+def build(workdir: pathlib.Path, options) -> str:
+    """Build with setup.py options under workdir and return the directory holding the pyppmd package."""
+    subprocess.run(
+        [sys.executable, "setup.py", "-q", "build", "--build-base", str(workdir)] + options,
+        cwd=ROOT,
+        check=True,
+        stdout=subprocess.DEVNULL,
+    )
+    return os.path.dirname(glob.glob(str(workdir / "lib*" / "pyppmd"))[0])
+
+
+def measure(libdir: str, var: int, max_order: int, mem_size: int, rounds: int, path: str):
+    """Return the input size, the stream digest and the best encode and decode times in seconds."""
+    env = dict(os.environ, PYTHONPATH=libdir)
+    out = subprocess.run(
+        [sys.executable, "-c", TIMING_SCRIPT, str(var), str(max_order), str(mem_size), str(rounds), path],
+        env=env,
+        check=True,
+        capture_output=True,
+        text=True,
+    ).stdout.split()
+    return int(out[0]), out[1], float(out[2]), float(out[3])
@@ -0,0 +1,155 @@
+import argparse
+import os
+import pathlib
+import shlex
+import subprocess
+import sys
+import sysconfig
+import tempfile
+
+from tabulate import tabulate  # type: ignore
+
+ROOT = pathlib.Path(__file__).resolve().parent.parent
+
+# Times the halve-and-sort step of Rescale on synthetic contexts: the insertion
+# sort of the model against Ppmd_HalveSortStates, checking that both give the
+# same states in the same order.
+BENCH_SOURCE = r"""
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "PpmdSort.h"
+
+static unsigned InsertionHalveSort(CPpmd_State *stats, unsigned num, unsigned adder, unsigned *sumFreq)
+{
+  CPpmd_State *s = stats;
+  unsigned i = num - 1, oldSum = 0;
+  *sumFreq = s->Freq;
+  do
+  {
+    oldSum += (++s)->Freq;
+    s->Freq = (Byte)((s->Freq + adder) >> 1);
+    *sumFreq += s->Freq;
+    if (s[0].Freq > s[-1].Freq)
+    {
+      CPpmd_State *s1 = s;
+      CPpmd_State tmp = *s1;
+      do
+        s1[0] = s1[-1];
+      while (--s1 != stats && tmp.Freq > s1[-1].Freq);
+      *s1 = tmp;
+    }
+  }
+  while (--i);
+  return oldSum;
+}
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#define NUM_CONTEXTS 64
+
+int main(int argc, char **argv)
+{
+  unsigned num = (unsigned)atoi(argv[1]), sorted = (unsigned)atoi(argv[2]), reps = (unsigned)atoi(argv[3]);
+  static CPpmd_State ctx[NUM_CONTEXTS][256], work[2][256];
+  double best[2] = {1e30, 1e30};
+  unsigned c, i, k, r, check = 0;
+  srand(1);
+  for (c = 0; c < NUM_CONTEXTS; c++)
+  {
+    for (i = 0; i < num; i++)
+    {
+      ctx[c][i].Symbol = (Byte)i;
+      ctx[c][i].Freq = (Byte)(1 + rand() % 124);
+    }
+    /* the model moves a state one step up when it outgrows its neighbour */
+    for (k = 0; k < sorted; k++)
+      for (i = 1; i < num; i++)
+        if (ctx[c][i].Freq > ctx[c][i - 1].Freq)
+        {
+          CPpmd_State t = ctx[c][i];
+          ctx[c][i] = ctx[c][i - 1];
+          ctx[c][i - 1] = t;
+        }
+    for (k = 0; k < 2; k++)
+    {
+      unsigned sum[2], old[2];
+      memcpy(work[0], ctx[c], num * sizeof(CPpmd_State));
+      memcpy(work[1], ctx[c], num * sizeof(CPpmd_State));
+      old[0] = InsertionHalveSort(work[0], num, k, &sum[0]);
+      old[1] = Ppmd_HalveSortStates(work[1], num, k, &sum[1]);
+      if (old[0] != old[1] || sum[0] != sum[1] || memcmp(work[0], work[1], num * sizeof(CPpmd_State)) != 0)
+      {
+        fprintf(stderr, "different result for %u states\n", num);
+        return 1;
+      }
+    }
+  }
+  for (r = 0; r < 5; r++)
+    for (k = 0; k < 2; k++)
+    {
+      double start = now();
+      for (i = 0; i < reps; i++)
+        for (c = 0; c < NUM_CONTEXTS; c++)
+        {
+          unsigned sum;
+          memcpy(work[k], ctx[c], num * sizeof(CPpmd_State));
+          check += k == 0 ? InsertionHalveSort(work[k], num, 1, &sum) : Ppmd_HalveSortStates(work[k], num, 1, &sum);
+        }
+      if (best[k] > now() - start)
+        best[k] = now() - start;
+    }
+  printf("%f %f %u\n", best[0] * 1e9 / reps / NUM_CONTEXTS, best[1] * 1e9 / reps / NUM_CONTEXTS, check);
+  return 0;
+}
+"""
+
+SIZES = [16, 32, 64, 256]
+DISTRIBUTIONS = [("random", 0), ("one bubble pass", 1)]
+
+
+def compile_bench(workdir: pathlib.Path) -> str:
+    source = workdir / "bench_rescale.c"
+    binary = workdir / "bench_rescale"
+    source.write_text(BENCH_SOURCE)
+    cc = shlex.split(os.environ.get("CC") or sysconfig.get_config_var("CC") or "cc")
+    subprocess.run(
+        cc + ["-O2", "-I", str(ROOT / "src" / "lib" / "ppmd"), "-o", str(binary), str(source)],
+        check=True,
+    )
+    return str(binary)
+
+
+def main():
+    parser = argparse.ArgumentParser(prog="bench_rescale")
+    parser.add_argument("--reps", type=int, default=2000, help="passes over the contexts per timing round")
+    parser.add_argument("--markdown", action="store_true", help="print markdown table")
+    args = parser.parse_args()
+    table = []
+    with tempfile.TemporaryDirectory() as tmp:
+        binary = compile_bench(pathlib.Path(tmp))
+        for num in SIZES:
+            for name, passes in DISTRIBUTIONS:
+                out = subprocess.run(
+                    [binary, str(num), str(passes), str(args.reps)], check=True, capture_output=True, text=True
+                ).stdout.split()
+                insertion, counting = float(out[0]), float(out[1])
+                table.append([num, name, round(insertion, 1), round(counting, 1), round(insertion / counting, 2)])
+    print(
+        tabulate(
+            table,
+            headers=["states", "order", "insertion(ns)", "counting(ns)", "speedup"],
+            tablefmt="github" if args.markdown else "simple",
+        )
+    )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -55,6 +55,10 @@ def generate_comment(results_file, type):
     comment_body += generate_table(benchmarks, "compress", type=type)
     comment_body += "\n\n### Decompression benchmarks\n\n"
     comment_body += generate_table(benchmarks, "decompress", type=type)
+    comment_body += "\n\n### Batch decompression benchmarks\n\n"
+    comment_body += generate_table(benchmarks, "decompress_many", type=type)
+    comment_body += "\n\n### Range coder benchmarks\n\n"
+    comment_body += generate_table(benchmarks, "rangecoder", type=type)
     comment_body += "\n\n"
     return comment_body
 
@@ -0,0 +1,83 @@
+import argparse
+import os
+import pathlib
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from bench_common import MAX_ORDER, ROOT, build
+from tabulate import tabulate  # type: ignore
+
+ENCODE_SCRIPT = """
+import sys
+import pyppmd
+
+var, max_order, mem_size = (int(a) for a in sys.argv[1:4])
+with open(sys.argv[4], "rb") as f:
+    data = f.read()
+encoder = (pyppmd.Ppmd7Encoder if var == 7 else pyppmd.Ppmd8Encoder)(max_order=max_order, mem_size=mem_size)
+with open(sys.argv[5], "wb") as f:
+    for i in range(0, len(data), 16384):
+        f.write(encoder.encode(data[i : i + 16384]))
+    f.write(encoder.flush())
+"""
+
+DECODE_SCRIPT = """
+import sys
+import pyppmd
+
+var, max_order, mem_size, size = (int(a) for a in sys.argv[1:5])
+with open(sys.argv[5], "rb") as f:
+    compressed = f.read()
+decoder = (pyppmd.Ppmd7Decoder if var == 7 else pyppmd.Ppmd8Decoder)(max_order=max_order, mem_size=mem_size)
+assert len(decoder.decode(compressed, size)) == size
+"""
+
+VARIANTS = [("no prefetch", []), ("prefetch", ["--prefetch"])]
+EVENTS = ["task-clock", "cycles", "instructions", "cache-misses", "L1-dcache-load-misses"]
+
+
+def perf_stat(libdir: str, args, repeat: int) -> dict:
+    env = dict(os.environ, PYTHONPATH=libdir)
+    cmd = ["perf", "stat", "-x", ",", "-r", str(repeat), "-e", ",".join(EVENTS), sys.executable, "-c", DECODE_SCRIPT]
+    result = subprocess.run(cmd + [str(a) for a in args], env=env, check=True, capture_output=True, text=True)
+    counters = {}
+    for line in result.stderr.splitlines():
+        fields = line.split(",")
+        if len(fields) > 2 and fields[2] in EVENTS:
+            counters[fields[2]] = fields[0]
+    return counters
+
+
+def main():
+    parser = argparse.ArgumentParser(prog="perf_stat_prefetch")
+    parser.add_argument("--data", type=pathlib.Path, default=ROOT / "tests" / "data" / "10000SalesRecords.csv")
+    parser.add_argument("--repeat", type=int, default=5, help="runs averaged by perf stat")
+    parser.add_argument("--markdown", action="store_true", help="print markdown table")
+    args = parser.parse_args()
+    if shutil.which("perf") is None:
+        print("perf is not available", file=sys.stderr)
+        return 1
+    size = args.data.stat().st_size
+    # deep, large models so that the contexts are spread over the whole arena
+    targets = [("PPMd H", 7, MAX_ORDER[7], 256 << 20), ("PPMd I", 8, MAX_ORDER[8], 256 << 20)]
+    table = []
+    with tempfile.TemporaryDirectory() as tmp:
+        libs = [(name, build(pathlib.Path(tmp) / str(i), options)) for i, (name, options) in enumerate(VARIANTS)]
+        for target, var, max_order, mem_size in targets:
+            compressed = os.path.join(tmp, "{}.ppmd".format(var))
+            subprocess.run(
+                [sys.executable, "-c", ENCODE_SCRIPT, str(var), str(max_order), str(mem_size), str(args.data), compressed],
+                env=dict(os.environ, PYTHONPATH=libs[0][1]),
+                check=True,
+            )
+            for variant, libdir in libs:
+                counters = perf_stat(libdir, [var, max_order, mem_size, size, compressed], args.repeat)
+                table.append([target, variant] + [counters.get(e, "n/a") for e in EVENTS])
+    print(tabulate(table, headers=["target", "build"] + EVENTS, tablefmt="github" if args.markdown else "simple"))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
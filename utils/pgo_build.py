@@ -0,0 +1,107 @@
+import argparse
+import glob
+import os
+import pathlib
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from bench_common import ROOT, build, measure
+from tabulate import tabulate  # type: ignore
+
+# Runs against the instrumented extension; covers both variants, small and deep
+# models, text and binary data.
+TRAINING_SCRIPT = """
+import hashlib, pathlib, sys
+import pyppmd
+
+root = pathlib.Path(sys.argv[1])
+corpora = [
+    (root / "tests" / "data" / "10000SalesRecords.csv").read_bytes(),
+    b"".join(p.read_bytes() for p in sorted((root / "src").glob("**/*.[ch]"))),
+    b"".join(hashlib.sha256(i.to_bytes(4, "little")).digest() for i in range(1 << 14)),
+    (root / "tests" / "data" / "testdata2.ppmd").read_bytes(),
+]
+for data in corpora:
+    for max_order, mem_size in ((2, 1 << 20), (6, 16 << 20), (16, 64 << 20)):
+        for Encoder, Decoder, extra in (
+            (pyppmd.Ppmd7Encoder, pyppmd.Ppmd7Decoder, ()),
+            (pyppmd.Ppmd8Encoder, pyppmd.Ppmd8Decoder, (0,)),
+            (pyppmd.Ppmd8Encoder, pyppmd.Ppmd8Decoder, (1,)),
+        ):
+            encoder = Encoder(max_order, mem_size, *extra)
+            compressed = b"".join(encoder.encode(data[i : i + 16384]) for i in range(0, len(data), 16384))
+            compressed += encoder.flush()
+            decoder = Decoder(max_order, mem_size, *extra)
+            assert decoder.decode(compressed, len(data)) == data
+"""
+
+TARGETS = [("PPMd H", 7, 6, 16 << 20), ("PPMd I", 8, 8, 8 << 20)]
+
+
+def setup_py(options, env):
+    subprocess.run(
+        [sys.executable, "setup.py", "-q", "build_ext", "--inplace", "--force"] + options,
+        cwd=ROOT,
+        env=env,
+        check=True,
+        stdout=subprocess.DEVNULL,
+    )
+
+
+def merge_clang_profiles(profile_dir: pathlib.Path):
+    raw = glob.glob(str(profile_dir / "*.profraw"))
+    if not raw:
+        # GCC writes .gcda files that -fprofile-use reads directly
+        return
+    profdata = shutil.which("llvm-profdata")
+    if profdata is None:
+        raise RuntimeError("llvm-profdata is needed to merge Clang profiles")
+    subprocess.run([profdata, "merge", "-output=" + str(profile_dir / "default.profdata")] + raw, check=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(prog="pgo_build", description="profile guided, link time optimized build")
+    parser.add_argument("--cffi", action="store_true", help="build the CFFI extension instead of the C one")
+    parser.add_argument("--no-lto", action="store_true", help="skip link time optimization")
+    parser.add_argument("--profile-dir", type=pathlib.Path, default=ROOT / "build" / "pgo")
+    parser.add_argument("--compare", action="store_true", help="time the result against a plain build")
+    parser.add_argument("--data", default="-", help="input file for --compare; pseudo-random bytes when omitted")
+    parser.add_argument("--markdown", action="store_true", help="print markdown table")
+    args, options = parser.parse_known_args()
+    if args.cffi:
+        options.append("--cffi")
+    profile_dir = args.profile_dir.resolve()
+    shutil.rmtree(profile_dir, ignore_errors=True)
+    env = dict(os.environ, PPMD_PGO_DIR=str(profile_dir))
+
+    setup_py(options + ["--pgo-generate"], env)
+    subprocess.run(
+        [sys.executable, "-c", TRAINING_SCRIPT, str(ROOT)],
+        env=dict(env, PYTHONPATH=str(ROOT / "src")),
+        check=True,
+    )
+    merge_clang_profiles(profile_dir)
+    setup_py(options + ["--pgo-use"] + ([] if args.no_lto else ["--lto"]), env)
+
+    if args.compare:
+        table = []
+        with tempfile.TemporaryDirectory() as tmp:
+            libs = [("plain", build(pathlib.Path(tmp), options)), ("pgo", str(ROOT / "src"))]
+            for target, var, max_order, mem_size in TARGETS:
+                for name, libdir in libs:
+                    size, _, enc, dec = measure(libdir, var, max_order, mem_size, 5, args.data)
+                    table.append([target, name, round(size / enc / 1000000, 2), round(size / dec / 1000000, 2)])
+        print(
+            tabulate(
+                table,
+                headers=["target", "build", "compress(MB/sec)", "decompress(MB/sec)"],
+                tablefmt="github" if args.markdown else "simple",
+            )
+        )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())